@@ -37,9 +37,13 @@ public class ExtraBlueprintSwitchStatements : ModuleRules
 			{
                 "CoreUObject",
 				"Engine",
+				"GameplayTags",
                 "BlueprintGraph",
 				"UnrealEd",
                 "KismetCompiler",
+				"ToolMenus",
+				"Slate",
+				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,18 +1,21 @@
 // Copyright Amir Ben-Kiki 2025
 
 #include "ExtraBlueprintSwitchStatements.h"
+#include "ExtraSwitchCaseImport.h"
 
 #define LOCTEXT_NAMESPACE "FExtraBlueprintSwitchStatementsModule"
 
 void FExtraBlueprintSwitchStatementsModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	ExtraSwitchCaseImport::StartWatching();
 }
 
 void FExtraBlueprintSwitchStatementsModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	ExtraSwitchCaseImport::StopWatching();
 }
 
 #undef LOCTEXT_NAMESPACE
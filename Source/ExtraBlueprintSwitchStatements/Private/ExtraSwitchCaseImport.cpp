@@ -0,0 +1,783 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchCaseImport.h"
+#include "K2Node_SwitchOnIntArray.h"
+#include "K2Node_SwitchOnIntRanges.h"
+#include "K2Node_SwitchOnFloatRanges.h"
+#include "K2Node_SwitchOnFloat.h"
+#include "K2Node_SwitchOnVector.h"
+#include "K2Node_SwitchOnColor.h"
+#include "ExtraSwitchCaseOrdering.h"
+#include "DataTableUtils.h"
+#include "ToolMenu.h"
+#include "ScopedTransaction.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/CoreDelegates.h"
+#include "Containers/Ticker.h"
+#include "UObject/UObjectIterator.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogExtraSwitchCaseImport, Log, All);
+
+FString FExtraSwitchCaseSource::GetSourcePath() const
+{
+    switch (Type)
+    {
+    case EExtraSwitchCaseSourceType::DataTable:
+        return DataTable.IsNull() ? FString() : DataTable.ToSoftObjectPath().ToString();
+    case EExtraSwitchCaseSourceType::CsvFile:
+        return CsvFile.FilePath.IsEmpty() ? FString() : FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CsvFile.FilePath);
+    case EExtraSwitchCaseSourceType::CurveKeys:
+        return Curve.IsNull() ? FString() : Curve.ToSoftObjectPath().ToString();
+    default:
+        return FString();
+    }
+}
+
+namespace ExtraSwitchCaseImport
+{
+    // Exact enough that an export followed by an import gives back the same cases
+    static FString FormatNumber(float Value) { return FString::Printf(TEXT("%.9g"), Value); }
+    static FString FormatNumber(double Value) { return FString::Printf(TEXT("%.17g"), Value); }
+
+    static bool ParseCell(const FString& Cell, int32& OutValue) { return LexTryParseString(OutValue, *Cell); }
+    static bool ParseCell(const FString& Cell, float& OutValue) { return LexTryParseString(OutValue, *Cell); }
+    static bool ParseCell(const FString& Cell, double& OutValue) { return LexTryParseString(OutValue, *Cell); }
+
+    static bool ParseCell(const FString& Cell, bool& OutValue)
+    {
+        if (Cell.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Cell == TEXT("1"))
+        {
+            OutValue = true;
+            return true;
+        }
+        if (Cell.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Cell == TEXT("0"))
+        {
+            OutValue = false;
+            return true;
+        }
+        return false;
+    }
+
+    // An optional cell the row leaves out or blank keeps the default
+    template<typename ValueType>
+    static bool ParseOptionalCell(TConstArrayView<FString> Cells, int32 Index, ValueType& InOutValue)
+    {
+        return !Cells.IsValidIndex(Index) || Cells[Index].IsEmpty() || ParseCell(Cells[Index], InOutValue);
+    }
+
+    /**
+     * The column layout of a case type, the first NumRequired fields must be in every row and the rest may be left out.
+     * The names are the defaults an export writes, an import can read any columns named in FExtraSwitchCaseSource::Columns.
+     */
+    template<typename ValueType>
+    struct TCaseFields;
+
+    template<>
+    struct TCaseFields<int32>
+    {
+        static constexpr int32 NumRequired = 1;
+        static TArray<FString> GetNames() { return { TEXT("Value") }; }
+
+        static bool Parse(TConstArrayView<FString> Cells, int32& OutValue)
+        {
+            return ParseCell(Cells[0], OutValue);
+        }
+
+        static void Format(const int32 Value, TArray<FString>& OutCells)
+        {
+            OutCells.Add(LexToString(Value));
+        }
+    };
+
+    template<>
+    struct TCaseFields<float>
+    {
+        static constexpr int32 NumRequired = 1;
+        static TArray<FString> GetNames() { return { TEXT("Value") }; }
+
+        static bool Parse(TConstArrayView<FString> Cells, float& OutValue)
+        {
+            return ParseCell(Cells[0], OutValue);
+        }
+
+        static void Format(const float Value, TArray<FString>& OutCells)
+        {
+            OutCells.Add(FormatNumber(Value));
+        }
+    };
+
+    // FSwitchIntRange and FExtraSwitchFloatRange, Inclusive defaults to true like it does on the node
+    template<typename RangeType>
+    struct TRangeCaseFields
+    {
+        static constexpr int32 NumRequired = 2;
+        static TArray<FString> GetNames() { return { TEXT("RangeMin"), TEXT("RangeMax"), TEXT("Inclusive") }; }
+
+        static bool Parse(TConstArrayView<FString> Cells, RangeType& OutRange)
+        {
+            OutRange.Inclusive = true;
+            return ParseCell(Cells[0], OutRange.RangeMin) && ParseCell(Cells[1], OutRange.RangeMax) && ParseOptionalCell(Cells, 2, OutRange.Inclusive);
+        }
+
+        static void Format(const RangeType& Range, TArray<FString>& OutCells)
+        {
+            if constexpr (std::is_integral_v<decltype(Range.RangeMin)>)
+            {
+                OutCells.Add(LexToString(Range.RangeMin));
+                OutCells.Add(LexToString(Range.RangeMax));
+            }
+            else
+            {
+                OutCells.Add(FormatNumber(Range.RangeMin));
+                OutCells.Add(FormatNumber(Range.RangeMax));
+            }
+            OutCells.Add(Range.Inclusive ? TEXT("true") : TEXT("false"));
+        }
+    };
+
+    template<> struct TCaseFields<FSwitchIntRange> : TRangeCaseFields<FSwitchIntRange> {};
+    template<> struct TCaseFields<FExtraSwitchFloatRange> : TRangeCaseFields<FExtraSwitchFloatRange> {};
+
+    template<>
+    struct TCaseFields<FVector>
+    {
+        static constexpr int32 NumRequired = 3;
+        static TArray<FString> GetNames() { return { TEXT("X"), TEXT("Y"), TEXT("Z") }; }
+
+        static bool Parse(TConstArrayView<FString> Cells, FVector& OutValue)
+        {
+            return ParseCell(Cells[0], OutValue.X) && ParseCell(Cells[1], OutValue.Y) && ParseCell(Cells[2], OutValue.Z);
+        }
+
+        static void Format(const FVector& Value, TArray<FString>& OutCells)
+        {
+            OutCells.Add(FormatNumber(Value.X));
+            OutCells.Add(FormatNumber(Value.Y));
+            OutCells.Add(FormatNumber(Value.Z));
+        }
+    };
+
+    template<>
+    struct TCaseFields<FLinearColor>
+    {
+        static constexpr int32 NumRequired = 3;
+        static TArray<FString> GetNames() { return { TEXT("R"), TEXT("G"), TEXT("B"), TEXT("A") }; }
+
+        static bool Parse(TConstArrayView<FString> Cells, FLinearColor& OutValue)
+        {
+            OutValue.A = 1.0f;
+            return ParseCell(Cells[0], OutValue.R) && ParseCell(Cells[1], OutValue.G) && ParseCell(Cells[2], OutValue.B) && ParseOptionalCell(Cells, 3, OutValue.A);
+        }
+
+        static void Format(const FLinearColor& Value, TArray<FString>& OutCells)
+        {
+            OutCells.Add(FormatNumber(Value.R));
+            OutCells.Add(FormatNumber(Value.G));
+            OutCells.Add(FormatNumber(Value.B));
+            OutCells.Add(FormatNumber(Value.A));
+        }
+    };
+
+    /**
+     * Picks the source columns the fields are read from
+     * @param Header The column names of the source
+     * @param OutColumns The source column of each field that is read, the required fields first
+     */
+    static bool SelectColumns(const FExtraSwitchCaseSource& Source, TConstArrayView<FString> Header, int32 NumRequired, int32 NumFields, TArray<int32>& OutColumns, FText& OutError)
+    {
+        OutColumns.Reset();
+        if (Source.Columns.Num() == 0)
+        {
+            if (Header.Num() < NumRequired)
+            {
+                OutError = FText::Format(INVTEXT("{0} has {1} columns, each case needs {2}"), FText::FromString(Source.GetSourcePath()), Header.Num(), NumRequired);
+                return false;
+            }
+            for (int32 Column = 0; Column < NumRequired; ++Column)
+            {
+                OutColumns.Add(Column);
+            }
+            return true;
+        }
+
+        if (Source.Columns.Num() < NumRequired || Source.Columns.Num() > NumFields)
+        {
+            OutError = FText::Format(INVTEXT("Case Source names {0} columns, each case reads {1} to {2}"), Source.Columns.Num(), NumRequired, NumFields);
+            return false;
+        }
+
+        for (const FName ColumnName : Source.Columns)
+        {
+            const int32 Column = Header.IndexOfByPredicate([ColumnName](const FString& Name) { return FName(*Name) == ColumnName; });
+            if (Column == INDEX_NONE)
+            {
+                OutError = FText::Format(INVTEXT("{0} has no column {1}"), FText::FromString(Source.GetSourcePath()), FText::FromName(ColumnName));
+                return false;
+            }
+            OutColumns.Add(Column);
+        }
+        return true;
+    }
+
+    // Splits one CSV line, a field may be quoted and "" stands for a quote inside one. A quoted field can't span lines
+    static void SplitCsvLine(FStringView Line, TArray<FString>& OutCells)
+    {
+        OutCells.Reset();
+        FString Cell;
+        bool bQuoted = false;
+        for (int32 Index = 0; Index < Line.Len(); ++Index)
+        {
+            const TCHAR Char = Line[Index];
+            if (bQuoted)
+            {
+                if (Char != TEXT('"'))
+                {
+                    Cell.AppendChar(Char);
+                }
+                else if (Index + 1 < Line.Len() && Line[Index + 1] == TEXT('"'))
+                {
+                    Cell.AppendChar(Char);
+                    ++Index;
+                }
+                else
+                {
+                    bQuoted = false;
+                }
+            }
+            else if (Char == TEXT('"'))
+            {
+                bQuoted = true;
+            }
+            else if (Char == TEXT(','))
+            {
+                OutCells.Add(Cell.TrimStartAndEnd());
+                Cell.Reset();
+            }
+            else
+            {
+                Cell.AppendChar(Char);
+            }
+        }
+        OutCells.Add(Cell.TrimStartAndEnd());
+    }
+
+    // Called with the 1 based row number and the cells of the selected columns, blank for a column the row doesn't have
+    using FRowVisitor = TFunctionRef<void(int32 RowNumber, TConstArrayView<FString> Cells)>;
+
+    /**
+     * Streams the rows of the source to Visitor without keeping them, only the selected cells of the current row are held
+     * @return False if the source can't be read or doesn't have the columns
+     */
+    static bool ReadRows(const FExtraSwitchCaseSource& Source, int32 NumRequired, int32 NumFields, FRowVisitor Visitor, FText& OutError)
+    {
+        TArray<int32> Columns;
+        TArray<FString> Cells;
+        const FString SourcePath = Source.GetSourcePath();
+
+        switch (Source.Type)
+        {
+        case EExtraSwitchCaseSourceType::DataTable:
+        {
+            const UDataTable* Table = Source.DataTable.LoadSynchronous();
+            if (Table == nullptr || Table->GetRowStruct() == nullptr)
+            {
+                OutError = FText::Format(INVTEXT("The data table {0} can't be loaded"), FText::FromString(SourcePath));
+                return false;
+            }
+
+            TArray<const FProperty*> Properties;
+            TArray<FString> Header;
+            for (TFieldIterator<FProperty> It(Table->GetRowStruct()); It; ++It)
+            {
+                Properties.Add(*It);
+                Header.Add(It->GetAuthoredName());
+            }
+            if (!SelectColumns(Source, Header, NumRequired, NumFields, Columns, OutError))
+            {
+                return false;
+            }
+
+            int32 RowNumber = 0;
+            for (const TPair<FName, uint8*>& Row : Table->GetRowMap())
+            {
+                Cells.Reset();
+                for (const int32 Column : Columns)
+                {
+                    Cells.Add(DataTableUtils::GetPropertyValueAsString(Properties[Column], Row.Value, EDataTableExportFlags::None).TrimStartAndEnd());
+                }
+                Visitor(++RowNumber, Cells);
+            }
+            return true;
+        }
+
+        case EExtraSwitchCaseSourceType::CsvFile:
+        {
+            bool bHaveHeader = false;
+            bool bColumnsValid = true;
+            int32 LineNumber = 0;
+            TArray<FString> Line;
+            const bool bRead = FFileHelper::LoadFileToStringWithLineVisitor(*SourcePath, [&](FStringView LineText)
+            {
+                ++LineNumber;
+                if (!bColumnsValid || LineText.TrimStartAndEnd().IsEmpty())
+                {
+                    return;
+                }
+
+                SplitCsvLine(LineText, Line);
+                if (!bHaveHeader)
+                {
+                    bHaveHeader = true;
+                    bColumnsValid = SelectColumns(Source, Line, NumRequired, NumFields, Columns, OutError);
+                    return;
+                }
+
+                Cells.Reset();
+                for (const int32 Column : Columns)
+                {
+                    Cells.Add(Line.IsValidIndex(Column) ? Line[Column] : FString());
+                }
+                Visitor(LineNumber, Cells);
+            });
+
+            if (!bRead)
+            {
+                OutError = FText::Format(INVTEXT("The CSV file {0} can't be read"), FText::FromString(SourcePath));
+                return false;
+            }
+            if (!bHaveHeader)
+            {
+                OutError = FText::Format(INVTEXT("The CSV file {0} is empty, its first line should name the columns"), FText::FromString(SourcePath));
+                return false;
+            }
+            return bColumnsValid;
+        }
+
+        case EExtraSwitchCaseSourceType::CurveKeys:
+        {
+            const UCurveFloat* Curve = Source.Curve.LoadSynchronous();
+            if (Curve == nullptr)
+            {
+                OutError = FText::Format(INVTEXT("The curve {0} can't be loaded"), FText::FromString(SourcePath));
+                return false;
+            }
+
+            const TArray<FString> Header = { TEXT("Time"), TEXT("NextTime"), TEXT("Value") };
+            if (!SelectColumns(Source, Header, NumRequired, NumFields, Columns, OutError))
+            {
+                return false;
+            }
+
+            // The last key has no NextTime, so read as ranges the keys give one range less than they are
+            const TArray<FRichCurveKey>& Keys = Curve->FloatCurve.GetConstRefOfKeys();
+            TArray<FString> Row;
+            for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); ++KeyIndex)
+            {
+                Row = { FormatNumber(Keys[KeyIndex].Time), Keys.IsValidIndex(KeyIndex + 1) ? FormatNumber(Keys[KeyIndex + 1].Time) : FString(), FormatNumber(Keys[KeyIndex].Value) };
+                Cells.Reset();
+                for (const int32 Column : Columns)
+                {
+                    Cells.Add(Row[Column]);
+                }
+                Visitor(KeyIndex + 1, Cells);
+            }
+            return true;
+        }
+
+        default:
+            return false;
+        }
+    }
+
+    template<typename NodeType>
+    static bool ImportNodeCases(NodeType* Node, bool bTransact, FText& OutError)
+    {
+        using ValueType = typename decltype(NodeType::PinValues)::ElementType;
+        using FFields = TCaseFields<ValueType>;
+
+        TArray<ValueType> Cases;
+        int32 NumInvalid = 0;
+        int32 FirstInvalidRow = 0;
+        const bool bRead = ReadRows(Node->CaseSource, FFields::NumRequired, FFields::GetNames().Num(), [&](int32 RowNumber, TConstArrayView<FString> Cells)
+        {
+            // A row that leaves a needed cell blank is a gap, not a broken case
+            for (int32 Index = 0; Index < FFields::NumRequired; ++Index)
+            {
+                if (Cells[Index].IsEmpty())
+                {
+                    return;
+                }
+            }
+
+            ValueType Value{};
+            if (FFields::Parse(Cells, Value))
+            {
+                Cases.Add(Value);
+            }
+            else if (NumInvalid++ == 0)
+            {
+                FirstInvalidRow = RowNumber;
+            }
+        }, OutError);
+
+        if (!bRead)
+        {
+            return false;
+        }
+
+        if (NumInvalid > 0)
+        {
+            UE_LOG(LogExtraSwitchCaseImport, Warning, TEXT("%s skipped %d rows of %s that don't hold a case, the first is row %d"),
+                *Node->GetPathName(), NumInvalid, *Node->CaseSource.GetSourcePath(), FirstInvalidRow);
+        }
+
+        FArrayProperty* ValuesProperty = FindFProperty<FArrayProperty>(NodeType::StaticClass(), GET_MEMBER_NAME_CHECKED(NodeType, PinValues));
+        if (ValuesProperty->Identical(&Node->PinValues, &Cases))
+        {
+            return false;
+        }
+
+        TOptional<FScopedTransaction> Transaction;
+        if (bTransact)
+        {
+            Transaction.Emplace(INVTEXT("Import Switch Cases"));
+        }
+
+        Node->Modify();
+        Node->PinValues = MoveTemp(Cases);
+
+        // The node updates its pins in place, the same as for an edit of PinValues in the details panel
+        FPropertyChangedEvent ChangedEvent(ValuesProperty, EPropertyChangeType::ValueSet);
+        Node->PostEditChangeProperty(ChangedEvent);
+
+        if (bTransact)
+        {
+            FBlueprintEditorUtils::MarkBlueprintAsModified(FBlueprintEditorUtils::FindBlueprintForNodeChecked(Node));
+        }
+        return true;
+    }
+
+    template<typename NodeType>
+    static bool ExportNodeCases(const NodeType* Node, const FString& Filename, FText& OutError)
+    {
+        using ValueType = typename decltype(NodeType::PinValues)::ElementType;
+        using FFields = TCaseFields<ValueType>;
+
+        FString Text = FString::Join(FFields::GetNames(), TEXT(",")) + TEXT("\n");
+        TArray<FString> Cells;
+        for (const ValueType& Value : Node->PinValues)
+        {
+            Cells.Reset();
+            FFields::Format(Value, Cells);
+            Text += FString::Join(Cells, TEXT(","));
+            Text += TEXT("\n");
+        }
+
+        if (!FFileHelper::SaveStringToFile(Text, *Filename))
+        {
+            OutError = FText::Format(INVTEXT("{0} can't be written"), FText::FromString(Filename));
+            return false;
+        }
+        return true;
+    }
+
+    // Calls Visitor with the node cast to its class if it is one of the nodes that support a case source
+    template<typename VisitorType>
+    static bool VisitTypedNode(UK2Node_Switch* Node, VisitorType&& Visitor)
+    {
+        if (UK2Node_SwitchOnIntArray* IntArrayNode = Cast<UK2Node_SwitchOnIntArray>(Node))
+        {
+            Visitor(IntArrayNode);
+        }
+        else if (UK2Node_SwitchOnIntRanges* IntRangesNode = Cast<UK2Node_SwitchOnIntRanges>(Node))
+        {
+            Visitor(IntRangesNode);
+        }
+        else if (UK2Node_SwitchOnFloatRanges* FloatRangesNode = Cast<UK2Node_SwitchOnFloatRanges>(Node))
+        {
+            Visitor(FloatRangesNode);
+        }
+        else if (UK2Node_SwitchOnFloat* FloatNode = Cast<UK2Node_SwitchOnFloat>(Node))
+        {
+            Visitor(FloatNode);
+        }
+        else if (UK2Node_SwitchOnVector* VectorNode = Cast<UK2Node_SwitchOnVector>(Node))
+        {
+            Visitor(VectorNode);
+        }
+        else if (UK2Node_SwitchOnColor* ColorNode = Cast<UK2Node_SwitchOnColor>(Node))
+        {
+            Visitor(ColorNode);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+}
+
+const FExtraSwitchCaseSource* ExtraSwitchCaseImport::GetCaseSource(const UK2Node_Switch* Node)
+{
+    const FExtraSwitchCaseSource* Source = nullptr;
+    VisitTypedNode(const_cast<UK2Node_Switch*>(Node), [&Source](auto* TypedNode) { Source = &TypedNode->CaseSource; });
+    return Source;
+}
+
+bool ExtraSwitchCaseImport::ImportCases(UK2Node_Switch* Node, bool bTransact, FText& OutError)
+{
+    // Nothing to read yet while the source is being picked
+    const FExtraSwitchCaseSource* Source = GetCaseSource(Node);
+    if (Source == nullptr || Source->GetSourcePath().IsEmpty())
+    {
+        return false;
+    }
+
+    bool bChanged = false;
+    VisitTypedNode(Node, [&](auto* TypedNode) { bChanged = ImportNodeCases(TypedNode, bTransact, OutError); });
+    return bChanged;
+}
+
+bool ExtraSwitchCaseImport::ExportCases(const UK2Node_Switch* Node, const FString& Filename, FText& OutError)
+{
+    bool bWritten = false;
+    VisitTypedNode(const_cast<UK2Node_Switch*>(Node), [&](auto* TypedNode) { bWritten = ExportNodeCases(TypedNode, Filename, OutError); });
+    return bWritten;
+}
+
+void ExtraSwitchCaseImport::ImportBlueprintCases(UBlueprint* Blueprint)
+{
+    TArray<UK2Node_Switch*> SwitchNodes;
+    FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, SwitchNodes);
+    for (UK2Node_Switch* SwitchNode : SwitchNodes)
+    {
+        FText Error;
+        ImportCases(SwitchNode, false, Error);
+        if (!Error.IsEmpty())
+        {
+            UE_LOG(LogExtraSwitchCaseImport, Warning, TEXT("%s keeps its previous cases, %s"), *SwitchNode->GetPathName(), *Error.ToString());
+        }
+    }
+}
+
+void ExtraSwitchCaseImport::AddContextMenuEntries(UToolMenu* Menu, const UK2Node_Switch* Node)
+{
+    TWeakObjectPtr<UK2Node_Switch> WeakNode = const_cast<UK2Node_Switch*>(Node);
+    FToolMenuSection& Section = Menu->AddSection("ExtraSwitchCaseSource", INVTEXT("Case Source"));
+
+    Section.AddMenuEntry(
+        "ImportCasesFromSource",
+        INVTEXT("Import Cases from Source"),
+        INVTEXT("Reads the cases from the data table, CSV file or curve set in Case Source.\nThey are also read before every compile and whenever the source changes."),
+        FSlateIcon(),
+        FUIAction(
+            FExecuteAction::CreateLambda([WeakNode]()
+            {
+                if (UK2Node_Switch* SwitchNode = WeakNode.Get())
+                {
+                    FText Error;
+                    if (ImportCases(SwitchNode, true, Error))
+                    {
+                        ExtraSwitchCaseOrdering::Notify(INVTEXT("Cases imported from the source"), true);
+                    }
+                    else
+                    {
+                        ExtraSwitchCaseOrdering::Notify(Error.IsEmpty() ? INVTEXT("The cases already match the source") : Error, Error.IsEmpty());
+                    }
+                }
+            }),
+            FCanExecuteAction::CreateLambda([WeakNode]()
+            {
+                const UK2Node_Switch* SwitchNode = WeakNode.Get();
+                const FExtraSwitchCaseSource* Source = SwitchNode ? GetCaseSource(SwitchNode) : nullptr;
+                return Source && !Source->GetSourcePath().IsEmpty();
+            })));
+
+    Section.AddMenuEntry(
+        "ExportCasesToCsv",
+        INVTEXT("Export Cases to CSV"),
+        INVTEXT("Writes the cases to Saved/ExtraSwitch as a CSV file that Case Source can read back, a starting point for moving them into a spreadsheet"),
+        FSlateIcon(),
+        FUIAction(
+            FExecuteAction::CreateLambda([WeakNode]()
+            {
+                const UK2Node_Switch* SwitchNode = WeakNode.Get();
+                const UBlueprint* Blueprint = SwitchNode ? FBlueprintEditorUtils::FindBlueprintForNode(SwitchNode) : nullptr;
+                if (Blueprint == nullptr)
+                {
+                    return;
+                }
+
+                const FString Filename = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("ExtraSwitch") / FString::Printf(TEXT("%s_%s.csv"), *Blueprint->GetName(), *SwitchNode->GetName()));
+                FText Error;
+                if (ExportCases(SwitchNode, Filename, Error))
+                {
+                    ExtraSwitchCaseOrdering::Notify(FText::Format(INVTEXT("Cases exported to {0}"), FText::FromString(Filename)), true);
+                }
+                else
+                {
+                    ExtraSwitchCaseOrdering::Notify(Error, false);
+                }
+            })));
+}
+
+namespace ExtraSwitchCaseImport
+{
+    // Sources changed since the last import, asset paths and absolute CSV paths as GetSourcePath returns them
+    static TSet<FString> PendingSources;
+    static TMap<FString, FDateTime> CsvTimestamps;
+
+    static FTSTicker::FDelegateHandle ImportTickerHandle;
+    static FTSTicker::FDelegateHandle CsvPollTickerHandle;
+    static FDelegateHandle ObjectModifiedHandle;
+    static FDelegateHandle ObjectPropertyChangedHandle;
+    static FDelegateHandle PostEngineInitHandle;
+    static FDelegateHandle BlueprintPreCompileHandle;
+
+    // CSV files live outside the asset system, so they are checked for a new timestamp every few seconds
+    static constexpr float CsvPollSeconds = 2.0f;
+
+    static void ForEachSourcedNode(TFunctionRef<void(UK2Node_Switch* Node, const FExtraSwitchCaseSource& Source)> Visitor)
+    {
+        for (TObjectIterator<UK2Node_Switch> It; It; ++It)
+        {
+            UK2Node_Switch* Node = *It;
+
+            // Skips the copies the compiler makes of the graphs
+            if (!IsValid(Node) || Node->GetOutermost() == GetTransientPackage())
+            {
+                continue;
+            }
+
+            const FExtraSwitchCaseSource* Source = GetCaseSource(Node);
+            if (Source && Source->IsSet())
+            {
+                Visitor(Node, *Source);
+            }
+        }
+    }
+
+    static bool ImportPendingSources(float DeltaTime)
+    {
+        ImportTickerHandle.Reset();
+        const TSet<FString> Sources = MoveTemp(PendingSources);
+        PendingSources.Reset();
+
+        TSet<UBlueprint*> ChangedBlueprints;
+        ForEachSourcedNode([&Sources, &ChangedBlueprints](UK2Node_Switch* Node, const FExtraSwitchCaseSource& Source)
+        {
+            UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+            if (Blueprint == nullptr || !Sources.Contains(Source.GetSourcePath()))
+            {
+                return;
+            }
+
+            FText Error;
+            if (ImportCases(Node, false, Error))
+            {
+                ChangedBlueprints.Add(Blueprint);
+            }
+            else if (!Error.IsEmpty())
+            {
+                UE_LOG(LogExtraSwitchCaseImport, Warning, TEXT("%s keeps its previous cases, %s"), *Node->GetPathName(), *Error.ToString());
+            }
+        });
+
+        for (UBlueprint* Blueprint : ChangedBlueprints)
+        {
+            UE_LOG(LogExtraSwitchCaseImport, Log, TEXT("Recompiling %s, a switch case source changed"), *Blueprint->GetPathName());
+            FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        }
+        return false;
+    }
+
+    // Changes often come as several Modify calls in one frame, they are imported together on the next tick
+    static void QueueImport(const FString& SourcePath)
+    {
+        PendingSources.Add(SourcePath);
+        if (!ImportTickerHandle.IsValid())
+        {
+            ImportTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&ImportPendingSources));
+        }
+    }
+
+    static void OnObjectChanged(UObject* Object)
+    {
+        if (Object && (Object->IsA<UDataTable>() || Object->IsA<UCurveFloat>()))
+        {
+            QueueImport(FSoftObjectPath(Object).ToString());
+        }
+    }
+
+    static bool PollCsvFiles(float DeltaTime)
+    {
+        ForEachSourcedNode([](UK2Node_Switch* Node, const FExtraSwitchCaseSource& Source)
+        {
+            if (Source.Type != EExtraSwitchCaseSourceType::CsvFile)
+            {
+                return;
+            }
+
+            // The first time a file is seen there is nothing to compare with, the import before the next compile picks up older edits
+            const FString SourcePath = Source.GetSourcePath();
+            const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*SourcePath);
+            FDateTime* KnownTimestamp = CsvTimestamps.Find(SourcePath);
+            if (KnownTimestamp == nullptr)
+            {
+                CsvTimestamps.Add(SourcePath, Timestamp);
+            }
+            else if (*KnownTimestamp != Timestamp)
+            {
+                *KnownTimestamp = Timestamp;
+                QueueImport(SourcePath);
+            }
+        });
+        return true;
+    }
+
+    static void RegisterPreCompile()
+    {
+        if (GEditor && !BlueprintPreCompileHandle.IsValid())
+        {
+            BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddStatic(&ImportBlueprintCases);
+        }
+    }
+}
+
+void ExtraSwitchCaseImport::StartWatching()
+{
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddStatic(&OnObjectChanged);
+    ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject* Object, FPropertyChangedEvent&) { OnObjectChanged(Object); });
+    CsvPollTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&PollCsvFiles), CsvPollSeconds);
+
+    // The module can load before the editor engine exists
+    if (GEditor)
+    {
+        RegisterPreCompile();
+    }
+    else
+    {
+        PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&RegisterPreCompile);
+    }
+}
+
+void ExtraSwitchCaseImport::StopWatching()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+    FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(CsvPollTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(ImportTickerHandle);
+    if (GEditor)
+    {
+        GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+    }
+
+    PendingSources.Reset();
+    CsvTimestamps.Reset();
+}
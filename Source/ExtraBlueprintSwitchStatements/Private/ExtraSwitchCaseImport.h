@@ -0,0 +1,44 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExtraSwitchCaseSource.h"
+
+class UK2Node_Switch;
+class UToolMenu;
+class UBlueprint;
+
+/**
+ * Keeps the cases of the switch nodes with a FExtraSwitchCaseSource in step with their data table, CSV file or curve.
+ * Rows are parsed straight into a new case array as they are read and the node takes it in one change, so importing thousands of rows
+ * touches the pins once through the node's in place pin update instead of once per row.
+ */
+namespace ExtraSwitchCaseImport
+{
+	// The source of a node that supports one (Int Array, Int Ranges, Float Ranges, Float, Vector and Color), nullptr for other nodes
+	const FExtraSwitchCaseSource* GetCaseSource(const UK2Node_Switch* Node);
+
+	/**
+	 * Reads the node's cases from its source and replaces PinValues if they differ
+	 * @param bTransact Records the change for undo, off for the automatic imports before a compile or after the source changed
+	 * @return True if the cases changed
+	 */
+	bool ImportCases(UK2Node_Switch* Node, bool bTransact, FText& OutError);
+
+	/**
+	 * Writes the node's cases as a CSV file with a header line, in the column layout an import reads back
+	 * @return True if the file was written
+	 */
+	bool ExportCases(const UK2Node_Switch* Node, const FString& Filename, FText& OutError);
+
+	// Imports every node of the blueprint that has a source, used before the blueprint compiles
+	void ImportBlueprintCases(UBlueprint* Blueprint);
+
+	// Adds the import and export actions to the context menu of a node that supports a source
+	void AddContextMenuEntries(UToolMenu* Menu, const UK2Node_Switch* Node);
+
+	// Starts watching the sources, changed sources are imported into the loaded nodes and their blueprints recompiled
+	void StartWatching();
+	void StopWatching();
+}
@@ -0,0 +1,70 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchCaseOrdering.h"
+#include "K2Node_Switch.h"
+#include "Engine/Blueprint.h"
+#include "Algo/StableSort.h"
+#include "ExtraSwitchProfiler.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+bool ExtraSwitchCaseOrdering::IsValidOrder(TConstArrayView<int32> Order, int32 NumCases)
+{
+    if (Order.Num() != NumCases)
+    {
+        return false;
+    }
+
+    TBitArray<> Seen(false, NumCases);
+    for (const int32 CaseIndex : Order)
+    {
+        if (CaseIndex < 0 || CaseIndex >= NumCases || Seen[CaseIndex])
+        {
+            return false;
+        }
+        Seen[CaseIndex] = true;
+    }
+    return true;
+}
+
+bool ExtraSwitchCaseOrdering::GetRecordedHitOrder(const UK2Node_Switch* SwitchNode, int32 NumCases, TArray<int32>& OutOrder)
+{
+#if EXTRASWITCH_PROFILING
+    const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(SwitchNode);
+    if (Blueprint == nullptr || Blueprint->GeneratedClass == nullptr)
+    {
+        return false;
+    }
+
+    // Matches the name FKCHandler_ExtraSwitchDispatch gives the node's table
+    const FString TablePath = FString::Printf(TEXT("%s:%s_CaseTable"), *Blueprint->GeneratedClass->GetPathName(), *SwitchNode->GetName());
+    TArray<uint64> CaseHits;
+    if (!FExtraSwitchProfiler::FindCaseHits(TablePath, CaseHits))
+    {
+        return false;
+    }
+
+    OutOrder.Reset(NumCases);
+    for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+    {
+        OutOrder.Add(CaseIndex);
+    }
+
+    // Stable so cases with the same count keep their pin order
+    auto GetHits = [&CaseHits](int32 CaseIndex) { return CaseHits.IsValidIndex(CaseIndex) ? CaseHits[CaseIndex] : 0; };
+    Algo::StableSort(OutOrder, [&GetHits](int32 A, int32 B) { return GetHits(A) > GetHits(B); });
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ExtraSwitchCaseOrdering::Notify(const FText& Message, bool bSuccess)
+{
+    FNotificationInfo Info(Message);
+    Info.ExpireDuration = 5.0f;
+    if (TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info))
+    {
+        Notification->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+    }
+}
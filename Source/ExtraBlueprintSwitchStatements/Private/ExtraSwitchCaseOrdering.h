@@ -0,0 +1,118 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ToolMenu.h"
+#include "ToolMenuSection.h"
+#include "ScopedTransaction.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+
+class UK2Node_Switch;
+
+/**
+ * Profile guided case ordering for the tolerance switch nodes (Switch on Float, Vector and Color).
+ * Their FirstMatch lookup tests the cases in order, so testing the hottest cases first makes the common lookups cheaper.
+ * The order only changes which case is tested first, never the pin layout, and it is only used while no value can match two cases.
+ */
+namespace ExtraSwitchCaseOrdering
+{
+	// True if Order holds every case index below NumCases exactly once
+	bool IsValidOrder(TConstArrayView<int32> Order, int32 NumCases);
+
+	/**
+	 * Builds a hottest first test order from the hits ExtraSwitch.Profiling recorded (or ExtraSwitch.ImportProfile loaded) for the node's case table
+	 * @return False if nothing was recorded for the node
+	 */
+	bool GetRecordedHitOrder(const UK2Node_Switch* SwitchNode, int32 NumCases, TArray<int32>& OutOrder);
+
+	// Shows the outcome of a menu action as an editor notification
+	void Notify(const FText& Message, bool bSuccess);
+
+	/**
+	 * Adds the order and reset actions to the context menu of a node with CaseTestOrder, PinValues, MatchMode and AreCasesDisjoint()
+	 */
+	template<typename NodeType>
+	void AddContextMenuEntries(UToolMenu* Menu, const NodeType* Node)
+	{
+		TWeakObjectPtr<NodeType> WeakNode = const_cast<NodeType*>(Node);
+		FToolMenuSection& Section = Menu->AddSection("ExtraSwitchCaseOrder", INVTEXT("Case Test Order"));
+
+		Section.AddMenuEntry(
+			"OrderCaseTestsByRecordedHits",
+			INVTEXT("Order Case Tests by Recorded Hits"),
+			INVTEXT("Tests the cases that executed most often first, using the hits recorded with ExtraSwitch.Profiling or loaded with ExtraSwitch.ImportProfile.\nOnly available in First Match mode while no value can match two cases, the pins don't move."),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateLambda([WeakNode]()
+				{
+					NodeType* SwitchNode = WeakNode.Get();
+					if (SwitchNode == nullptr)
+					{
+						return;
+					}
+
+					TArray<int32> Order;
+					if (!GetRecordedHitOrder(SwitchNode, SwitchNode->PinValues.Num(), Order))
+					{
+						Notify(INVTEXT("No hits were recorded for this switch, run it with ExtraSwitch.Profiling 1 or load a profile with ExtraSwitch.ImportProfile"), false);
+						return;
+					}
+
+					const FScopedTransaction Transaction(INVTEXT("Order Case Tests by Recorded Hits"));
+					SwitchNode->Modify();
+					SwitchNode->CaseTestOrder = MoveTemp(Order);
+					FBlueprintEditorUtils::MarkBlueprintAsModified(FBlueprintEditorUtils::FindBlueprintForNodeChecked(SwitchNode));
+					Notify(INVTEXT("Case tests ordered by recorded hits, recompile the blueprint to apply"), true);
+				}),
+				FCanExecuteAction::CreateLambda([WeakNode]()
+				{
+					const NodeType* SwitchNode = WeakNode.Get();
+					return SwitchNode && SwitchNode->MatchMode == EExtraSwitchMatchMode::FirstMatch && SwitchNode->AreCasesDisjoint();
+				})));
+
+		Section.AddMenuEntry(
+			"ResetCaseTestOrder",
+			INVTEXT("Reset Case Test Order"),
+			INVTEXT("Tests the cases in pin order again"),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateLambda([WeakNode]()
+				{
+					if (NodeType* SwitchNode = WeakNode.Get())
+					{
+						const FScopedTransaction Transaction(INVTEXT("Reset Case Test Order"));
+						SwitchNode->Modify();
+						SwitchNode->CaseTestOrder.Reset();
+						FBlueprintEditorUtils::MarkBlueprintAsModified(FBlueprintEditorUtils::FindBlueprintForNodeChecked(SwitchNode));
+					}
+				}),
+				FCanExecuteAction::CreateLambda([WeakNode]()
+				{
+					const NodeType* SwitchNode = WeakNode.Get();
+					return SwitchNode && SwitchNode->CaseTestOrder.Num() > 0;
+				})));
+	}
+
+	/**
+	 * @return The order to bake into the case table, empty if the node has none or it no longer applies to the current cases
+	 */
+	template<typename NodeType>
+	TConstArrayView<int32> GetUsableOrder(const NodeType* Node)
+	{
+		const bool bUsable = Node->MatchMode == EExtraSwitchMatchMode::FirstMatch && IsValidOrder(Node->CaseTestOrder, Node->PinValues.Num()) && Node->AreCasesDisjoint();
+		return bUsable ? TConstArrayView<int32>(Node->CaseTestOrder) : TConstArrayView<int32>();
+	}
+
+	// Tells the user why a stored order is not applied
+	template<typename NodeType>
+	void ValidateOrder(const NodeType* Node, FCompilerResultsLog& MessageLog)
+	{
+		if (Node->CaseTestOrder.Num() > 0 && GetUsableOrder(Node).Num() == 0)
+		{
+			MessageLog.Note(*INVTEXT("@@ ignores its case test order, it needs First Match mode, the same cases it was recorded for and cases that can't both match one value").ToString(), Node);
+		}
+	}
+}
@@ -0,0 +1,143 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchCasePins.h"
+#include "K2Node_Switch.h"
+#include "EdGraphSchema_K2.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+namespace ExtraSwitchCasePins
+{
+    // FName keeps the _N suffix of Case_N as its number, so the counter is read and written without touching the string
+    static const FName CasePinBaseName(TEXT("Case"));
+}
+
+FName ExtraSwitchCasePins::MakePinName(int32 Counter)
+{
+    return FName(CasePinBaseName, NAME_EXTERNAL_TO_INTERNAL(Counter));
+}
+
+int32 ExtraSwitchCasePins::GetNextPinNameCounter(TConstArrayView<FName> PinNames)
+{
+    int32 NextCounter = 0;
+    for (const FName PinName : PinNames)
+    {
+        if (PinName.GetComparisonIndex() == CasePinBaseName.GetComparisonIndex() && PinName.GetNumber() != NAME_NO_NUMBER_INTERNAL)
+        {
+            NextCounter = FMath::Max(NextCounter, NAME_INTERNAL_TO_EXTERNAL(PinName.GetNumber()) + 1);
+        }
+    }
+    return NextCounter;
+}
+
+void ExtraSwitchCasePins::SyncPinNames(TArray<FName>& PinNames, int32 NumCases)
+{
+    if (PinNames.Num() > NumCases)
+    {
+        PinNames.SetNum(NumCases);
+        return;
+    }
+
+    int32 Counter = GetNextPinNameCounter(PinNames);
+    PinNames.Reserve(NumCases);
+    while (PinNames.Num() < NumCases)
+    {
+        PinNames.Add(MakePinName(Counter++));
+    }
+}
+
+UEdGraphPin* ExtraSwitchCasePins::CreateCasePin(UK2Node_Switch* Node, FName PinName, int32 CaseIndex, const FText& Label)
+{
+    UEdGraphPin* Pin = Node->CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinName);
+    Pin->bAllowFriendlyName = false;
+    Pin->PinFriendlyName = Label;
+    Pin->SourceIndex = CaseIndex;
+    return Pin;
+}
+
+bool ExtraSwitchCasePins::UpdateCasePins(UK2Node_Switch* Node, TArray<FName>& PinNames, int32 NumCases, TFunctionRef<FText(int32)> GetCaseLabel, int32 ChangedCase)
+{
+    // One pass over the pins instead of a FindPin per case
+    TMap<FName, UEdGraphPin*> ExecOutputPins;
+    ExecOutputPins.Reserve(Node->Pins.Num());
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+        {
+            ExecOutputPins.Add(Pin->PinName, Pin);
+        }
+    }
+
+    Node->Modify();
+
+    bool bChanged = false;
+    bool bPinsChanged = false;
+    for (int32 Index = NumCases; Index < PinNames.Num(); ++Index)
+    {
+        if (UEdGraphPin* const* Pin = ExecOutputPins.Find(PinNames[Index]))
+        {
+            // Breaking a link edits the pins of the other node too, so an undo has to restore both sides
+            for (UEdGraphPin* LinkedPin : (*Pin)->LinkedTo)
+            {
+                LinkedPin->GetOwningNode()->Modify();
+            }
+            (*Pin)->BreakAllPinLinks(true);
+            Node->RemovePin(*Pin);
+            bChanged = true;
+            bPinsChanged = true;
+        }
+    }
+
+    const int32 NumExistingCases = FMath::Min(PinNames.Num(), NumCases);
+    SyncPinNames(PinNames, NumCases);
+
+    for (int32 Index = 0; Index < NumCases; ++Index)
+    {
+        if (ChangedCase != INDEX_NONE && Index != ChangedCase && Index < NumExistingCases)
+        {
+            continue;
+        }
+
+        UEdGraphPin* const* Pin = ExecOutputPins.Find(PinNames[Index]);
+        if (Pin == nullptr)
+        {
+            CreateCasePin(Node, PinNames[Index], Index, GetCaseLabel(Index));
+            bChanged = true;
+            bPinsChanged = true;
+            continue;
+        }
+
+        (*Pin)->SourceIndex = Index;
+        FText Label = GetCaseLabel(Index);
+        if (!(*Pin)->PinFriendlyName.EqualTo(Label))
+        {
+            (*Pin)->PinFriendlyName = MoveTemp(Label);
+            bChanged = true;
+        }
+    }
+
+    // Without the ReconstructNode that would have done it, the skeleton class has to be told the node's pins changed
+    if (bPinsChanged)
+    {
+        if (UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node))
+        {
+            FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        }
+    }
+    return bChanged;
+}
+
+bool ExtraSwitchCasePins::ShouldUpdatePins(const FPropertyChangedEvent& PropertyChangedEvent)
+{
+    return (PropertyChangedEvent.ChangeType & EPropertyChangeType::Interactive) == 0;
+}
+
+int32 ExtraSwitchCasePins::GetChangedCase(const FPropertyChangedEvent& PropertyChangedEvent, FName ArrayPropertyName, int32 NumCases, int32 NumPins)
+{
+    if (PropertyChangedEvent.ChangeType != EPropertyChangeType::ValueSet || NumCases != NumPins)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 CaseIndex = PropertyChangedEvent.GetArrayIndex(ArrayPropertyName.ToString());
+    return CaseIndex >= 0 && CaseIndex < NumCases ? CaseIndex : INDEX_NONE;
+}
@@ -0,0 +1,51 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+class UK2Node_Switch;
+class UEdGraphPin;
+
+/**
+ * Case pin bookkeeping shared by the switch nodes.
+ * Case pins are named Case_N from a running counter instead of probing FindPin from Case_0 for every new pin, and editing the cases updates
+ * the existing pins in place instead of going through ReconstructNode, which rebuilds and rewires every pin of the node.
+ */
+namespace ExtraSwitchCasePins
+{
+	// Case_N, built from the FName number so no string is formatted or parsed
+	FName MakePinName(int32 Counter);
+
+	// One past the highest N of the Case_N names in PinNames, names made from it can't collide with an existing case pin
+	int32 GetNextPinNameCounter(TConstArrayView<FName> PinNames);
+
+	// Grows or trims PinNames to one name per case, new names continue the counter after the highest one in use
+	void SyncPinNames(TArray<FName>& PinNames, int32 NumCases);
+
+	// Creates the output exec pin of a case
+	UEdGraphPin* CreateCasePin(UK2Node_Switch* Node, FName PinName, int32 CaseIndex, const FText& Label);
+
+	/**
+	 * Brings the case pins of an allocated node in line with its cases without a ReconstructNode.
+	 * Pins of removed cases lose their links and are removed, pins of added cases are appended and only the labels that changed are replaced.
+	 * Like ReconstructNode, a pin stays attached to its case index, so links follow the position and not the value.
+	 * The node and the nodes linked to removed pins are modified for undo, and the blueprint is marked structurally modified when pins are added or removed.
+	 * @param ChangedCase The only case whose value changed, or INDEX_NONE to compare every label
+	 * @return True if a pin was added, removed or relabelled
+	 */
+	bool UpdateCasePins(UK2Node_Switch* Node, TArray<FName>& PinNames, int32 NumCases, TFunctionRef<FText(int32)> GetCaseLabel, int32 ChangedCase = INDEX_NONE);
+
+	/**
+	 * Whether a change to the cases should update the pins now.
+	 * Dragging a value sends Interactive changes for every step of the drag, those are skipped and the pins follow the final change
+	 * the details panel sends when the drag's transaction ends.
+	 */
+	bool ShouldUpdatePins(const FPropertyChangedEvent& PropertyChangedEvent);
+
+	/**
+	 * @return The index of the only case a change touched, or INDEX_NONE if the change can have touched several (paste, add, remove, reorder)
+	 */
+	int32 GetChangedCase(const FPropertyChangedEvent& PropertyChangedEvent, FName ArrayPropertyName, int32 NumCases, int32 NumPins);
+}
@@ -0,0 +1,98 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchDispatch.h"
+
+/**
+ * Compile time interval analysis shared by Switch on Int Range and Switch on Float Range.
+ * Reports the overlapping cases, the gaps between them and whether they cover their whole span,
+ * and decides when a node can be compiled to a single lookup whatever its match mode is.
+ */
+namespace ExtraSwitchRangeAnalysis
+{
+	template<typename T, typename RangeType>
+	typename TRangeSwitch<T>::FAnalysis Analyze(const TArray<RangeType>& Ranges)
+	{
+		return TRangeSwitch<T>::Analyze(TRangeSwitch<T>::template MakeCases<RangeType>(Ranges));
+	}
+
+	/**
+	 * Disjoint cases can match a value at most once, so AllMatches and BestMatch give the same single case as FirstMatch
+	 * and the node compiles to one binary search instead of the AllMatches loop
+	 */
+	template<typename T, typename RangeType>
+	EExtraSwitchMatchMode GetCompiledMatchMode(const TArray<RangeType>& Ranges, EExtraSwitchMatchMode MatchMode)
+	{
+		if (MatchMode != EExtraSwitchMatchMode::FirstMatch && Analyze<T>(Ranges).IsDisjoint())
+		{
+			return EExtraSwitchMatchMode::FirstMatch;
+		}
+		return MatchMode;
+	}
+
+	template<typename T>
+	FString ToString(T Value)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			return FString::FromInt(Value);
+		}
+		else
+		{
+			return FString::SanitizeFloat(Value);
+		}
+	}
+
+	template<typename T>
+	FString ToString(const typename TRangeSwitch<T>::FInterval& Interval)
+	{
+		if (Interval.Low == Interval.High && Interval.bLowInclusive && Interval.bHighInclusive)
+		{
+			return ToString<T>(Interval.Low);
+		}
+		return FString::Printf(TEXT("%s%s,%s%s"), Interval.bLowInclusive ? TEXT("[") : TEXT("("), *ToString<T>(Interval.Low),
+			*ToString<T>(Interval.High), Interval.bHighInclusive ? TEXT("]") : TEXT(")"));
+	}
+
+	/**
+	 * Adds the analysis of a range node to the compiler log, every message links the case pins involved
+	 * @param Node - A switch node whose GetPinNameGivenIndex maps a case index to its pin
+	 */
+	template<typename T, typename NodeType>
+	void Report(const NodeType* Node, const typename TRangeSwitch<T>::FAnalysis& Analysis, EExtraSwitchMatchMode MatchMode, FCompilerResultsLog& MessageLog)
+	{
+		auto GetCasePin = [Node](int32 CaseIndex)
+		{
+			return Node->FindPin(Node->GetPinNameGivenIndex(CaseIndex));
+		};
+
+		// The other modes overlap on purpose
+		if (MatchMode == EExtraSwitchMatchMode::FirstMatch)
+		{
+			for (const TPair<int32, int32>& Overlap : Analysis.Overlaps)
+			{
+				MessageLog.Warning(TEXT("@@ : @@ and @@ overlap, values in both only execute the first one"), Node, GetCasePin(Overlap.Key), GetCasePin(Overlap.Value));
+			}
+		}
+
+		for (const typename TRangeSwitch<T>::FGap& Gap : Analysis.Gaps)
+		{
+			MessageLog.Note(*FString::Printf(TEXT("@@ : %s between @@ and @@ is not covered by any case and executes Default"), *ToString<T>(Gap.Values)),
+				Node, GetCasePin(Gap.CaseBelow), GetCasePin(Gap.CaseAbove));
+		}
+
+		if (Analysis.IsSpanCovered() && Analysis.IsDisjoint())
+		{
+			MessageLog.Note(*FString::Printf(TEXT("@@ : The cases are disjoint and cover %s without gaps, only values outside it execute Default"), *ToString<T>(Analysis.Span)), Node);
+		}
+
+		if (MatchMode != EExtraSwitchMatchMode::FirstMatch && Analysis.IsDisjoint())
+		{
+			MessageLog.Note(TEXT("@@ : The cases are disjoint, so every value matches at most one case and the node compiles to a single lookup"), Node);
+		}
+	}
+}
@@ -0,0 +1,227 @@
+// Copyright Amir Ben-Kiki 2025
+
+
+#include "K2Node_SwitchOnBitmask.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraph/EdGraphNode.h"
+#include "KismetCompiler.h"
+#include "EdGraphUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Logging/LogMacros.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+
+// Simple log category
+DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnBitmask, Log, All);
+
+class FKCHandler_SwitchOnBitmask : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnBitmask(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindBitmaskCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextBitmaskCaseIndex);
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnBitmask>(SwitchNode)->MatchMode;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnBitmask* BitmaskNode = CastChecked<UK2Node_SwitchOnBitmask>(SwitchNode);
+        Table->BuildBitmaskCases(BitmaskNode->PinValues, BitmaskNode->MatchMode);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const uint32 Value = (uint32)*static_cast<const int32*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindBitmaskCase(Value) : Table.FindNextBitmaskCase(Value, StartIndex);
+    }
+
+    virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const override
+    {
+        OutLookup = EExtraSwitchFusedLookup::Bitmask;
+        return true;
+    }
+};
+
+
+UK2Node_SwitchOnBitmask::UK2Node_SwitchOnBitmask()
+{
+    //Set the default function name and class, this is the function that will be called when the switch is executed, if it returns true the output pin will be executed
+    FunctionName = TEXT("IsBitmaskNotMatching");
+    FunctionClass = UExtraSwitchComparatorsFunctionLibrary::StaticClass();
+}
+
+void UK2Node_SwitchOnBitmask::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    UClass* ActionKey = GetClass();
+    if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+    {
+        UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+        check(NodeSpawner);
+
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+FText UK2Node_SwitchOnBitmask::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    return INVTEXT("Switch on Bitmask");
+}
+
+FText UK2Node_SwitchOnBitmask::GetTooltipText() const
+{
+    return INVTEXT("Switch statement on flag values, every case is a mask that matches when Any, All or Exactly its flags are set,\nthe first matching execution path will execute, \nMatch Mode can run every matching path or only the one testing the most flags instead \nif none do then default will execute");
+}
+
+void UK2Node_SwitchOnBitmask::CreateSelectionPin()
+{
+    const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+    UEdGraphPin* Pin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, TEXT("Selection"));
+    K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(Pin);
+}
+
+FName UK2Node_SwitchOnBitmask::GetPinNameGivenIndex(int32 Index) const
+{
+    if (Index < 0 || Index >= PinNames.Num())
+    {
+        return NAME_None;
+    }
+    return PinNames[Index];
+}
+
+FEdGraphPinType UK2Node_SwitchOnBitmask::GetInnerCaseType() const
+{
+    FEdGraphPinType PinType;
+    PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+    PinType.PinSubCategoryObject = FExtraSwitchBitmaskCase::StaticStruct();
+    return PinType;
+}
+
+FEdGraphPinType UK2Node_SwitchOnBitmask::GetPinType() const
+{
+    FEdGraphPinType PinType;
+    PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+    return PinType;
+}
+
+FText UK2Node_SwitchOnBitmask::GetCaseLabel(int32 CaseIndex) const
+{
+    return FText::FromString(FString::Printf(TEXT("%s 0x%X"),
+        *UEnum::GetDisplayValueAsText(PinValues[CaseIndex].Test).ToString(), (uint32)PinValues[CaseIndex].Mask));
+}
+
+void UK2Node_SwitchOnBitmask::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
+
+    // Create a pin for each mask, labelled like "All 0x5"
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
+    }
+}
+
+FName UK2Node_SwitchOnBitmask::GetUniquePinName()
+{
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
+}
+
+FString UK2Node_SwitchOnBitmask::GetExportTextForPin(const UEdGraphPin* InPin) const
+{
+    if (!InPin || InPin->SourceIndex < 0 || InPin->SourceIndex >= PinValues.Num())
+    {
+        UE_LOG(LogSwitchOnBitmask, Warning, TEXT("Invalid pin or source index for GetExportTextForPin"));
+        return TEXT("(Mask=0,Test=All)");
+    }
+
+    const FExtraSwitchBitmaskCase& Case = PinValues[InPin->SourceIndex];
+    return FString::Printf(TEXT("(Mask=%d,Test=%s)"), Case.Mask, *StaticEnum<EExtraSwitchBitmaskTest>()->GetNameStringByValue((int64)Case.Test));
+}
+
+FNodeHandlingFunctor* UK2Node_SwitchOnBitmask::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnBitmask::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnBitmask(CompilerContext);
+}
+
+void UK2Node_SwitchOnBitmask::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+    if ((PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnBitmask, PinValues) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(FExtraSwitchBitmaskCase, Mask) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(FExtraSwitchBitmaskCase, Test)) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
+    {
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnBitmask, PinValues), PinValues.Num(), PinNames.Num()));
+    }
+
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    GetGraph()->NotifyNodeChanged(this);
+}
+
+void UK2Node_SwitchOnBitmask::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+    Super::ValidateNodeDuringCompilation(MessageLog);
+
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        const FExtraSwitchBitmaskCase& Case = PinValues[Index];
+        if (Case.Mask != 0)
+        {
+            continue;
+        }
+
+        // An empty mask has no flags to test, Any can never pass and All passes for every value
+        if (Case.Test == EExtraSwitchBitmaskTest::Any)
+        {
+            MessageLog.Warning(*FText::Format(INVTEXT("@@ has an Any case with an empty mask at index {0}, it will never execute"), FText::AsNumber(Index)).ToString(), this);
+        }
+        else if (Case.Test == EExtraSwitchBitmaskTest::All && MatchMode == EExtraSwitchMatchMode::FirstMatch && Index < PinValues.Num() - 1)
+        {
+            MessageLog.Warning(*FText::Format(INVTEXT("@@ has an All case with an empty mask at index {0}, it matches every value so the cases after it will never execute"), FText::AsNumber(Index)).ToString(), this);
+        }
+    }
+
+    // The same mask and test twice can only ever execute the first one
+    TMap<TPair<int32, EExtraSwitchBitmaskTest>, int32> FirstIndexForCase;
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        const TPair<int32, EExtraSwitchBitmaskTest> Key(PinValues[Index].Mask, PinValues[Index].Test);
+        if (const int32* FirstIndex = FirstIndexForCase.Find(Key))
+        {
+            if (MatchMode != EExtraSwitchMatchMode::AllMatches)
+            {
+                MessageLog.Warning(*FText::Format(INVTEXT("@@ has the same case at indices {0} and {1}, only the first one will execute"),
+                    FText::AsNumber(*FirstIndex), FText::AsNumber(Index)).ToString(), this);
+            }
+        }
+        else
+        {
+            FirstIndexForCase.Add(Key, Index);
+        }
+    }
+}
@@ -6,6 +6,12 @@
 #include "EdGraphSchema_K2.h"
 #include "EdGraph/EdGraphNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
+#include "ExtraSwitchCaseOrdering.h"
+#include "ExtraSwitchDispatch.h"
 
 #include "Internationalization/Internationalization.h"
 #include "UObject/Class.h"
@@ -15,6 +21,52 @@
 // Simple log category
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnColor, Log, All);
 
+class FKCHandler_SwitchOnColor : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnColor(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindColorCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextColorCaseIndex);
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        const UK2Node_SwitchOnColor* Node = CastChecked<UK2Node_SwitchOnColor>(SwitchNode);
+        return Node->bCacheLastCase && Node->CanCacheLastCase()
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindColorCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnColor>(SwitchNode)->MatchMode;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnColor* ColorNode = CastChecked<UK2Node_SwitchOnColor>(SwitchNode);
+        Table->BuildColorCases(ColorNode->PinValues, ColorNode->Distance, ColorNode->ComparisonSpace, ColorNode->MatchMode,
+            ExtraSwitchCaseOrdering::GetUsableOrder(ColorNode));
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const FLinearColor& Value = *static_cast<const FLinearColor*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindColorCase(Value) : Table.FindNextColorCase(Value, StartIndex);
+    }
+};
+
 UK2Node_SwitchOnColor::UK2Node_SwitchOnColor()
 {
     SetupUseAlpha();
@@ -22,6 +74,17 @@ UK2Node_SwitchOnColor::UK2Node_SwitchOnColor()
     UE_LOG(LogSwitchOnColor, Log, TEXT("SwitchOnColor created, UseAlpha=%s"), UseAlpha ? TEXT("true") : TEXT("false"));
 }
 
+void UK2Node_SwitchOnColor::PostLoad()
+{
+    Super::PostLoad();
+
+    // UseAlpha was the only option before ComparisonSpace, HSV is the default so only alpha nodes need moving over
+    if (UseAlpha && ComparisonSpace == EExtraSwitchColorSpace::HSV)
+    {
+        ComparisonSpace = EExtraSwitchColorSpace::LinearRGBA;
+    }
+}
+
 void UK2Node_SwitchOnColor::SetupUseAlpha()
 {
     if (UseAlpha)
@@ -54,7 +117,7 @@ FText UK2Node_SwitchOnColor::GetNodeTitle(ENodeTitleType::Type TitleType) const
 
 inline FText UK2Node_SwitchOnColor::GetTooltipText() const
 {
-    return INVTEXT("Switch statement using color values and tolerance, \nany execution path that matches the equality condition will execute \nif none do then default will execute");
+    return INVTEXT("Switch statement using color values and tolerance, \nthe first execution path within tolerance will execute, \nMatch Mode can run every matching path or only the nearest one instead \nif none do then default will execute");
 }
 
 void UK2Node_SwitchOnColor::CreateSelectionPin()
@@ -87,49 +150,25 @@ FEdGraphPinType UK2Node_SwitchOnColor::GetPinType() const
     return PinType;
 }
 
-void UK2Node_SwitchOnColor::CreateCasePins()
+FText UK2Node_SwitchOnColor::GetCaseLabel(int32 CaseIndex) const
 {
-    while (PinValues.Num() > PinNames.Num())
-    {
-        const FName PinName = GetUniquePinName();
-        PinNames.Add(PinName);
-    }
-
-    if (PinNames.Num() > PinValues.Num())
-    {
-        PinNames.SetNum(PinValues.Num());
-    }
+    return FText::FromString(PinValues[CaseIndex].ToFColor(true).ToHex());
+}
 
-    UE_LOG(LogSwitchOnColor, Log, TEXT("Creating %d case pins"), PinValues.Num());
+void UK2Node_SwitchOnColor::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
+    // Create a pin for each color, labelled with its hex value
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinNames[Index]);
-        Pin->bAllowFriendlyName = false;
-        FString ColorHex = PinValues[Index].ToFColor(true).ToHex();
-        Pin->PinFriendlyName = FText::FromString(ColorHex);
-        Pin->SourceIndex = Index;
-        
-        UE_LOG(LogSwitchOnColor, Log, TEXT("  - Pin %d: Name=%s, Color=(%f,%f,%f,%f), Hex=%s"), 
-            Index, *PinNames[Index].ToString(), 
-            PinValues[Index].R, PinValues[Index].G, PinValues[Index].B, PinValues[Index].A,
-            *ColorHex);
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnColor::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnColor::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -137,39 +176,50 @@ FString UK2Node_SwitchOnColor::GetExportTextForPin(const UEdGraphPin* InPin) con
     FString ExportText = FString::Printf(TEXT("(Color=%s,Tolerance=%3.3f)"), 
         *PinValues[InPin->SourceIndex].ToString(), Distance);
     
-    UE_LOG(LogSwitchOnColor, Log, TEXT("ExportTextForPin: %s = %s"), 
+    UE_LOG(LogSwitchOnColor, VeryVerbose, TEXT("ExportTextForPin: %s = %s"), 
         *InPin->PinName.ToString(), *ExportText);
     
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnColor::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnColor::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnColor(CompilerContext);
+}
+
 void UK2Node_SwitchOnColor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-    
-    if (PropertyName == TEXT("PinValues") ||
-        PropertyName == TEXT("R") || 
-        PropertyName == TEXT("G") || 
-        PropertyName == TEXT("B") ||
-        (PropertyName == TEXT("A") && UseAlpha) ||
-        PropertyName == TEXT("Tolerance"))
+
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnColor, CaseSource))
     {
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnColor, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (PropertyName == TEXT("UseAlpha"))
+    // Only the compiled case table depends on the space, the pins stay as they are
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnColor, ComparisonSpace))
     {
+        UseAlpha = ComparisonSpace == EExtraSwitchColorSpace::LinearRGBA;
         SetupUseAlpha();
-        bIsDirty = true;
     }
 
-    if (bIsDirty)
+    if ((PropertyName == TEXT("PinValues") ||
+        PropertyName == TEXT("R") || PropertyName == TEXT("G") || PropertyName == TEXT("B") || PropertyName == TEXT("A")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        UE_LOG(LogSwitchOnColor, Log, TEXT("Property changed: %s, reconstructing node"), *PropertyName.ToString());
-        ReconstructNode();
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnColor, PinValues), PinValues.Num(), PinNames.Num()));
     }
-    
+
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
@@ -186,3 +236,39 @@ FLinearColor USwitchOnColorGraphSchema::GetPinTypeColor(const FEdGraphPinType& P
        return Super::GetPinTypeColor(PinType);
     }
 }
+
+bool UK2Node_SwitchOnColor::AreCasesDisjoint() const
+{
+    // Compare the colors in the space the table searches
+    TArray<FLinearColor> Centers;
+    Centers.Reserve(PinValues.Num());
+    for (const FLinearColor& Value : PinValues)
+    {
+        Centers.Add(UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(Value, ComparisonSpace));
+    }
+    return ExtraSwitch::AreToleranceCasesDisjoint<FLinearColor>(Centers, Distance);
+}
+
+bool UK2Node_SwitchOnColor::CanCacheLastCase() const
+{
+    return MatchMode != EExtraSwitchMatchMode::AllMatches && AreCasesDisjoint();
+}
+
+void UK2Node_SwitchOnColor::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseOrdering::AddContextMenuEntries(Menu, this);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
+void UK2Node_SwitchOnColor::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+    Super::ValidateNodeDuringCompilation(MessageLog);
+
+    ExtraSwitchCaseOrdering::ValidateOrder(this, MessageLog);
+
+    if (bCacheLastCase && !CanCacheLastCase())
+    {
+        MessageLog.Note(*INVTEXT("@@ doesn't cache its last case, a value can be within tolerance of several cases or it runs in All Matches mode").ToString(), this);
+    }
+}
@@ -14,10 +14,67 @@
 #include "Logging/LogMacros.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "K2Node_VariableGet.h"  // Added include for UK2Node_VariableGet
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
+#include "ExtraSwitchCaseOrdering.h"
+#include "ExtraSwitchDispatch.h"
 
 // Simple log category
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnFloat, Log, All);
 
+class FKCHandler_SwitchOnFloat : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnFloat(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFloatCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextFloatCaseIndex);
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        const UK2Node_SwitchOnFloat* Node = CastChecked<UK2Node_SwitchOnFloat>(SwitchNode);
+        return Node->bCacheLastCase && Node->CanCacheLastCase()
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFloatCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnFloat>(SwitchNode)->MatchMode;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnFloat* FloatNode = CastChecked<UK2Node_SwitchOnFloat>(SwitchNode);
+        Table->BuildFloatCases(FloatNode->PinValues, FloatNode->Tolerance, FloatNode->MatchMode, ExtraSwitchCaseOrdering::GetUsableOrder(FloatNode));
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const float Value = (float)*static_cast<const double*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindFloatCase(Value) : Table.FindNextFloatCase(Value, StartIndex);
+    }
+
+    virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const override
+    {
+        OutLookup = EExtraSwitchFusedLookup::Float;
+        return true;
+    }
+};
+
 UK2Node_SwitchOnFloat::UK2Node_SwitchOnFloat()
 {
     // Set the default function name and class
@@ -45,7 +102,7 @@ FText UK2Node_SwitchOnFloat::GetNodeTitle(ENodeTitleType::Type TitleType) const
 
 inline FText UK2Node_SwitchOnFloat::GetTooltipText() const
 {
-    return INVTEXT("Switch statement using float values and tolerance, \nany execution path that matches the equality condition will execute \nif none do then default will execute");
+    return INVTEXT("Switch statement using float values and tolerance, \nthe first execution path within tolerance will execute, \nMatch Mode can run every matching path or only the nearest one instead \nif none do then default will execute");
 }
 
 void UK2Node_SwitchOnFloat::CreateSelectionPin()
@@ -78,40 +135,25 @@ FEdGraphPinType UK2Node_SwitchOnFloat::GetPinType() const
     return PinType;
 }
 
+FText UK2Node_SwitchOnFloat::GetCaseLabel(int32 CaseIndex) const
+{
+    return FText::FromString(FString::Printf(TEXT("%f"), PinValues[CaseIndex]));
+}
+
 void UK2Node_SwitchOnFloat::CreateCasePins()
 {
-    // Clear existing pin names to ensure we create fresh unique names
-    PinNames.Empty();
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
-    // Create a unique name for each pin value
+    // Create a pin for each value
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        FName PinName = *FString::Printf(TEXT("Case_%d"), Index);
-        PinNames.Add(PinName);
-        
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinName);
-        Pin->bAllowFriendlyName = false;
-        Pin->PinFriendlyName = FText::FromString(FString::Printf(TEXT("%f"), PinValues[Index]));
-        Pin->SourceIndex = Index;
-        
-        UE_LOG(LogSwitchOnFloat, Warning, TEXT("Created pin %d: Name=%s, Value=%f"),
-            Index, *PinName.ToString(), PinValues[Index]);
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnFloat::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnFloat::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -119,33 +161,71 @@ FString UK2Node_SwitchOnFloat::GetExportTextForPin(const UEdGraphPin* InPin) con
     // Use "Value" with a capital V to match UE's property naming convention
     FString ExportText = FString::Printf(TEXT("(Value=%f,Tolerance=%f)"), PinValues[InPin->SourceIndex], Tolerance);
     
-    UE_LOG(LogSwitchOnFloat, Warning, TEXT("GetExportTextForPin: Pin=%s, Index=%d, Value=%f, Tolerance=%f, ExportText=%s"),
+    UE_LOG(LogSwitchOnFloat, VeryVerbose, TEXT("GetExportTextForPin: Pin=%s, Index=%d, Value=%f, Tolerance=%f, ExportText=%s"),
         *InPin->PinName.ToString(), InPin->SourceIndex, PinValues[InPin->SourceIndex], Tolerance, *ExportText);
     
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnFloat::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnFloat::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnFloat(CompilerContext);
+}
+
 void UK2Node_SwitchOnFloat::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 
-    if (PropertyName == TEXT("PinValues"))
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnFloat, CaseSource))
     {
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnFloat, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (PropertyName == TEXT("Tolerance"))
+    if ((PropertyName == TEXT("PinValues")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        bIsDirty = true;
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnFloat, PinValues), PinValues.Num(), PinNames.Num()));
     }
 
-    if (bIsDirty)
-    {
-        UE_LOG(LogSwitchOnFloat, Log, TEXT("Property changed: %s, reconstructing node"), *PropertyName.ToString());
-        ReconstructNode();
-    }
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
 
+bool UK2Node_SwitchOnFloat::AreCasesDisjoint() const
+{
+    return ExtraSwitch::AreToleranceCasesDisjoint<float>(PinValues, Tolerance);
+}
+
+bool UK2Node_SwitchOnFloat::CanCacheLastCase() const
+{
+    return MatchMode != EExtraSwitchMatchMode::AllMatches && AreCasesDisjoint();
+}
+
+void UK2Node_SwitchOnFloat::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseOrdering::AddContextMenuEntries(Menu, this);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
+void UK2Node_SwitchOnFloat::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+    Super::ValidateNodeDuringCompilation(MessageLog);
+
+    ExtraSwitchCaseOrdering::ValidateOrder(this, MessageLog);
+
+    if (bCacheLastCase && !CanCacheLastCase())
+    {
+        MessageLog.Note(*INVTEXT("@@ doesn't cache its last case, a value can be within tolerance of several cases or it runs in All Matches mode").ToString(), this);
+    }
+}
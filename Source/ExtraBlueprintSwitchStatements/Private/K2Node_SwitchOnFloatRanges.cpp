@@ -12,12 +12,78 @@
 #include "UObject/UnrealType.h"
 #include "Logging/LogMacros.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "K2Node_VariableGet.h"  // Added include for UK2Node_VariableGet
 #include "Engine/Engine.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
+#include "ExtraSwitchRangeAnalysis.h"
 
 // Simple log category
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnFloatRanges, Log, All);
 
+class FKCHandler_SwitchOnFloatRanges : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnFloatRanges(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFloatRangeCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextFloatRangeCaseIndex);
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        const UK2Node_SwitchOnFloatRanges* RangesNode = CastChecked<UK2Node_SwitchOnFloatRanges>(SwitchNode);
+        if (RangesNode->HysteresisMargin > 0.0f)
+        {
+            return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFloatRangeCaseIndexWithHysteresis);
+        }
+        return RangesNode->bCacheLastCase && RangesNode->CanCacheLastCase()
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFloatRangeCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnFloatRanges>(SwitchNode)->GetCompiledMatchMode();
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnFloatRanges* RangesNode = CastChecked<UK2Node_SwitchOnFloatRanges>(SwitchNode);
+        Table->BuildFloatRangeCases(RangesNode->PinValues, RangesNode->GetCompiledMatchMode());
+        Table->SetFloatRangeHysteresis(RangesNode->HysteresisMargin);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const float Value = (float)*static_cast<const double*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindFloatRangeCase(Value) : Table.FindNextFloatRangeCase(Value, StartIndex);
+    }
+
+    virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const override
+    {
+        // The hysteresis lookup only ever keeps a case the plain lookup returned, so the regions list every case either can return
+        SetReachableCases(Table->FloatRangeCases, OutReachable);
+    }
+
+    virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const override
+    {
+        OutLookup = EExtraSwitchFusedLookup::FloatRange;
+        return true;
+    }
+};
+
 UK2Node_SwitchOnFloatRanges::UK2Node_SwitchOnFloatRanges()
 {
     FunctionName = TEXT("IsFloatNotWithinRange");
@@ -44,7 +110,7 @@ FText UK2Node_SwitchOnFloatRanges::GetNodeTitle(ENodeTitleType::Type TitleType)
 
 inline FText UK2Node_SwitchOnFloatRanges::GetTooltipText() const
 {
-    return INVTEXT("Switch statement using float ranges, \nany execution path that matches the range condition will execute \nif none do then default will execute");
+    return INVTEXT("Switch statement using float ranges, \nthe first execution path whose range contains the selection will execute, \nMatch Mode can run every matching path or only the narrowest range instead \nif none do then default will execute");
 }
 
 void UK2Node_SwitchOnFloatRanges::CreateSelectionPin()
@@ -79,58 +145,30 @@ FEdGraphPinType UK2Node_SwitchOnFloatRanges::GetPinType() const
     return PinType;
 }
 
-void UK2Node_SwitchOnFloatRanges::CreateCasePins()
+FText UK2Node_SwitchOnFloatRanges::GetCaseLabel(int32 CaseIndex) const
 {
-    while (PinValues.Num() > PinNames.Num())
-    {
-        const FName PinName = GetUniquePinName();
-        PinNames.Add(PinName);
-    }
+    const FExtraSwitchFloatRange& Range = PinValues[CaseIndex];
+    return FText::FromString(Range.Inclusive
+        ? FString::Printf(TEXT("[%.3f,%.3f]"), Range.RangeMin, Range.RangeMax)
+        : FString::Printf(TEXT("(%.3f,%.3f)"), Range.RangeMin, Range.RangeMax));
+}
 
-    if (PinNames.Num() > PinValues.Num())
-    {
-        PinNames.SetNum(PinValues.Num());
-    }
+void UK2Node_SwitchOnFloatRanges::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
-    UE_LOG(LogSwitchOnFloatRanges, Log, TEXT("Creating %d case pins"), PinValues.Num());
+    bCasesDisjoint = ExtraSwitchRangeAnalysis::Analyze<float>(PinValues).IsDisjoint();
 
+    // Create a pin for each range
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinNames[Index]);
-
-        FString DisplayText;
-        if (PinValues[Index].Inclusive)
-        {
-            DisplayText = FString::Printf(TEXT("[%.3f,%.3f]"), PinValues[Index].RangeMin, PinValues[Index].RangeMax);
-        }
-        else
-        {
-            DisplayText = FString::Printf(TEXT("(%.3f,%.3f)"), PinValues[Index].RangeMin, PinValues[Index].RangeMax);
-        }
-        
-        Pin->PinFriendlyName = FText::FromString(DisplayText);
-        Pin->SourceIndex = Index;
-        
-        UE_LOG(LogSwitchOnFloatRanges, Log, TEXT("  - Pin %d: Name=%s, Range=%s, Min=%.3f, Max=%.3f, Inclusive=%s"), 
-            Index, *PinNames[Index].ToString(), *DisplayText,
-            PinValues[Index].RangeMin, PinValues[Index].RangeMax,
-            PinValues[Index].Inclusive ? TEXT("true") : TEXT("false"));
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnFloatRanges::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnFloatRanges::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -146,69 +184,60 @@ FString UK2Node_SwitchOnFloatRanges::GetExportTextForPin(const UEdGraphPin* InPi
                                        PinValues[InPin->SourceIndex].RangeMin,
                                        PinValues[InPin->SourceIndex].Inclusive ? TEXT("true") : TEXT("false"));
     
-    UE_LOG(LogSwitchOnFloatRanges, Log, TEXT("ExportTextForPin: %s = %s"), 
+    UE_LOG(LogSwitchOnFloatRanges, VeryVerbose, TEXT("ExportTextForPin: %s = %s"), 
         *InPin->PinName.ToString(), *ExportText);
     
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnFloatRanges::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnFloatRanges::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnFloatRanges(CompilerContext);
+}
+
 void UK2Node_SwitchOnFloatRanges::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 
-    if (PropertyName == TEXT("PinValues") || 
-        PropertyName == TEXT("RangeMax") || 
-        PropertyName == TEXT("RangeMin") || 
-        PropertyName == TEXT("Inclusive"))
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnFloatRanges, CaseSource))
     {
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (bIsDirty)
+    if ((PropertyName == TEXT("PinValues") ||
+        PropertyName == TEXT("RangeMax") ||
+        PropertyName == TEXT("RangeMin") ||
+        PropertyName == TEXT("Inclusive")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        UE_LOG(LogSwitchOnFloatRanges, Log, TEXT("Property changed: %s, reconstructing node"), *PropertyName.ToString());
-        ReconstructNode();
+        bCasesDisjoint = ExtraSwitchRangeAnalysis::Analyze<float>(PinValues).IsDisjoint();
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnFloatRanges, PinValues), PinValues.Num(), PinNames.Num()));
     }
+
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
 
+void UK2Node_SwitchOnFloatRanges::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
 void UK2Node_SwitchOnFloatRanges::ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const
 {
     Super::ValidateNodeDuringCompilation(MessageLog);
 
-    // ADD DEBUG INSPECTION FOR SELECTION PIN VALUE
-    UEdGraphPin* SelectionPin = GetSelectionPin();
-    if (SelectionPin && SelectionPin->LinkedTo.Num() > 0)
-    {
-        UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("VALIDATING - Selection pin has %d connections"), SelectionPin->LinkedTo.Num());
-        
-        // Log details about what's connected to the selection pin
-        for (UEdGraphPin* LinkedPin : SelectionPin->LinkedTo)
-        {
-            UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("  - Connected to: %s, PinName=%s"), 
-                *GetNameSafe(LinkedPin->GetOwningNode()), *LinkedPin->PinName.ToString());
-            
-            // If it's coming from a variable getter, show the variable name
-            UK2Node_VariableGet* VarNode = Cast<UK2Node_VariableGet>(LinkedPin->GetOwningNode());
-            if (VarNode)
-            {
-                FString VarName = VarNode->GetVarNameString();
-                UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("    => Variable: %s"), *VarName);
-            }
-        }
-    }
-    else
-    {
-        UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("VALIDATING - Selection pin has no connections"));
-        if (SelectionPin)
-        {
-            // Check if there's a default value set
-            UE_LOG(LogSwitchOnFloatRanges, Warning, TEXT("  - Default value: %s"), *SelectionPin->DefaultValue);
-        }
-    }
-
     TArray<int> InvalidRangePinIndex;
     TArray<int> ReversedRangePinIndex;
     
@@ -265,31 +294,27 @@ void UK2Node_SwitchOnFloatRanges::ValidateNodeDuringCompilation(class FCompilerR
         }
         MessageLog.Warning(*FText::Format(INVTEXT("@@ : Empty range detected in pin(s): {0}"), FText::FromString(WarningPins)).ToString(), this);
     }
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 
+    // Overlaps, gaps and coverage, reversed and empty ranges never match so the analysis skips them
+    ExtraSwitchRangeAnalysis::Report<float>(this, ExtraSwitchRangeAnalysis::Analyze<float>(PinValues), MatchMode, MessageLog);
 
+    if (HysteresisMargin > 0.0f && GetCompiledMatchMode() == EExtraSwitchMatchMode::AllMatches)
+    {
+        MessageLog.Note(*INVTEXT("@@ ignores its hysteresis margin, All Matches mode with overlapping ranges has no single case to remember").ToString(), this);
+    }
 
+    if (bCacheLastCase && !CanCacheLastCase())
+    {
+        MessageLog.Note(*INVTEXT("@@ doesn't cache its last case, a value can be contained by several ranges").ToString(), this);
+    }
+}
 
+EExtraSwitchMatchMode UK2Node_SwitchOnFloatRanges::GetCompiledMatchMode() const
+{
+    return ExtraSwitchRangeAnalysis::GetCompiledMatchMode<float>(PinValues, MatchMode);
+}
 
+bool UK2Node_SwitchOnFloatRanges::CanCacheLastCase() const
+{
+    return ExtraSwitchRangeAnalysis::Analyze<float>(PinValues).IsDisjoint();
+}
@@ -0,0 +1,196 @@
+// Copyright Amir Ben-Kiki 2025
+
+
+#include "K2Node_SwitchOnGameplayTag.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraph/EdGraphNode.h"
+#include "KismetCompiler.h"
+#include "EdGraphUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Logging/LogMacros.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+
+// Simple log category
+DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnGameplayTag, Log, All);
+
+class FKCHandler_SwitchOnGameplayTag : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnGameplayTag(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindGameplayTagCaseIndex);
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnGameplayTag* TagNode = CastChecked<UK2Node_SwitchOnGameplayTag>(SwitchNode);
+        Table->BuildGameplayTagCases(TagNode->PinValues, TagNode->MatchChildTags);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        return Table.FindGameplayTagCase(*static_cast<const FGameplayTag*>(Selection));
+    }
+
+    virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const override
+    {
+        // Duplicate tags are dropped, a child tag shadowed by its parent in hierarchy mode is still kept since the map alone can't tell
+        TArray<int32> CaseIndices;
+        Table->GameplayTagCaseIndices.GenerateValueArray(CaseIndices);
+        SetReachableCases(CaseIndices, OutReachable);
+    }
+};
+
+
+UK2Node_SwitchOnGameplayTag::UK2Node_SwitchOnGameplayTag()
+{
+    //Set the default function name and class, this is the function that will be called when the switch is executed, if it returns true the output pin will be executed
+    FunctionName = TEXT("AreGameplayTagsNotEqual");
+    FunctionClass = UExtraSwitchComparatorsFunctionLibrary::StaticClass();
+}
+
+void UK2Node_SwitchOnGameplayTag::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    UClass* ActionKey = GetClass();
+    if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+    {
+        UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+        check(NodeSpawner);
+
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+FText UK2Node_SwitchOnGameplayTag::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    return INVTEXT("Switch on Gameplay Tag");
+}
+
+FText UK2Node_SwitchOnGameplayTag::GetTooltipText() const
+{
+    return INVTEXT("Switch statement using a set of gameplay tags,\nwith Match Child Tags a case also executes for tags below it and the first matching case wins");
+}
+
+void UK2Node_SwitchOnGameplayTag::CreateSelectionPin()
+{
+    const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+    FEdGraphPinType PinType = GetInnerCaseType();
+    UEdGraphPin* Pin = CreatePin(EGPD_Input, PinType.PinCategory, PinType.PinSubCategoryObject.Get(), TEXT("Selection"));
+    K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(Pin);
+}
+
+FName UK2Node_SwitchOnGameplayTag::GetPinNameGivenIndex(int32 Index) const
+{
+    if (Index < 0 || Index >= PinNames.Num())
+    {
+        return NAME_None;
+    }
+    return PinNames[Index];
+}
+
+FEdGraphPinType UK2Node_SwitchOnGameplayTag::GetInnerCaseType() const
+{
+    FEdGraphPinType PinType;
+    PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+    PinType.PinSubCategoryObject = FGameplayTag::StaticStruct();
+    return PinType;
+}
+
+FEdGraphPinType UK2Node_SwitchOnGameplayTag::GetPinType() const
+{
+    return GetInnerCaseType();
+}
+
+FText UK2Node_SwitchOnGameplayTag::GetCaseLabel(int32 CaseIndex) const
+{
+    return FText::FromName(PinValues[CaseIndex].GetTagName());
+}
+
+void UK2Node_SwitchOnGameplayTag::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
+
+    // Create a pin for each value
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
+    }
+}
+
+FName UK2Node_SwitchOnGameplayTag::GetUniquePinName()
+{
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
+}
+
+FString UK2Node_SwitchOnGameplayTag::GetExportTextForPin(const UEdGraphPin* InPin) const
+{
+    if (!InPin || InPin->SourceIndex < 0 || InPin->SourceIndex >= PinValues.Num())
+    {
+        UE_LOG(LogSwitchOnGameplayTag, Warning, TEXT("Invalid pin or source index for GetExportTextForPin"));
+        return TEXT("(TagName=\"None\")");
+    }
+    return FString::Printf(TEXT("(TagName=\"%s\")"), *PinValues[InPin->SourceIndex].GetTagName().ToString());
+}
+
+FNodeHandlingFunctor* UK2Node_SwitchOnGameplayTag::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnGameplayTag::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnGameplayTag(CompilerContext);
+}
+
+void UK2Node_SwitchOnGameplayTag::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+    if ((PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnGameplayTag, PinValues)) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
+    {
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnGameplayTag, PinValues), PinValues.Num(), PinNames.Num()));
+    }
+
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    GetGraph()->NotifyNodeChanged(this);
+}
+
+void UK2Node_SwitchOnGameplayTag::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+    Super::ValidateNodeDuringCompilation(MessageLog);
+
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        if (!PinValues[Index].IsValid())
+        {
+            MessageLog.Warning(*FText::Format(INVTEXT("@@ has no tag set at index {0}, that case can never execute"), FText::AsNumber(Index)).ToString(), this);
+            continue;
+        }
+
+        // A case is unreachable when an earlier case is the same tag, or one of its parents while child tags match
+        for (int32 EarlierIndex = 0; EarlierIndex < Index; ++EarlierIndex)
+        {
+            const bool bShadowed = MatchChildTags ? PinValues[Index].MatchesTag(PinValues[EarlierIndex]) : PinValues[Index] == PinValues[EarlierIndex];
+            if (bShadowed)
+            {
+                MessageLog.Warning(*FText::Format(INVTEXT("@@ case {0} ({1}) is always handled by the earlier case {2} ({3}) and will never execute"),
+                    FText::AsNumber(Index), FText::FromName(PinValues[Index].GetTagName()),
+                    FText::AsNumber(EarlierIndex), FText::FromName(PinValues[EarlierIndex].GetTagName())).ToString(), this);
+                break;
+            }
+        }
+    }
+}
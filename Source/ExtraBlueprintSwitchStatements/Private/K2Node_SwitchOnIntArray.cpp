@@ -17,11 +17,61 @@
 #include "K2Node_VariableGet.h"
 #include "Logging/LogMacros.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
 #include "Engine/Engine.h"
 
 // Simple log category
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnIntArray, Log, All);
 
+class FKCHandler_SwitchOnIntArray : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnIntArray(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindIntArrayCaseIndex);
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        // Every value resolves to exactly one case, so caching is always safe
+        return CastChecked<UK2Node_SwitchOnIntArray>(SwitchNode)->bCacheLastCase
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindIntArrayCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnIntArray* IntArrayNode = CastChecked<UK2Node_SwitchOnIntArray>(SwitchNode);
+        Table->BuildIntCases(IntArrayNode->PinValues, IntArrayNode->MinJumpTableFill);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        return Table.FindIntCase(*static_cast<const int32*>(Selection));
+    }
+
+    virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const override
+    {
+        // A duplicate value only keeps its lowest case index, the later pins for it never run
+        SetReachableCases(Table->IntCaseIndices, OutReachable);
+    }
+
+    virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const override
+    {
+        OutLookup = EExtraSwitchFusedLookup::IntArray;
+        return true;
+    }
+};
+
 
 UK2Node_SwitchOnIntArray::UK2Node_SwitchOnIntArray()
 {
@@ -84,49 +134,25 @@ FEdGraphPinType UK2Node_SwitchOnIntArray::GetPinType() const
     return PinType;
 }
 
-void UK2Node_SwitchOnIntArray::CreateCasePins()
+FText UK2Node_SwitchOnIntArray::GetCaseLabel(int32 CaseIndex) const
 {
-    // Make sure we have a name for each pin value
-    while (PinValues.Num() > PinNames.Num())
-    {
-        const FName PinName = GetUniquePinName();
-        PinNames.Add(PinName);
-    }
+    return FText::FromString(FString::Printf(TEXT("%d"), PinValues[CaseIndex]));
+}
 
-    // Trim excess names if we have more names than values
-    if (PinNames.Num() > PinValues.Num())
-    {
-        PinNames.SetNum(PinValues.Num());
-    }
-    
-    UE_LOG(LogSwitchOnIntArray, Log, TEXT("Creating %d case pins"), PinValues.Num());
+void UK2Node_SwitchOnIntArray::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
     // Create a pin for each value
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinNames[Index]);
-        Pin->bAllowFriendlyName = false;
-        Pin->PinFriendlyName = FText::FromString(FString::Printf(TEXT("%d"), PinValues[Index]));
-        Pin->SourceIndex = Index;
-        
-        UE_LOG(LogSwitchOnIntArray, Log, TEXT("  - Pin %d: Name=%s, Value=%d"), 
-            Index, *PinNames[Index].ToString(), PinValues[Index]);
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnIntArray::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnIntArray::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -142,26 +168,46 @@ FString UK2Node_SwitchOnIntArray::GetExportTextForPin(const UEdGraphPin* InPin)
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnIntArray::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnIntArray::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnIntArray(CompilerContext);
+}
+
 void UK2Node_SwitchOnIntArray::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 
-    if (PropertyName == TEXT("PinValues"))
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnIntArray, CaseSource))
     {
-        UE_LOG(LogSwitchOnIntArray, VeryVerbose, TEXT("PinValues property changed, reconstructing node"));
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnIntArray, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (bIsDirty)
+    if ((PropertyName == TEXT("PinValues")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        ReconstructNode();
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnIntArray, PinValues), PinValues.Num(), PinNames.Num()));
     }
-    
+
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
 
+void UK2Node_SwitchOnIntArray::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
 void UK2Node_SwitchOnIntArray::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
 {
     Super::ValidateNodeDuringCompilation(MessageLog);
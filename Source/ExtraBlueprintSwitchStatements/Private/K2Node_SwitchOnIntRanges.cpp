@@ -12,13 +12,74 @@
 #include "UObject/UnrealType.h"
 #include "Logging/LogMacros.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "K2Node_VariableGet.h"
 #include "Engine/Engine.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
+#include "ExtraSwitchRangeAnalysis.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
 
 // Simple log category
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnIntRanges, Log, All);
 
+class FKCHandler_SwitchOnIntRanges : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnIntRanges(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindIntRangeCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextIntRangeCaseIndex);
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnIntRanges>(SwitchNode)->GetCompiledMatchMode();
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        const UK2Node_SwitchOnIntRanges* RangesNode = CastChecked<UK2Node_SwitchOnIntRanges>(SwitchNode);
+        return RangesNode->bCacheLastCase && RangesNode->CanCacheLastCase()
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindIntRangeCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnIntRanges* RangesNode = CastChecked<UK2Node_SwitchOnIntRanges>(SwitchNode);
+        Table->BuildIntRangeCases(RangesNode->PinValues, RangesNode->GetCompiledMatchMode());
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const int32 Value = *static_cast<const int32*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindIntRangeCase(Value) : Table.FindNextIntRangeCase(Value, StartIndex);
+    }
+
+    virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const override
+    {
+        // Empty and reversed ranges win no region, and neither does a range another one shadows in FirstMatch mode
+        SetReachableCases(Table->IntRangeCases, OutReachable);
+    }
+
+    virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const override
+    {
+        OutLookup = EExtraSwitchFusedLookup::IntRange;
+        return true;
+    }
+};
+
 UK2Node_SwitchOnIntRanges::UK2Node_SwitchOnIntRanges()
 {
     // Set the function name and class to use the static function from ExtraSwitchComparatorsFunctionLibrary
@@ -48,7 +109,7 @@ FText UK2Node_SwitchOnIntRanges::GetNodeTitle(ENodeTitleType::Type TitleType) co
 
 inline FText UK2Node_SwitchOnIntRanges::GetTooltipText() const
 {
-    return INVTEXT("Switch statement using integer ranges, \nany execution path that matches the equality condition will execute \nif none do then default will execute");
+    return INVTEXT("Switch statement using integer ranges, \nthe first execution path whose range contains the selection will execute, \nMatch Mode can run every matching path or only the narrowest range instead \nif none do then default will execute");
 }
 
 void UK2Node_SwitchOnIntRanges::CreateSelectionPin()
@@ -83,56 +144,30 @@ FEdGraphPinType UK2Node_SwitchOnIntRanges::GetPinType() const
     return PinType;
 }
 
+FText UK2Node_SwitchOnIntRanges::GetCaseLabel(int32 CaseIndex) const
+{
+    const FSwitchIntRange& Range = PinValues[CaseIndex];
+    return FText::FromString(Range.Inclusive
+        ? FString::Printf(TEXT("[%d,%d]"), Range.RangeMin, Range.RangeMax)
+        : FString::Printf(TEXT("(%d,%d)"), Range.RangeMin, Range.RangeMax));
+}
+
 void UK2Node_SwitchOnIntRanges::CreateCasePins()
 {
-    // Make sure we have a name for each pin value
-    while (PinValues.Num() > PinNames.Num())
-    {
-        const FName PinName = GetUniquePinName();
-        PinNames.Add(PinName);
-    }
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
-    // Trim excess names if we have more names than values
-    if (PinNames.Num() > PinValues.Num())
-    {
-        PinNames.SetNum(PinValues.Num());
-    }
-    
+    bCasesDisjoint = ExtraSwitchRangeAnalysis::Analyze<int32>(PinValues).IsDisjoint();
 
     // Create a pin for each range
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinNames[Index]);
-        
-        FString DisplayText;
-        if (PinValues[Index].Inclusive)
-        {
-            DisplayText = FString::Printf(TEXT("[%d,%d]"), PinValues[Index].RangeMin, PinValues[Index].RangeMax);
-        }
-        else
-        {
-            DisplayText = FString::Printf(TEXT("(%d,%d)"), PinValues[Index].RangeMin, PinValues[Index].RangeMax);
-        }
-        
-        Pin->PinFriendlyName = FText::FromString(DisplayText);
-        Pin->SourceIndex = Index;
-
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnIntRanges::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnIntRanges::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -158,29 +193,50 @@ FString UK2Node_SwitchOnIntRanges::GetExportTextForPin(const UEdGraphPin* InPin)
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnIntRanges::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnIntRanges::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnIntRanges(CompilerContext);
+}
+
 void UK2Node_SwitchOnIntRanges::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 
-    if (PropertyName == TEXT("PinValues") || 
-        PropertyName == TEXT("RangeMax") || 
-        PropertyName == TEXT("RangeMin") || 
-        PropertyName == TEXT("Inclusive"))
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnIntRanges, CaseSource))
     {
-        UE_LOG(LogSwitchOnIntRanges, Log, TEXT("Property changed: %s, reconstructing node"), *PropertyName.ToString());
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (bIsDirty)
+    if ((PropertyName == TEXT("PinValues") ||
+        PropertyName == TEXT("RangeMax") ||
+        PropertyName == TEXT("RangeMin") ||
+        PropertyName == TEXT("Inclusive")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        ReconstructNode();
+        bCasesDisjoint = ExtraSwitchRangeAnalysis::Analyze<int32>(PinValues).IsDisjoint();
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnIntRanges, PinValues), PinValues.Num(), PinNames.Num()));
     }
-    
+
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
 
+void UK2Node_SwitchOnIntRanges::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
 void UK2Node_SwitchOnIntRanges::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
 {
     Super::ValidateNodeDuringCompilation(MessageLog);
@@ -195,8 +251,6 @@ void UK2Node_SwitchOnIntRanges::ValidateNodeDuringCompilation(FCompilerResultsLo
         if (PinValues[Index].RangeMin > PinValues[Index].RangeMax)
         {
             ReversedRangePinIndex.Add(Index);
-            UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("Reversed range at pin %d: Min(%d) > Max(%d)"),
-                Index, PinValues[Index].RangeMin, PinValues[Index].RangeMax);
         }
         
         TRange<int> Range = TRange<int>();
@@ -207,40 +261,6 @@ void UK2Node_SwitchOnIntRanges::ValidateNodeDuringCompilation(FCompilerResultsLo
         if (Range.IsEmpty())
         {
             InvalidRangePinIndex.Add(Index);
-            UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("Empty range at pin %d: Min=%d, Max=%d, Inclusive=%s"),
-                Index, PinValues[Index].RangeMin, PinValues[Index].RangeMax, 
-                PinValues[Index].Inclusive ? TEXT("true") : TEXT("false"));
-        }
-    }
-
-    // Check for overlapping ranges, which could lead to multiple execution paths
-    // This isn't an error but could be confusing to users
-    TArray<TPair<int32, int32>> OverlappingRanges;
-    for (int32 i = 0; i < PinValues.Num(); ++i)
-    {
-        TRange<int> Range1 = PinValues[i].Inclusive ? 
-            TRange<int>::Inclusive(PinValues[i].RangeMin, PinValues[i].RangeMax) : 
-            TRange<int>::Exclusive(PinValues[i].RangeMin, PinValues[i].RangeMax);
-            
-        if (Range1.IsEmpty())
-            continue;
-            
-        for (int32 j = i + 1; j < PinValues.Num(); ++j)
-        {
-            TRange<int> Range2 = PinValues[j].Inclusive ? 
-                TRange<int>::Inclusive(PinValues[j].RangeMin, PinValues[j].RangeMax) : 
-                TRange<int>::Exclusive(PinValues[j].RangeMin, PinValues[j].RangeMax);
-                
-            if (Range2.IsEmpty())
-                continue;
-                
-            // Check for overlap
-            TRange<int> Overlap = TRange<int>::Intersection(Range1, Range2);
-            if (!Overlap.IsEmpty())
-            {
-                OverlappingRanges.Add(TPair<int32, int32>(i, j));
-                UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("Overlapping ranges at pins %d and %d"), i, j);
-            }
         }
     }
 
@@ -274,58 +294,22 @@ void UK2Node_SwitchOnIntRanges::ValidateNodeDuringCompilation(FCompilerResultsLo
         MessageLog.Warning(*FText::Format(INVTEXT("@@ : Empty range detected in pin(s): {0}"), FText::FromString(WarningPins)).ToString(), this);
     }
     
-    // Report overlapping ranges as warnings (multiple execution paths)
-    if (OverlappingRanges.Num() > 0)
-    {
-        FString WarningMessage = TEXT("Overlapping ranges detected between pins:\n");
-        for (int32 i = 0; i < OverlappingRanges.Num(); ++i)
-        {
-            int32 Pin1 = OverlappingRanges[i].Key;
-            int32 Pin2 = OverlappingRanges[i].Value;
-            
-            WarningMessage += FString::Printf(TEXT("- Pin %d (%s) and Pin %d (%s)\n"), 
-                Pin1, 
-                *(PinValues[Pin1].Inclusive ? 
-                    FString::Printf(TEXT("[%d,%d]"), PinValues[Pin1].RangeMin, PinValues[Pin1].RangeMax) : 
-                    FString::Printf(TEXT("(%d,%d)"), PinValues[Pin1].RangeMin, PinValues[Pin1].RangeMax)),
-                Pin2,
-                *(PinValues[Pin2].Inclusive ? 
-                    FString::Printf(TEXT("[%d,%d]"), PinValues[Pin2].RangeMin, PinValues[Pin2].RangeMax) : 
-                    FString::Printf(TEXT("(%d,%d)"), PinValues[Pin2].RangeMin, PinValues[Pin2].RangeMax))
-            );
-        }
-        WarningMessage += TEXT("Values in overlapping ranges will execute multiple paths.");
-        MessageLog.Warning(*WarningMessage, this);
-    }
+    // Overlaps, gaps and coverage, reversed and empty ranges never match so the analysis skips them
+    ExtraSwitchRangeAnalysis::Report<int32>(this, ExtraSwitchRangeAnalysis::Analyze<int32>(PinValues), MatchMode, MessageLog);
 
-    // ADD DEBUG INSPECTION FOR SELECTION PIN VALUE
-    UEdGraphPin* SelectionPin = GetSelectionPin();
-    if (SelectionPin && SelectionPin->LinkedTo.Num() > 0)
+    if (bCacheLastCase && !CanCacheLastCase())
     {
-        UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("VALIDATING - Selection pin has %d connections"), SelectionPin->LinkedTo.Num());
-        
-        // Log details about what's connected to the selection pin
-        for (UEdGraphPin* LinkedPin : SelectionPin->LinkedTo)
-        {
-            UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("  - Connected to: %s, PinName=%s"), 
-                *GetNameSafe(LinkedPin->GetOwningNode()), *LinkedPin->PinName.ToString());
-            
-            // If it's coming from a variable getter, show the variable name
-            UK2Node_VariableGet* VarNode = Cast<UK2Node_VariableGet>(LinkedPin->GetOwningNode());
-            if (VarNode)
-            {
-                FString VarName = VarNode->GetVarNameString();
-                UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("    => Variable: %s"), *VarName);
-            }
-        }
-    }
-    else
-    {
-        UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("VALIDATING - Selection pin has no connections"));
-        if (SelectionPin)
-        {
-            // Check if there's a default value set
-            UE_LOG(LogSwitchOnIntRanges, Warning, TEXT("  - Default value: %s"), *SelectionPin->DefaultValue);
-        }
+        MessageLog.Note(*INVTEXT("@@ doesn't cache its last case, a value can be contained by several ranges").ToString(), this);
     }
+
+}
+
+EExtraSwitchMatchMode UK2Node_SwitchOnIntRanges::GetCompiledMatchMode() const
+{
+    return ExtraSwitchRangeAnalysis::GetCompiledMatchMode<int32>(PinValues, MatchMode);
+}
+
+bool UK2Node_SwitchOnIntRanges::CanCacheLastCase() const
+{
+    return ExtraSwitchRangeAnalysis::Analyze<int32>(PinValues).IsDisjoint();
 }
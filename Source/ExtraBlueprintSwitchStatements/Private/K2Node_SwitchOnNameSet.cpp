@@ -0,0 +1,187 @@
+// Copyright Amir Ben-Kiki 2025
+
+
+#include "K2Node_SwitchOnNameSet.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraph/EdGraphNode.h"
+#include "KismetCompiler.h"
+#include "EdGraphUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Logging/LogMacros.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+
+// Simple log category
+DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnNameSet, Log, All);
+
+class FKCHandler_SwitchOnNameSet : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnNameSet(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNameCaseIndex);
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        Table->BuildNameCases(CastChecked<UK2Node_SwitchOnNameSet>(SwitchNode)->PinValues);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        return Table.FindNameCase(*static_cast<const FName*>(Selection));
+    }
+
+    virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const override
+    {
+        TArray<int32> CaseIndices;
+        Table->NameCaseIndices.GenerateValueArray(CaseIndices);
+        SetReachableCases(CaseIndices, OutReachable);
+    }
+};
+
+
+UK2Node_SwitchOnNameSet::UK2Node_SwitchOnNameSet()
+{
+    //Set the default function name and class, this is the function that will be called when the switch is executed, if it returns true the output pin will be executed
+    FunctionName = TEXT("AreNamesNotEqual");
+    FunctionClass = UExtraSwitchComparatorsFunctionLibrary::StaticClass();
+}
+
+void UK2Node_SwitchOnNameSet::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    UClass* ActionKey = GetClass();
+    if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+    {
+        UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+        check(NodeSpawner);
+
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+FText UK2Node_SwitchOnNameSet::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    return INVTEXT("Switch on Name Set");
+}
+
+FText UK2Node_SwitchOnNameSet::GetTooltipText() const
+{
+    return INVTEXT("Switch statement using a set of names,\nthe cases are hashed so many cases cost the same as a few");
+}
+
+void UK2Node_SwitchOnNameSet::CreateSelectionPin()
+{
+    const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+    UEdGraphPin* Pin = CreatePin(EGPD_Input, GetInnerCaseType().PinCategory, TEXT("Selection"));
+    K2Schema->SetPinAutogeneratedDefaultValueBasedOnType(Pin);
+}
+
+FName UK2Node_SwitchOnNameSet::GetPinNameGivenIndex(int32 Index) const
+{
+    if (Index < 0 || Index >= PinNames.Num())
+    {
+        return NAME_None;
+    }
+    return PinNames[Index];
+}
+
+FEdGraphPinType UK2Node_SwitchOnNameSet::GetInnerCaseType() const
+{
+    FEdGraphPinType PinType;
+    PinType.PinCategory = UEdGraphSchema_K2::PC_Name;
+    return PinType;
+}
+
+FEdGraphPinType UK2Node_SwitchOnNameSet::GetPinType() const
+{
+    FEdGraphPinType PinType;
+    PinType.PinCategory = UEdGraphSchema_K2::PC_Name;
+    return PinType;
+}
+
+FText UK2Node_SwitchOnNameSet::GetCaseLabel(int32 CaseIndex) const
+{
+    return FText::FromName(PinValues[CaseIndex]);
+}
+
+void UK2Node_SwitchOnNameSet::CreateCasePins()
+{
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
+
+    // Create a pin for each value
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
+    }
+}
+
+FName UK2Node_SwitchOnNameSet::GetUniquePinName()
+{
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
+}
+
+FString UK2Node_SwitchOnNameSet::GetExportTextForPin(const UEdGraphPin* InPin) const
+{
+    if (!InPin || InPin->SourceIndex < 0 || InPin->SourceIndex >= PinValues.Num())
+    {
+        UE_LOG(LogSwitchOnNameSet, Warning, TEXT("Invalid pin or source index for GetExportTextForPin"));
+        return TEXT("None");
+    }
+    return PinValues[InPin->SourceIndex].ToString();
+}
+
+FNodeHandlingFunctor* UK2Node_SwitchOnNameSet::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnNameSet::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnNameSet(CompilerContext);
+}
+
+void UK2Node_SwitchOnNameSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+    if ((PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnNameSet, PinValues)) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
+    {
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnNameSet, PinValues), PinValues.Num(), PinNames.Num()));
+    }
+
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    GetGraph()->NotifyNodeChanged(this);
+}
+
+void UK2Node_SwitchOnNameSet::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+    Super::ValidateNodeDuringCompilation(MessageLog);
+
+    // Names compare case-insensitively, so "Jump" and "jump" are the same case and only the first one can execute
+    TMap<FName, int32> FirstIndexForName;
+    for (int32 Index = 0; Index < PinValues.Num(); ++Index)
+    {
+        if (const int32* FirstIndex = FirstIndexForName.Find(PinValues[Index]))
+        {
+            MessageLog.Warning(*FText::Format(INVTEXT("@@ has the name {0} at indices {1} and {2}, only the first one will execute"),
+                FText::FromName(PinValues[Index]), FText::AsNumber(*FirstIndex), FText::AsNumber(Index)).ToString(), this);
+        }
+        else
+        {
+            FirstIndexForName.Add(PinValues[Index], Index);
+        }
+    }
+}
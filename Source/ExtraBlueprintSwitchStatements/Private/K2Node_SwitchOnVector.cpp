@@ -6,6 +6,12 @@
 #include "EdGraphSchema_K2.h"
 #include "EdGraph/EdGraphNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "ExtraSwitchCasePins.h"
+#include "ExtraSwitchCaseImport.h"
+#include "ExtraSwitchCaseOrdering.h"
+#include "ExtraSwitchDispatch.h"
 
 #include "KismetCompiler.h"
 #include "EdGraphUtilities.h"
@@ -14,11 +20,56 @@
 #include "UObject/UnrealType.h"
 #include "Logging/LogMacros.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "K2Node_VariableGet.h"
 
 // Simple log category for debugging
 DEFINE_LOG_CATEGORY_STATIC(LogSwitchOnVector, Log, All);
 
+class FKCHandler_SwitchOnVector : public FKCHandler_ExtraSwitchDispatch
+{
+public:
+    FKCHandler_SwitchOnVector(FKismetCompilerContext& InCompilerContext)
+        : FKCHandler_ExtraSwitchDispatch(InCompilerContext)
+    {
+    }
+
+protected:
+    virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindVectorCaseIndex);
+    }
+
+    virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        return GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindNextVectorCaseIndex);
+    }
+
+    virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const override
+    {
+        const UK2Node_SwitchOnVector* Node = CastChecked<UK2Node_SwitchOnVector>(SwitchNode);
+        return Node->bCacheLastCase && Node->CanCacheLastCase()
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindVectorCaseIndexCached)
+            : NAME_None;
+    }
+
+    virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const override
+    {
+        return CastChecked<UK2Node_SwitchOnVector>(SwitchNode)->MatchMode;
+    }
+
+    virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const override
+    {
+        const UK2Node_SwitchOnVector* VectorNode = CastChecked<UK2Node_SwitchOnVector>(SwitchNode);
+        Table->BuildVectorCases(VectorNode->PinValues, VectorNode->Tolerance, VectorNode->MatchMode, ExtraSwitchCaseOrdering::GetUsableOrder(VectorNode),
+            VectorNode->Precision);
+    }
+
+    virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const override
+    {
+        const FVector& Value = *static_cast<const FVector*>(Selection);
+        return StartIndex == INDEX_NONE ? Table.FindVectorCase(Value) : Table.FindNextVectorCase(Value, StartIndex);
+    }
+};
+
 UK2Node_SwitchOnVector::UK2Node_SwitchOnVector()
 {
     // Set the function name and class to use the static function from ExtraSwitchComparatorsFunctionLibrary
@@ -54,7 +105,7 @@ static bool PointsAreNear(const FVector& Point1, const FVector& Point2, float Di
     return true;
 }
 
-bool UK2Node_SwitchOnVector::IsVectorWithToleranceNotNearlyEqual(FVector& A, FVectorAndTolerance& B)
+bool UK2Node_SwitchOnVector::IsVectorWithToleranceNotNearlyEqual(const FVector& A, const FVectorAndTolerance& B)
 {
     // Delegate to the function library implementation
     return UExtraSwitchComparatorsFunctionLibrary::IsVectorWithToleranceNotNearlyEqual(A, B);
@@ -62,7 +113,7 @@ bool UK2Node_SwitchOnVector::IsVectorWithToleranceNotNearlyEqual(FVector& A, FVe
 
 inline FText UK2Node_SwitchOnVector::GetTooltipText() const
 {
-    return INVTEXT("Switch statement using vector values and tolerance, \nany execution path that matches the equality condition will execute \nif none do then default will execute");
+    return INVTEXT("Switch statement using vector values and tolerance, \nthe first execution path within tolerance will execute, \nMatch Mode can run every matching path or only the nearest one instead \nif none do then default will execute");
 }
 
 void UK2Node_SwitchOnVector::CreateSelectionPin()
@@ -95,40 +146,25 @@ FEdGraphPinType UK2Node_SwitchOnVector::GetPinType() const
     return PinType;
 }
 
+FText UK2Node_SwitchOnVector::GetCaseLabel(int32 CaseIndex) const
+{
+    return FText::FromString(PinValues[CaseIndex].ToString());
+}
+
 void UK2Node_SwitchOnVector::CreateCasePins()
 {
-    // Clear existing pin names to ensure we create fresh unique names
-    PinNames.Empty();
+    ExtraSwitchCasePins::SyncPinNames(PinNames, PinValues.Num());
 
-    // Create a unique name for each pin value
+    // Create a pin for each value
     for (int32 Index = 0; Index < PinValues.Num(); ++Index)
     {
-        FName PinName = *FString::Printf(TEXT("Case_%d"), Index);
-        PinNames.Add(PinName);
-        
-        UEdGraphPin* Pin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, PinName);
-        Pin->bAllowFriendlyName = false;
-        Pin->PinFriendlyName = FText::FromString(PinValues[Index].ToString());
-        Pin->SourceIndex = Index;
-        
-        UE_LOG(LogSwitchOnVector, Warning, TEXT("Created pin %d: Name=%s, Value=%s"),
-            Index, *PinName.ToString(), *PinValues[Index].ToString());
+        ExtraSwitchCasePins::CreateCasePin(this, PinNames[Index], Index, GetCaseLabel(Index));
     }
 }
 
 FName UK2Node_SwitchOnVector::GetUniquePinName()
 {
-    FName NewPinName;
-    int32 Index = 0;
-    while (true)
-    {
-        NewPinName = *FString::Printf(TEXT("Case_%d"), Index++);
-        if (!FindPin(NewPinName))
-        {
-            break;
-        }
-    }
-    return NewPinName;
+    return ExtraSwitchCasePins::MakePinName(ExtraSwitchCasePins::GetNextPinNameCounter(PinNames));
 }
 
 FString UK2Node_SwitchOnVector::GetExportTextForPin(const UEdGraphPin* InPin) const
@@ -140,40 +176,47 @@ FString UK2Node_SwitchOnVector::GetExportTextForPin(const UEdGraphPin* InPin) co
 
     // Format the vector and tolerance as an FVectorAndTolerance struct
     const FVector& Value = PinValues[InPin->SourceIndex];
-    FString ExportText = FString::Printf(TEXT("(X=%3.3f,Y=%3.3f,Z=%3.3f,Tolerance=%3.3f)"), 
+    // %.17g round trips the double exactly, FVectorAndTolerance holds doubles so the case point keeps every digit
+    FString ExportText = FString::Printf(TEXT("(X=%.17g,Y=%.17g,Z=%.17g,Tolerance=%3.3f)"), 
         Value.X, Value.Y, Value.Z, Tolerance);
     
-    UE_LOG(LogSwitchOnVector, Warning, TEXT("GetExportTextForPin: Pin=%s, Index=%d, Value=%s, Tolerance=%f, ExportText=%s"),
+    UE_LOG(LogSwitchOnVector, VeryVerbose, TEXT("GetExportTextForPin: Pin=%s, Index=%d, Value=%s, Tolerance=%f, ExportText=%s"),
         *InPin->PinName.ToString(), InPin->SourceIndex, *Value.ToString(), Tolerance, *ExportText);
     
     return ExportText;
 }
 
+FNodeHandlingFunctor* UK2Node_SwitchOnVector::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return CreateDispatchHandler(CompilerContext);
+}
+
+FKCHandler_ExtraSwitchDispatch* UK2Node_SwitchOnVector::CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FKCHandler_SwitchOnVector(CompilerContext);
+}
+
 void UK2Node_SwitchOnVector::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-    bool bIsDirty = false;
     FName PropertyName = (PropertyChangedEvent.Property != NULL) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-    
-    if (PropertyName == TEXT("PinValues"))
-    {
-        bIsDirty = true;
-    }
 
-    if (PropertyName == TEXT("X") || PropertyName == TEXT("Y") || PropertyName == TEXT("Z"))
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnVector, CaseSource))
     {
-        bIsDirty = true;
+        FText Error;
+        if (!ExtraSwitchCaseImport::ImportCases(this, false, Error) && !Error.IsEmpty())
+        {
+            UE_LOG(LogSwitchOnVector, Warning, TEXT("%s"), *Error.ToString());
+        }
     }
 
-    if (PropertyName == TEXT("Tolerance"))
+    if ((PropertyName == TEXT("PinValues") ||
+        PropertyName == TEXT("X") || PropertyName == TEXT("Y") || PropertyName == TEXT("Z")) && ExtraSwitchCasePins::ShouldUpdatePins(PropertyChangedEvent))
     {
-        bIsDirty = true;
+        ExtraSwitchCasePins::UpdateCasePins(this, PinNames, PinValues.Num(),
+            [this](int32 CaseIndex) { return GetCaseLabel(CaseIndex); },
+            ExtraSwitchCasePins::GetChangedCase(PropertyChangedEvent, GET_MEMBER_NAME_CHECKED(UK2Node_SwitchOnVector, PinValues), PinValues.Num(), PinNames.Num()));
     }
 
-    if (bIsDirty)
-    {
-        UE_LOG(LogSwitchOnVector, Log, TEXT("Property changed: %s, reconstructing node"), *PropertyName.ToString());
-        ReconstructNode();
-    }
     Super::PostEditChangeProperty(PropertyChangedEvent);
     GetGraph()->NotifyNodeChanged(this);
 }
@@ -182,37 +225,30 @@ void UK2Node_SwitchOnVector::ValidateNodeDuringCompilation(FCompilerResultsLog&
 {
     Super::ValidateNodeDuringCompilation(MessageLog);
 
-    // ADD DEBUG INSPECTION FOR SELECTION PIN VALUE
-    UEdGraphPin* SelectionPin = GetSelectionPin();
-    if (SelectionPin && SelectionPin->LinkedTo.Num() > 0)
-    {
-        UE_LOG(LogSwitchOnVector, Warning, TEXT("VALIDATING - Selection pin has %d connections"), SelectionPin->LinkedTo.Num());
-        
-        // Log details about what's connected to the selection pin
-        for (UEdGraphPin* LinkedPin : SelectionPin->LinkedTo)
-        {
-            UE_LOG(LogSwitchOnVector, Warning, TEXT("  - Connected to: %s, PinName=%s"), 
-                *GetNameSafe(LinkedPin->GetOwningNode()), *LinkedPin->PinName.ToString());
-            
-            // If it's coming from a variable getter, show the variable name
-            UK2Node_VariableGet* VarNode = Cast<UK2Node_VariableGet>(LinkedPin->GetOwningNode());
-            if (VarNode)
-            {
-                FString VarName = VarNode->GetVarNameString();
-                UE_LOG(LogSwitchOnVector, Warning, TEXT("    => Variable: %s"), *VarName);
-            }
-        }
-    }
-    else
+    ExtraSwitchCaseOrdering::ValidateOrder(this, MessageLog);
+
+    if (bCacheLastCase && !CanCacheLastCase())
     {
-        UE_LOG(LogSwitchOnVector, Warning, TEXT("VALIDATING - Selection pin has no connections"));
-        if (SelectionPin)
-        {
-            // Check if there's a default value set
-            UE_LOG(LogSwitchOnVector, Warning, TEXT("  - Default value: %s"), *SelectionPin->DefaultValue);
-        }
+        MessageLog.Note(*INVTEXT("@@ doesn't cache its last case, a value can be within tolerance of several cases or it runs in All Matches mode").ToString(), this);
     }
 }
 
+bool UK2Node_SwitchOnVector::AreCasesDisjoint() const
+{
+    return ExtraSwitch::AreToleranceCasesDisjoint<FVector>(PinValues, Tolerance);
+}
+
+bool UK2Node_SwitchOnVector::CanCacheLastCase() const
+{
+    return MatchMode != EExtraSwitchMatchMode::AllMatches && AreCasesDisjoint();
+}
+
+void UK2Node_SwitchOnVector::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenuContext* Context) const
+{
+    Super::GetNodeContextMenuActions(Menu, Context);
+    ExtraSwitchCaseOrdering::AddContextMenuEntries(Menu, this);
+    ExtraSwitchCaseImport::AddContextMenuEntries(Menu, this);
+}
+
 
 
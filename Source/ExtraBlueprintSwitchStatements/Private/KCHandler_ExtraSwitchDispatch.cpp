@@ -0,0 +1,731 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "KCHandler_ExtraSwitchDispatch.h"
+#include "K2Node_Switch.h"
+#include "KismetCompiler.h"
+#include "KismetCompiledFunctionContext.h"
+#include "BPTerminal.h"
+#include "EdGraphUtilities.h"
+#include "EdGraphSchema_K2.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchNode.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+namespace ExtraSwitchFusion
+{
+    // More levels stop paying off, every level is one more lookup inside the call
+    static constexpr int32 MaxFusedSwitches = 8;
+
+    static bool IsFloatLookup(EExtraSwitchFusedLookup Lookup)
+    {
+        return Lookup == EExtraSwitchFusedLookup::FloatRange || Lookup == EExtraSwitchFusedLookup::Float;
+    }
+
+    // A pure node other than a getter could return something else when the next switch evaluates it again, like a random float
+    static bool IsStableSelectionSource(const UEdGraphPin* SourcePin)
+    {
+        const UK2Node* SourceNode = Cast<UK2Node>(SourcePin->GetOwningNode());
+        return SourceNode && (!SourceNode->IsNodePure() || SourceNode->IsA<UK2Node_VariableGet>());
+    }
+
+    // Nothing runs between two fused switches, so two getters of the same variable read the same value
+    static bool IsSameSelectionSource(const UEdGraphPin* A, const UEdGraphPin* B)
+    {
+        if (A == B)
+        {
+            return true;
+        }
+
+        const UK2Node_VariableGet* GetA = Cast<UK2Node_VariableGet>(A->GetOwningNode());
+        const UK2Node_VariableGet* GetB = Cast<UK2Node_VariableGet>(B->GetOwningNode());
+        if (GetA == nullptr || GetB == nullptr || A->PinName != B->PinName)
+        {
+            return false;
+        }
+
+        const FMemberReference& VariableA = GetA->VariableReference;
+        const FMemberReference& VariableB = GetB->VariableReference;
+        return VariableA.GetMemberName() == VariableB.GetMemberName()
+            && VariableA.IsLocalScope() == VariableB.IsLocalScope()
+            && (VariableA.IsSelfContext() || VariableA.IsLocalScope())
+            && (VariableB.IsSelfContext() || VariableB.IsLocalScope());
+    }
+}
+
+FKCHandler_ExtraSwitchDispatch::FKCHandler_ExtraSwitchDispatch(FKismetCompilerContext& InCompilerContext)
+    : FNodeHandlingFunctor(InCompilerContext)
+{
+}
+
+void FKCHandler_ExtraSwitchDispatch::RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+    FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+    // Holds the case index returned by the resolve function
+    FBPTerminal* IndexTerm = Context.CreateLocalTerminal();
+    IndexTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+    IndexTerm->Source = Node;
+    IndexTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CaseIndex"));
+    IndexTermMap.Add(Node, IndexTerm);
+
+    // Holds the result of each index comparison in the dispatch tree
+    FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+    BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+    BoolTerm->Source = Node;
+    BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CaseIndexBelow"));
+    BoolTermMap.Add(Node, BoolTerm);
+
+    // In AllMatches mode the selection is resolved again after every pin, so it is copied once in case the pins change it
+    UK2Node_Switch* SwitchNode = CastChecked<UK2Node_Switch>(Node);
+    UEdGraphPin* SelectionPin = SwitchNode->GetSelectionPin();
+    if (SelectionPin && GetMatchMode(SwitchNode) == EExtraSwitchMatchMode::AllMatches)
+    {
+        FBPTerminal* SelectionCopyTerm = Context.CreateLocalTerminal();
+        SelectionCopyTerm->Type = SelectionPin->PinType;
+        SelectionCopyTerm->Source = Node;
+        SelectionCopyTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("SelectionCopy"));
+        SelectionCopyTermMap.Add(Node, SelectionCopyTerm);
+    }
+
+    // The case slot must outlive the call, only the event graph frame persists between executions like the state of a Do Once node
+    if (!GetResolveWithSlotFunctionName(SwitchNode).IsNone() && GetMatchMode(SwitchNode) != EExtraSwitchMatchMode::AllMatches)
+    {
+        if (Context.IsEventGraph())
+        {
+            FBPTerminal* CaseSlotTerm = new FBPTerminal();
+            Context.EventGraphLocals.Add(CaseSlotTerm);
+            CaseSlotTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+            CaseSlotTerm->Source = Node;
+            CaseSlotTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CaseSlot"));
+            CaseSlotTermMap.Add(Node, CaseSlotTerm);
+        }
+        else
+        {
+            CompilerContext.MessageLog.Warning(*INVTEXT("@@ can only remember its last case in the event graph, in a function it resolves every execution from scratch").ToString(), Node);
+        }
+    }
+}
+
+void FKCHandler_ExtraSwitchDispatch::Compile(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+    UK2Node_Switch* SwitchNode = CastChecked<UK2Node_Switch>(Node);
+
+    FEdGraphPinType ExpectedExecPinType;
+    ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+    // Make sure that the input pin is connected and valid for this block
+    UEdGraphPin* ExecTriggeringPin = Context.FindRequiredPinByName(SwitchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+    if (ExecTriggeringPin == nullptr || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+    {
+        CompilerContext.MessageLog.Error(*INVTEXT("@@ must have a valid execution pin @@").ToString(), SwitchNode, ExecTriggeringPin);
+        return;
+    }
+
+    UEdGraphPin* SelectionPin = SwitchNode->GetSelectionPin();
+    FBPTerminal* SelectionTerm = SelectionPin ? Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin)) : nullptr;
+    FBPTerminal* IndexTerm = IndexTermMap.FindRef(SwitchNode);
+    if (SelectionTerm == nullptr || IndexTerm == nullptr || BoolTermMap.FindRef(SwitchNode) == nullptr)
+    {
+        CompilerContext.MessageLog.Error(*INVTEXT("Failed to resolve term passed into @@").ToString(), SelectionPin);
+        return;
+    }
+
+    // The resolve and compare functions live next to the node's comparator, so the function pin provides their context just like it does for FKCHandler_Switch
+    const EExtraSwitchMatchMode MatchMode = GetMatchMode(SwitchNode);
+    UEdGraphPin* FuncPin = SwitchNode->GetFunctionPin();
+    UClass* FuncClass = UExtraSwitchComparatorsFunctionLibrary::StaticClass();
+    FDispatchTerms Terms;
+    Terms.FuncContext = Context.NetMap.FindRef(FuncPin);
+    Terms.SelectionTerm = SelectionTerm;
+    Terms.CompareFunction = FuncClass->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, IsCaseIndexBelow));
+    Terms.ResolveNextFunction = MatchMode == EExtraSwitchMatchMode::AllMatches ? FuncClass->FindFunctionByName(GetResolveNextFunctionName(SwitchNode)) : nullptr;
+    FBPTerminal* CaseSlotTerm = CaseSlotTermMap.FindRef(SwitchNode);
+    UFunction* ResolveFunction = FuncClass->FindFunctionByName(CaseSlotTerm ? GetResolveWithSlotFunctionName(SwitchNode) : GetResolveFunctionName(SwitchNode));
+    if (ResolveFunction == nullptr || Terms.CompareFunction == nullptr || (MatchMode == EExtraSwitchMatchMode::AllMatches && Terms.ResolveNextFunction == nullptr))
+    {
+        CompilerContext.MessageLog.Error(*INVTEXT("@@ could not find its case dispatch function").ToString(), SwitchNode);
+        return;
+    }
+
+    // Map every case index to its pin, INDEX_NONE goes to the default pin
+    UEdGraphPin* DefaultPin = SwitchNode->GetDefaultPin();
+    TMap<int32, UEdGraphPin*> CasePins;
+    const int32 LastCaseIndex = CollectCasePins(SwitchNode, CasePins);
+
+    // Bake the case values, the table is outered to the generated class so it is saved and cooked along with the bytecode that references it.
+    // A constant selection only needs the table while compiling, so it stays transient unless the selection turns out not to parse
+    FString ConstantSelection;
+    const bool bConstantSelection = FindConstantSelection(Context, SwitchNode, SelectionTerm, ConstantSelection);
+    const TArray<UK2Node_Switch*> FusedSwitches = (bConstantSelection || CaseSlotTerm) ? TArray<UK2Node_Switch*>() : FindFusedSwitches(SwitchNode);
+    const FName TableName = MakeUniqueObjectName(CompilerContext.NewClass, UExtraSwitchCaseTable::StaticClass(),
+        *FString::Printf(FusedSwitches.Num() > 0 ? TEXT("%s_FusedCaseTable") : TEXT("%s_CaseTable"), *SwitchNode->GetName()));
+    UExtraSwitchCaseTable* Table = bConstantSelection
+        ? NewObject<UExtraSwitchCaseTable>(GetTransientPackage(), NAME_None, RF_Transient)
+        : NewObject<UExtraSwitchCaseTable>(CompilerContext.NewClass, TableName);
+
+    if (bConstantSelection)
+    {
+        BuildCaseTable(SwitchNode, Table);
+
+        TArray<int32> MatchingCases;
+        const bool bEvaluated = EvaluateConstantSelection(SwitchNode, FuncClass->FindFunctionByName(GetResolveFunctionName(SwitchNode)), ConstantSelection, *Table, MatchingCases);
+        if (bEvaluated)
+        {
+            CompileConstantSelection(Context, SwitchNode, MatchingCases, CasePins);
+            return;
+        }
+
+        Table->Rename(*TableName.ToString(), CompilerContext.NewClass, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+        Table->ClearFlags(RF_Transient);
+    }
+
+    // Cases the table never returns don't get a leaf, the index range of the previous case simply grows over them
+    TBitArray<> Reachable;
+    if (FusedSwitches.Num() > 0)
+    {
+        // The pins of every fused switch become outcomes of this node and one call resolves the whole chain
+        EExtraSwitchFusedLookup FusedLookup = EExtraSwitchFusedLookup::IntArray;
+        GetFusedLookup(SwitchNode, FusedLookup);
+        ResolveFunction = FuncClass->FindFunctionByName(ExtraSwitchFusion::IsFloatLookup(FusedLookup)
+            ? GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFusedFloatCaseIndex)
+            : GET_FUNCTION_NAME_CHECKED(UExtraSwitchComparatorsFunctionLibrary, FindFusedIntCaseIndex));
+        if (ResolveFunction == nullptr)
+        {
+            CompilerContext.MessageLog.Error(*INVTEXT("@@ could not find its case dispatch function").ToString(), SwitchNode);
+            return;
+        }
+        BuildFusedTable(SwitchNode, FusedSwitches, Table, CasePins, Reachable);
+    }
+    else
+    {
+        if (!bConstantSelection)
+        {
+            BuildCaseTable(SwitchNode, Table);
+        }
+        Reachable.Init(true, LastCaseIndex + 1);
+        GetReachableCases(SwitchNode, Table, Reachable);
+    }
+
+    FBPTerminal* TableTerm = new FBPTerminal();
+    Context.Literals.Add(TableTerm);
+    TableTerm->Name = Table->GetName();
+    TableTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+    TableTerm->Type.PinSubCategoryObject = UExtraSwitchCaseTable::StaticClass();
+    TableTerm->ObjectLiteral = Table;
+    TableTerm->Source = SwitchNode;
+    TableTerm->bIsLiteral = true;
+    Terms.TableTerm = TableTerm;
+
+    if (MatchMode == EExtraSwitchMatchMode::AllMatches)
+    {
+        CompileAllMatches(Context, SwitchNode, Terms, CasePins, Reachable);
+        return;
+    }
+
+    // Resolve the selection to a case index with a single call
+    FBlueprintCompiledStatement& ResolveStatement = Context.AppendStatementForNode(SwitchNode);
+    ResolveStatement.Type = KCST_CallFunction;
+    ResolveStatement.FunctionToCall = ResolveFunction;
+    ResolveStatement.FunctionContext = Terms.FuncContext;
+    ResolveStatement.bIsParentContext = false;
+    ResolveStatement.LHS = IndexTerm;
+    ResolveStatement.RHS.Add(SelectionTerm);
+    ResolveStatement.RHS.Add(TableTerm);
+    if (CaseSlotTerm)
+    {
+        ResolveStatement.RHS.Add(CaseSlotTerm);
+    }
+
+    // Consecutive case indices that lead to the same place share a single leaf of the dispatch tree
+    auto GetJumpTarget = [](const UEdGraphPin* Pin) -> const UEdGraphPin*
+    {
+        return (Pin && Pin->LinkedTo.Num() > 0) ? Pin->LinkedTo[0] : nullptr;
+    };
+
+    TArray<FCaseSegment> Segments;
+    for (int32 CaseIndex = INDEX_NONE; CaseIndex < Reachable.Num(); ++CaseIndex)
+    {
+        if (CaseIndex != INDEX_NONE && !Reachable[CaseIndex])
+        {
+            continue;
+        }
+
+        UEdGraphPin* Pin = CaseIndex == INDEX_NONE ? DefaultPin : CasePins.FindRef(CaseIndex);
+        if (Segments.Num() == 0 || GetJumpTarget(Segments.Last().TargetPin) != GetJumpTarget(Pin))
+        {
+            Segments.Add({ CaseIndex, Pin });
+        }
+    }
+
+    EmitSegmentTree(Context, SwitchNode, Terms, Segments, 0, Segments.Num(), [this, &Context, SwitchNode](const FCaseSegment& Segment)
+    {
+        GenerateSimpleThenGoto(Context, *SwitchNode, Segment.TargetPin);
+    });
+}
+
+void FKCHandler_ExtraSwitchDispatch::CompileAllMatches(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, const FDispatchTerms& Terms,
+    const TMap<int32, UEdGraphPin*>& CasePins, const TBitArray<>& Reachable)
+{
+    FBPTerminal* IndexTerm = IndexTermMap.FindChecked(SwitchNode);
+    FBPTerminal* SelectionCopyTerm = SelectionCopyTermMap.FindRef(SwitchNode);
+    if (SelectionCopyTerm == nullptr)
+    {
+        CompilerContext.MessageLog.Error(*INVTEXT("Failed to resolve term passed into @@").ToString(), SwitchNode->GetSelectionPin());
+        return;
+    }
+
+    FBlueprintCompiledStatement& CopyStatement = Context.AppendStatementForNode(SwitchNode);
+    CopyStatement.Type = KCST_Assignment;
+    CopyStatement.LHS = SelectionCopyTerm;
+    CopyStatement.RHS.Add(Terms.SelectionTerm);
+
+    auto EmitResolveNext = [&](int32 StartIndex) -> FBlueprintCompiledStatement&
+    {
+        FBlueprintCompiledStatement& ResolveStatement = Context.AppendStatementForNode(SwitchNode);
+        ResolveStatement.Type = KCST_CallFunction;
+        ResolveStatement.FunctionToCall = Terms.ResolveNextFunction;
+        ResolveStatement.FunctionContext = Terms.FuncContext;
+        ResolveStatement.bIsParentContext = false;
+        ResolveStatement.LHS = IndexTerm;
+        ResolveStatement.RHS.Add(SelectionCopyTerm);
+        ResolveStatement.RHS.Add(Terms.TableTerm);
+        ResolveStatement.RHS.Add(MakeIntLiteral(Context, SwitchNode, StartIndex));
+        return ResolveStatement;
+    };
+
+    // The default pin only runs when nothing matched at all
+    EmitResolveNext(0);
+
+    FBPTerminal* BoolTerm = BoolTermMap.FindChecked(SwitchNode);
+    FBlueprintCompiledStatement& CompareStatement = Context.AppendStatementForNode(SwitchNode);
+    CompareStatement.Type = KCST_CallFunction;
+    CompareStatement.FunctionToCall = Terms.CompareFunction;
+    CompareStatement.FunctionContext = Terms.FuncContext;
+    CompareStatement.bIsParentContext = false;
+    CompareStatement.LHS = BoolTerm;
+    CompareStatement.RHS.Add(IndexTerm);
+    CompareStatement.RHS.Add(MakeIntLiteral(Context, SwitchNode, 0));
+
+    FBlueprintCompiledStatement& GotoMatches = Context.AppendStatementForNode(SwitchNode);
+    GotoMatches.Type = KCST_GotoIfNot;
+    GotoMatches.LHS = BoolTerm;
+
+    GenerateSimpleThenGoto(Context, *SwitchNode, SwitchNode->GetDefaultPin());
+
+    // Every case gets its own leaf since each one resumes the search from a different index, running out of matches ends the thread
+    TArray<FCaseSegment> Segments;
+    for (int32 CaseIndex = INDEX_NONE; CaseIndex < Reachable.Num(); ++CaseIndex)
+    {
+        if (CaseIndex == INDEX_NONE || Reachable[CaseIndex])
+        {
+            Segments.Add({ CaseIndex, CaseIndex == INDEX_NONE ? nullptr : CasePins.FindRef(CaseIndex) });
+        }
+    }
+
+    const int32 TreeStart = Context.StatementsPerNode.FindChecked(SwitchNode).Num();
+    TArray<FBlueprintCompiledStatement*> GotoTreeStatements;
+    EmitSegmentTree(Context, SwitchNode, Terms, Segments, 0, Segments.Num(), [&](const FCaseSegment& Segment)
+    {
+        if (Segment.FirstCaseIndex == INDEX_NONE)
+        {
+            FBlueprintCompiledStatement& EndThread = Context.AppendStatementForNode(SwitchNode);
+            EndThread.Type = KCST_EndOfThread;
+            return;
+        }
+
+        // Run the pin like a Sequence output, the thread comes back to the next search once the pin's chain ends
+        FBlueprintCompiledStatement* PushState = nullptr;
+        if (Segment.TargetPin && Segment.TargetPin->LinkedTo.Num() > 0)
+        {
+            PushState = &Context.AppendStatementForNode(SwitchNode);
+            PushState->Type = KCST_PushState;
+            GenerateSimpleThenGoto(Context, *SwitchNode, Segment.TargetPin);
+        }
+
+        FBlueprintCompiledStatement& ResolveNext = EmitResolveNext(Segment.FirstCaseIndex + 1);
+        if (PushState)
+        {
+            ResolveNext.bIsJumpTarget = true;
+            PushState->TargetLabel = &ResolveNext;
+        }
+
+        FBlueprintCompiledStatement& GotoTree = Context.AppendStatementForNode(SwitchNode);
+        GotoTree.Type = KCST_UnconditionalGoto;
+        GotoTreeStatements.Add(&GotoTree);
+    });
+
+    FBlueprintCompiledStatement* TreeLabel = Context.StatementsPerNode.FindChecked(SwitchNode)[TreeStart];
+    TreeLabel->bIsJumpTarget = true;
+    GotoMatches.TargetLabel = TreeLabel;
+    for (FBlueprintCompiledStatement* GotoTree : GotoTreeStatements)
+    {
+        GotoTree->TargetLabel = TreeLabel;
+    }
+}
+
+void FKCHandler_ExtraSwitchDispatch::EmitSegmentTree(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, const FDispatchTerms& Terms,
+    const TArray<FCaseSegment>& Segments, int32 Begin, int32 End, TFunctionRef<void(const FCaseSegment&)> EmitLeaf)
+{
+    if (End - Begin == 1)
+    {
+        EmitLeaf(Segments[Begin]);
+        return;
+    }
+
+    const int32 Mid = (Begin + End) / 2;
+
+    FBPTerminal* BoolTerm = BoolTermMap.FindChecked(SwitchNode);
+
+    FBlueprintCompiledStatement& CompareStatement = Context.AppendStatementForNode(SwitchNode);
+    CompareStatement.Type = KCST_CallFunction;
+    CompareStatement.FunctionToCall = Terms.CompareFunction;
+    CompareStatement.FunctionContext = Terms.FuncContext;
+    CompareStatement.bIsParentContext = false;
+    CompareStatement.LHS = BoolTerm;
+    CompareStatement.RHS.Add(IndexTermMap.FindChecked(SwitchNode));
+    CompareStatement.RHS.Add(MakeIntLiteral(Context, SwitchNode, Segments[Mid].FirstCaseIndex));
+
+    // Index below the bound falls through to the lower half, otherwise jump to the upper half
+    FBlueprintCompiledStatement& GotoUpperHalf = Context.AppendStatementForNode(SwitchNode);
+    GotoUpperHalf.Type = KCST_GotoIfNot;
+    GotoUpperHalf.LHS = BoolTerm;
+
+    EmitSegmentTree(Context, SwitchNode, Terms, Segments, Begin, Mid, EmitLeaf);
+
+    const int32 UpperHalfStart = Context.StatementsPerNode.FindChecked(SwitchNode).Num();
+    EmitSegmentTree(Context, SwitchNode, Terms, Segments, Mid, End, EmitLeaf);
+
+    FBlueprintCompiledStatement* UpperHalfLabel = Context.StatementsPerNode.FindChecked(SwitchNode)[UpperHalfStart];
+    UpperHalfLabel->bIsJumpTarget = true;
+    GotoUpperHalf.TargetLabel = UpperHalfLabel;
+}
+
+void FKCHandler_ExtraSwitchDispatch::CompileConstantSelection(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, TConstArrayView<int32> MatchingCases,
+    const TMap<int32, UEdGraphPin*>& CasePins)
+{
+    TArray<UEdGraphPin*> TargetPins;
+    for (const int32 CaseIndex : MatchingCases)
+    {
+        TargetPins.Add(CasePins.FindRef(CaseIndex));
+    }
+    if (MatchingCases.Num() == 0)
+    {
+        TargetPins.Add(SwitchNode->GetDefaultPin());
+    }
+    TargetPins.RemoveAll([](const UEdGraphPin* Pin) { return Pin == nullptr || Pin->LinkedTo.Num() == 0; });
+
+    if (TargetPins.Num() == 0)
+    {
+        FBlueprintCompiledStatement& EndThread = Context.AppendStatementForNode(SwitchNode);
+        EndThread.Type = KCST_EndOfThread;
+        return;
+    }
+
+    // Every pin but the last comes back to the next one once its chain ends, like the outputs of a Sequence node
+    FBlueprintCompiledStatement* PendingPushState = nullptr;
+    for (int32 Index = 0; Index < TargetPins.Num(); ++Index)
+    {
+        CompilerContext.MessageLog.Note(*INVTEXT("@@ always runs @@, its selection is known at compile time").ToString(), SwitchNode, TargetPins[Index]);
+
+        const int32 FirstStatement = Context.StatementsPerNode.FindOrAdd(SwitchNode).Num();
+        FBlueprintCompiledStatement* PushState = nullptr;
+        if (Index < TargetPins.Num() - 1)
+        {
+            PushState = &Context.AppendStatementForNode(SwitchNode);
+            PushState->Type = KCST_PushState;
+        }
+
+        GenerateSimpleThenGoto(Context, *SwitchNode, TargetPins[Index]);
+
+        if (PendingPushState)
+        {
+            FBlueprintCompiledStatement* NextLabel = Context.StatementsPerNode.FindChecked(SwitchNode)[FirstStatement];
+            NextLabel->bIsJumpTarget = true;
+            PendingPushState->TargetLabel = NextLabel;
+        }
+        PendingPushState = PushState;
+    }
+}
+
+bool FKCHandler_ExtraSwitchDispatch::FindConstantSelection(FKismetFunctionContext& Context, const UK2Node_Switch* SwitchNode, const FBPTerminal* SelectionTerm, FString& OutValue) const
+{
+    // An unlinked selection pin compiles to a literal term holding the pin's default value
+    if (SelectionTerm->bIsLiteral)
+    {
+        OutValue = SelectionTerm->Name;
+        return true;
+    }
+
+    const UEdGraphPin* SelectionPin = SwitchNode->GetSelectionPin();
+    if (SelectionPin == nullptr || SelectionPin->LinkedTo.Num() != 1)
+    {
+        return false;
+    }
+
+    const UEdGraphPin* SourcePin = SelectionPin->LinkedTo[0];
+    if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(SourcePin->GetOwningNode()))
+    {
+        const UFunction* Function = CallNode->GetTargetFunction();
+        const UEdGraphPin* ValuePin = CallNode->FindPin(TEXT("Value"), EGPD_Input);
+        if (Function && Function->GetOwnerClass() == UKismetSystemLibrary::StaticClass() && Function->GetName().StartsWith(TEXT("MakeLiteral"))
+            && ValuePin && ValuePin->LinkedTo.Num() == 0 && ValuePin->PinType == SelectionPin->PinType)
+        {
+            OutValue = ValuePin->GetDefaultAsString();
+            return true;
+        }
+        return false;
+    }
+
+    // Member variables can be changed by instances and child blueprints, so only the function's own locals are ever constant
+    const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(SourcePin->GetOwningNode());
+    if (GetNode == nullptr || !GetNode->VariableReference.IsLocalScope() || Context.EntryPoint == nullptr || SourcePin->PinType != SelectionPin->PinType)
+    {
+        return false;
+    }
+
+    const FName VarName = GetNode->VariableReference.GetMemberName();
+    const FBPVariableDescription* LocalVariable = Context.EntryPoint->LocalVariables.FindByPredicate([VarName](const FBPVariableDescription& Variable)
+    {
+        return Variable.VarName == VarName;
+    });
+    if (LocalVariable == nullptr || !IsLocalVariableConstant(Context, VarName))
+    {
+        return false;
+    }
+
+    OutValue = LocalVariable->DefaultValue;
+    return true;
+}
+
+bool FKCHandler_ExtraSwitchDispatch::IsLocalVariableConstant(FKismetFunctionContext& Context, FName VarName) const
+{
+    for (UEdGraphNode* Node : Context.SourceGraph->Nodes)
+    {
+        UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node);
+        if (VariableNode == nullptr || !VariableNode->VariableReference.IsLocalScope() || VariableNode->VariableReference.GetMemberName() != VarName)
+        {
+            continue;
+        }
+
+        if (!VariableNode->IsA<UK2Node_VariableGet>())
+        {
+            // The function entry expands into setters for the local defaults, those only write the value the fold reads
+            if (!Cast<UK2Node_FunctionEntry>(CompilerContext.MessageLog.FindSourceObject(VariableNode)))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        for (const UEdGraphPin* Pin : VariableNode->Pins)
+        {
+            for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+            {
+                if (Pin->Direction == EGPD_Output && LinkedPin->PinType.bIsReference && !LinkedPin->PinType.bIsConst)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool FKCHandler_ExtraSwitchDispatch::EvaluateConstantSelection(const UK2Node_Switch* SwitchNode, const UFunction* ResolveFunction, const FString& SelectionValue,
+    const UExtraSwitchCaseTable& Table, TArray<int32>& OutMatchingCases) const
+{
+    // The selection is the first parameter of every resolve function, parsing it as that type converts it the way the emitted call would
+    const FProperty* SelectionProperty = nullptr;
+    for (TFieldIterator<FProperty> It(ResolveFunction); ResolveFunction && It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+    {
+        if (!It->HasAnyPropertyFlags(CPF_ReturnParm))
+        {
+            SelectionProperty = *It;
+            break;
+        }
+    }
+    if (SelectionProperty == nullptr)
+    {
+        return false;
+    }
+
+    uint8* Selection = (uint8*)FMemory_Alloca_Aligned(SelectionProperty->GetSize(), SelectionProperty->GetMinAlignment());
+    SelectionProperty->InitializeValue(Selection);
+
+    const bool bParsed = FBlueprintEditorUtils::PropertyValueFromString_Direct(SelectionProperty, SelectionValue, Selection);
+    if (bParsed)
+    {
+        const bool bAllMatches = GetMatchMode(SwitchNode) == EExtraSwitchMatchMode::AllMatches;
+        for (int32 CaseIndex = FindConstantCase(SwitchNode, Table, Selection, bAllMatches ? 0 : INDEX_NONE); CaseIndex != INDEX_NONE;
+            CaseIndex = FindConstantCase(SwitchNode, Table, Selection, CaseIndex + 1))
+        {
+            OutMatchingCases.Add(CaseIndex);
+            if (!bAllMatches)
+            {
+                break;
+            }
+        }
+    }
+
+    SelectionProperty->DestroyValue(Selection);
+    return bParsed;
+}
+
+void FKCHandler_ExtraSwitchDispatch::SetReachableCases(TConstArrayView<int32> CaseIndices, TBitArray<>& OutReachable)
+{
+    OutReachable.SetRange(0, OutReachable.Num(), false);
+    for (const int32 CaseIndex : CaseIndices)
+    {
+        if (OutReachable.IsValidIndex(CaseIndex))
+        {
+            OutReachable[CaseIndex] = true;
+        }
+    }
+}
+
+TArray<UK2Node_Switch*> FKCHandler_ExtraSwitchDispatch::FindFusedSwitches(UK2Node_Switch* SwitchNode) const
+{
+    EExtraSwitchFusedLookup Lookup;
+    const UEdGraphPin* SelectionPin = SwitchNode->GetSelectionPin();
+    if (!CreateFusableHandler(SwitchNode, Lookup) || SelectionPin == nullptr || SelectionPin->LinkedTo.Num() != 1
+        || !ExtraSwitchFusion::IsStableSelectionSource(SelectionPin->LinkedTo[0]))
+    {
+        return {};
+    }
+
+    const bool bFloatLookup = ExtraSwitchFusion::IsFloatLookup(Lookup);
+    TArray<UK2Node_Switch*> FusedSwitches = { SwitchNode };
+    for (int32 Index = 0; Index < FusedSwitches.Num(); ++Index)
+    {
+        for (const UEdGraphPin* Pin : FusedSwitches[Index]->Pins)
+        {
+            if (Pin->Direction != EGPD_Output || Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec || Pin->LinkedTo.Num() != 1
+                || Pin->LinkedTo[0]->PinName != UEdGraphSchema_K2::PN_Execute || FusedSwitches.Num() == ExtraSwitchFusion::MaxFusedSwitches)
+            {
+                continue;
+            }
+
+            UK2Node_Switch* NextSwitch = Cast<UK2Node_Switch>(Pin->LinkedTo[0]->GetOwningNode());
+            const UEdGraphPin* NextSelectionPin = NextSwitch ? NextSwitch->GetSelectionPin() : nullptr;
+            EExtraSwitchFusedLookup NextLookup;
+            if (NextSelectionPin && NextSelectionPin->LinkedTo.Num() == 1 && NextSelectionPin->PinType == SelectionPin->PinType
+                && !FusedSwitches.Contains(NextSwitch) && CreateFusableHandler(NextSwitch, NextLookup) && ExtraSwitchFusion::IsFloatLookup(NextLookup) == bFloatLookup
+                && ExtraSwitchFusion::IsSameSelectionSource(SelectionPin->LinkedTo[0], NextSelectionPin->LinkedTo[0]))
+            {
+                FusedSwitches.Add(NextSwitch);
+            }
+        }
+    }
+
+    if (FusedSwitches.Num() == 1)
+    {
+        return {};
+    }
+
+    for (int32 Index = 1; Index < FusedSwitches.Num(); ++Index)
+    {
+        CompilerContext.MessageLog.Note(*INVTEXT("@@ is resolved by the lookup of @@, they switch on the same selection").ToString(), FusedSwitches[Index], SwitchNode);
+    }
+    return FusedSwitches;
+}
+
+TUniquePtr<FKCHandler_ExtraSwitchDispatch> FKCHandler_ExtraSwitchDispatch::CreateFusableHandler(const UK2Node_Switch* Node, EExtraSwitchFusedLookup& OutLookup) const
+{
+    // The handler registered for another switch class can be anything, only the node can tell which handler it compiles with
+    const IExtraSwitchNode* ExtraSwitchNode = Cast<IExtraSwitchNode>(Node);
+    if (ExtraSwitchNode == nullptr)
+    {
+        return nullptr;
+    }
+
+    TUniquePtr<FKCHandler_ExtraSwitchDispatch> Handler(ExtraSwitchNode->CreateDispatchHandler(CompilerContext));
+    if (Handler == nullptr || Handler->GetMatchMode(Node) == EExtraSwitchMatchMode::AllMatches || !Handler->GetResolveWithSlotFunctionName(Node).IsNone()
+        || !Handler->GetFusedLookup(Node, OutLookup))
+    {
+        return nullptr;
+    }
+    return Handler;
+}
+
+void FKCHandler_ExtraSwitchDispatch::BuildFusedTable(UK2Node_Switch* SwitchNode, TConstArrayView<UK2Node_Switch*> FusedSwitches, UExtraSwitchCaseTable* Table,
+    TMap<int32, UEdGraphPin*>& OutCasePins, TBitArray<>& OutReachable) const
+{
+    // The level of a switch is its index in FusedSwitches
+    TArray<TMap<int32, UEdGraphPin*>> LevelPins;
+    TArray<TBitArray<>> LevelReachable;
+    for (int32 Level = 0; Level < FusedSwitches.Num(); ++Level)
+    {
+        const UK2Node_Switch* LevelNode = FusedSwitches[Level];
+        EExtraSwitchFusedLookup Lookup;
+        const TUniquePtr<FKCHandler_ExtraSwitchDispatch> LevelHandler = CreateFusableHandler(LevelNode, Lookup);
+        check(LevelHandler);
+
+        UExtraSwitchCaseTable* LevelTable = NewObject<UExtraSwitchCaseTable>(Table, *FString::Printf(TEXT("%s_Level%d"), *LevelNode->GetName(), Level));
+        LevelHandler->BuildCaseTable(LevelNode, LevelTable);
+
+        TMap<int32, UEdGraphPin*>& Pins = LevelPins.AddDefaulted_GetRef();
+        const int32 NumCases = CollectCasePins(LevelNode, Pins) + 1;
+        Pins.Add(INDEX_NONE, LevelNode->GetDefaultPin());
+        Table->AddFusedLevel(LevelTable, Lookup, NumCases);
+
+        TBitArray<>& Reachable = LevelReachable.Emplace_GetRef(true, NumCases);
+        LevelHandler->GetReachableCases(LevelNode, LevelTable, Reachable);
+    }
+
+    // A pin continues to a later level only, a pin leading back up the chain runs that switch again like it would without fusion
+    OutCasePins.Reset();
+    OutReachable.Init(false, Table->FusedNextLevels.Num() - 1);
+    for (int32 Level = 0; Level < FusedSwitches.Num(); ++Level)
+    {
+        for (const TPair<int32, UEdGraphPin*>& Pair : LevelPins[Level])
+        {
+            const UEdGraphPin* Pin = Pair.Value;
+            const int32 NextLevel = (Pin && Pin->LinkedTo.Num() == 1 && Pin->LinkedTo[0]->PinName == UEdGraphSchema_K2::PN_Execute)
+                ? FusedSwitches.IndexOfByKey(Cast<UK2Node_Switch>(Pin->LinkedTo[0]->GetOwningNode()))
+                : INDEX_NONE;
+            if (NextLevel > Level)
+            {
+                Table->SetFusedNextLevel(Level, Pair.Key, NextLevel);
+                continue;
+            }
+
+            const int32 Outcome = Table->GetFusedOutcome(Level, Pair.Key);
+            if (Outcome != INDEX_NONE)
+            {
+                OutCasePins.Add(Outcome, Pair.Value);
+                OutReachable[Outcome] = Pair.Key == INDEX_NONE || LevelReachable[Level][Pair.Key];
+            }
+        }
+    }
+}
+
+int32 FKCHandler_ExtraSwitchDispatch::CollectCasePins(const UK2Node_Switch* SwitchNode, TMap<int32, UEdGraphPin*>& CasePins)
+{
+    const UEdGraphPin* DefaultPin = SwitchNode->GetDefaultPin();
+    int32 LastCaseIndex = INDEX_NONE;
+    for (UEdGraphPin* Pin : SwitchNode->Pins)
+    {
+        if (Pin->Direction == EGPD_Output && Pin != DefaultPin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+        {
+            CasePins.Add(Pin->SourceIndex, Pin);
+            LastCaseIndex = FMath::Max(LastCaseIndex, Pin->SourceIndex);
+        }
+    }
+    return LastCaseIndex;
+}
+
+FBPTerminal* FKCHandler_ExtraSwitchDispatch::MakeIntLiteral(FKismetFunctionContext& Context, UEdGraphNode* Node, int32 Value) const
+{
+    FBPTerminal* LiteralTerm = new FBPTerminal();
+    Context.Literals.Add(LiteralTerm);
+    LiteralTerm->Name = FString::FromInt(Value);
+    LiteralTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+    LiteralTerm->Source = Node;
+    LiteralTerm->bIsLiteral = true;
+    return LiteralTerm;
+}
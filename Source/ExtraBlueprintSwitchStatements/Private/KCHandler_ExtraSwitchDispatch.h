@@ -0,0 +1,145 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KismetCompilerMisc.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+
+class UK2Node_Switch;
+class UExtraSwitchCaseTable;
+enum class EExtraSwitchFusedLookup : uint8;
+struct FBlueprintCompiledStatement;
+
+/**
+ * Node handler shared by the extra switch nodes.
+ * The stock FKCHandler_Switch calls the node's comparator and branches once per case pin, so every evaluation costs O(N) VM calls.
+ * This handler instead bakes the case values into a UExtraSwitchCaseTable, calls a single resolve function that returns the
+ * matching case index and then jumps to the case pin through a binary tree of index comparisons.
+ * Each node provides the resolve function and fills the table by subclassing this handler in its own cpp.
+ * In AllMatches mode the handler emits a loop instead: every matching pin runs in pin order like the outputs of a Sequence node,
+ * and a FindNext resolve function is called with the next case index after each pin finishes.
+ * Nodes that remember their last case per object get a persistent int in the event graph frame that is passed to their resolve function by reference.
+ * A selection that can't change at runtime is resolved while compiling and the node compiles to a plain jump to the resolved pin,
+ * and case pins the table can never return get no leaf in the dispatch tree.
+ * A switch whose case or default pin runs straight into another extra switch on the same selection resolves both with one call:
+ * the tables are fused into levels of a single table and the dispatch tree jumps to the pins of whichever switch decided.
+ */
+class FKCHandler_ExtraSwitchDispatch : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_ExtraSwitchDispatch(FKismetCompilerContext& InCompilerContext);
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override;
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override;
+
+protected:
+	// Name of the UExtraSwitchComparatorsFunctionLibrary function taking (Selection, Table) and returning the case index or INDEX_NONE
+	virtual FName GetResolveFunctionName(const UK2Node_Switch* SwitchNode) const = 0;
+
+	// Fills the freshly created table with the node's case values
+	virtual void BuildCaseTable(const UK2Node_Switch* SwitchNode, UExtraSwitchCaseTable* Table) const = 0;
+
+	// Nodes without a match mode always compile as FirstMatch
+	virtual EExtraSwitchMatchMode GetMatchMode(const UK2Node_Switch* SwitchNode) const { return EExtraSwitchMatchMode::FirstMatch; }
+
+	// Name of the function taking (Selection, Table, StartIndex) used in AllMatches mode, NAME_None if the node doesn't support it
+	virtual FName GetResolveNextFunctionName(const UK2Node_Switch* SwitchNode) const { return NAME_None; }
+
+	/**
+	 * Name of the function taking (Selection, Table, CaseSlot) that replaces the resolve function when the node keeps state per object, NAME_None if it doesn't.
+	 * CaseSlot is an int persisted in the event graph frame, so the state is only kept for nodes in the event graph and never in AllMatches mode.
+	 */
+	virtual FName GetResolveWithSlotFunctionName(const UK2Node_Switch* SwitchNode) const { return NAME_None; }
+
+	/**
+	 * Marks the case indices the built table can return, the pins of the other cases never run and no dispatch code is emitted for them.
+	 * OutReachable arrives with every case set, nodes that can't tell which of their cases are shadowed leave it as is.
+	 */
+	virtual void GetReachableCases(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable* Table, TBitArray<>& OutReachable) const {}
+
+	// Sets only the case indices listed in CaseIndices, for the tables that store the winning case of every value or region
+	static void SetReachableCases(TConstArrayView<int32> CaseIndices, TBitArray<>& OutReachable);
+
+	/**
+	 * Looks a selection known at compile time up in the built table with the table's own Find functions, so folding it never shows up in the stats or the profiler
+	 * @param Selection - Points to a value of the type of the first parameter of the resolve function
+	 * @param StartIndex - INDEX_NONE for the lookup of the resolve function, otherwise the first case index the FindNext lookup may return
+	 */
+	virtual int32 FindConstantCase(const UK2Node_Switch* SwitchNode, const UExtraSwitchCaseTable& Table, const void* Selection, int32 StartIndex) const = 0;
+
+	// The lookup the node's table runs as a level of a fused table, false for the nodes that can't be fused
+	virtual bool GetFusedLookup(const UK2Node_Switch* SwitchNode, EExtraSwitchFusedLookup& OutLookup) const { return false; }
+
+private:
+	// A run of consecutive case indices that all jump to the same place, FirstCaseIndex is INDEX_NONE for the default pin
+	struct FCaseSegment
+	{
+		int32 FirstCaseIndex;
+		UEdGraphPin* TargetPin;
+	};
+
+	// Terms and functions shared by every statement emitted for one node
+	struct FDispatchTerms
+	{
+		FBPTerminal* FuncContext;
+		FBPTerminal* SelectionTerm;
+		FBPTerminal* TableTerm;
+		UFunction* CompareFunction;
+		UFunction* ResolveNextFunction;
+	};
+
+	/**
+	 * Finds the value of a selection that can't change at runtime: an unlinked pin, a Make Literal node with an unlinked value
+	 * or a local variable that the function only ever reads
+	 * @return True if OutValue holds the selection as pin default text
+	 */
+	bool FindConstantSelection(FKismetFunctionContext& Context, const UK2Node_Switch* SwitchNode, const FBPTerminal* SelectionTerm, FString& OutValue) const;
+
+	// True if nothing in the function writes the local variable or takes it by reference, apart from the function entry setting its default
+	bool IsLocalVariableConstant(FKismetFunctionContext& Context, FName VarName) const;
+
+	/**
+	 * Parses the constant selection as the selection parameter of the resolve function and collects the cases the bytecode would run,
+	 * AllMatches walks every match like the FindNext loop does
+	 * @return False if the selection text couldn't be parsed
+	 */
+	bool EvaluateConstantSelection(const UK2Node_Switch* SwitchNode, const UFunction* ResolveFunction, const FString& SelectionValue, const UExtraSwitchCaseTable& Table,
+		TArray<int32>& OutMatchingCases) const;
+
+	// Jumps straight to the pins of MatchingCases, in AllMatches mode they run in order like the outputs of a Sequence node
+	void CompileConstantSelection(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, TConstArrayView<int32> MatchingCases, const TMap<int32, UEdGraphPin*>& CasePins);
+
+	/**
+	 * Collects the switches that run right after a pin of SwitchNode, or of a switch collected before them, and look up the same selection
+	 * @return The switches in level order with SwitchNode first, empty when there is nothing to fuse
+	 */
+	TArray<UK2Node_Switch*> FindFusedSwitches(UK2Node_Switch* SwitchNode) const;
+
+	// A fresh handler of an extra switch node that can be a level of a fused table, nullptr for AllMatches, stateful and other nodes
+	TUniquePtr<FKCHandler_ExtraSwitchDispatch> CreateFusableHandler(const UK2Node_Switch* Node, EExtraSwitchFusedLookup& OutLookup) const;
+
+	/**
+	 * Fills Table with a level per switch, the outcomes of a level continue to the switch their pin runs into
+	 * @param OutCasePins - The pin every outcome that ends the lookup runs, INDEX_NONE stays the default pin of SwitchNode
+	 * @param OutReachable - The outcomes the table can return
+	 */
+	void BuildFusedTable(UK2Node_Switch* SwitchNode, TConstArrayView<UK2Node_Switch*> FusedSwitches, UExtraSwitchCaseTable* Table,
+		TMap<int32, UEdGraphPin*>& OutCasePins, TBitArray<>& OutReachable) const;
+
+	// Fills CasePins with the case pins by case index and returns the highest one, INDEX_NONE without cases
+	static int32 CollectCasePins(const UK2Node_Switch* SwitchNode, TMap<int32, UEdGraphPin*>& CasePins);
+
+	void CompileAllMatches(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, const FDispatchTerms& Terms, const TMap<int32, UEdGraphPin*>& CasePins, const TBitArray<>& Reachable);
+
+	// Emits the binary search over Segments, EmitLeaf is called once per segment with the index term holding one of its case indices
+	void EmitSegmentTree(FKismetFunctionContext& Context, UK2Node_Switch* SwitchNode, const FDispatchTerms& Terms,
+		const TArray<FCaseSegment>& Segments, int32 Begin, int32 End, TFunctionRef<void(const FCaseSegment&)> EmitLeaf);
+
+	FBPTerminal* MakeIntLiteral(FKismetFunctionContext& Context, UEdGraphNode* Node, int32 Value) const;
+
+	TMap<UEdGraphNode*, FBPTerminal*> IndexTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> SelectionCopyTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> CaseSlotTermMap;
+};
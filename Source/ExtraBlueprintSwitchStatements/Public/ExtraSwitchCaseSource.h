@@ -0,0 +1,54 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/DataTable.h"
+#include "Curves/CurveFloat.h"
+#include "ExtraSwitchCaseSource.generated.h"
+
+UENUM()
+enum class EExtraSwitchCaseSourceType : uint8
+{
+	// The cases are edited on the node
+	None,
+	// One case per row of a data table, the columns are the row struct's properties
+	DataTable,
+	// One case per line of a CSV file, the first line names the columns
+	CsvFile,
+	// One case per key of a float curve, the columns are Time, NextTime and Value
+	CurveKeys,
+};
+
+/**
+ * Where a switch node reads its cases from when they are kept outside the blueprint.
+ * The cases are read again whenever the source changes and before every compile, so PinValues always mirrors the source while one is set.
+ */
+USTRUCT()
+struct EXTRABLUEPRINTSWITCHSTATEMENTS_API FExtraSwitchCaseSource
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = CaseSource)
+	EExtraSwitchCaseSourceType Type = EExtraSwitchCaseSourceType::None;
+
+	UPROPERTY(EditAnywhere, Category = CaseSource, meta = (EditCondition = "Type == EExtraSwitchCaseSourceType::DataTable", EditConditionHides))
+	TSoftObjectPtr<UDataTable> DataTable;
+
+	UPROPERTY(EditAnywhere, Category = CaseSource, meta = (EditCondition = "Type == EExtraSwitchCaseSourceType::CsvFile", EditConditionHides, FilePathFilter = "csv", RelativeToGameDir))
+	FFilePath CsvFile;
+
+	UPROPERTY(EditAnywhere, Category = CaseSource, meta = (EditCondition = "Type == EExtraSwitchCaseSourceType::CurveKeys", EditConditionHides))
+	TSoftObjectPtr<UCurveFloat> Curve;
+
+	//The columns holding the case fields in the order the node reads them, e.g. RangeMin, RangeMax and Inclusive for a range.
+	//Empty reads the fields every case needs from the first columns, a curve then gives Time for a value and Time to NextTime for a range
+	UPROPERTY(EditAnywhere, Category = CaseSource, meta = (EditCondition = "Type != EExtraSwitchCaseSourceType::None", EditConditionHides))
+	TArray<FName> Columns;
+
+	bool IsSet() const { return Type != EExtraSwitchCaseSourceType::None; }
+
+	// The asset path or the absolute file path of the source, empty when none is set
+	FString GetSourcePath() const;
+};
@@ -0,0 +1,30 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "ExtraSwitchNode.generated.h"
+
+class FKCHandler_ExtraSwitchDispatch;
+class FKismetCompilerContext;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UExtraSwitchNode : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by every switch node that compiles through FKCHandler_ExtraSwitchDispatch.
+ * Other UK2Node_Switch subclasses can register any handler, so the handler of another node is only treated as a dispatch handler
+ * when the node itself says it compiles with one.
+ */
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API IExtraSwitchNode
+{
+	GENERATED_BODY()
+
+public:
+	// Creates the handler the node compiles with, the caller owns it. CreateNodeHandler returns the same handler
+	virtual FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(FKismetCompilerContext& CompilerContext) const = 0;
+};
@@ -0,0 +1,79 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "K2Node_SwitchOnBitmask.generated.h"
+
+
+/**
+ * Switch on flag values, every case is a mask tested with Any, All or Exact.
+ * The masks are folded into one packed table when the blueprint compiles, so every case is tested in a single native pass
+ * instead of one comparator call per pin
+ */
+UCLASS()
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnBitmask : public UK2Node_Switch, public IExtraSwitchNode
+{
+	GENERATED_BODY()
+
+
+public:
+	UPROPERTY()
+	TArray<FName> PinNames;
+
+	//This is the array that will hold the masks and tests for the pins, when the array is changed we will update the pins
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	TArray<FExtraSwitchBitmaskCase> PinValues;
+
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the case testing the most flags (Exact cases first)
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	UK2Node_SwitchOnBitmask();
+
+	//this method is used to register the node in the blueprint editor
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+
+	//as we want to display the details view for the node we need to override this function and return true
+	virtual bool ShouldShowNodeProperties() const override { return true; }
+
+	FText GetTooltipText() const override;
+
+	//K2Node_Switch Interface
+
+
+	virtual void CreateSelectionPin() override;
+
+	virtual FName GetPinNameGivenIndex(int32 Index) const override;
+	virtual FEdGraphPinType GetInnerCaseType() const override;
+	virtual FEdGraphPinType GetPinType() const override;
+
+	//the pin SourceIndex is the index into PinValues, the case table uses the same indices
+	virtual void CreateCasePins() override;
+	virtual FName GetUniquePinName() override;
+
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
+	//Only used if the node is compiled through the stock FKCHandler_Switch
+	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
+
+	virtual bool SupportsAddPinButton() const { return false; }
+	//End of K2Node_Switch Interface
+
+	//Compiles the node into a single packed mask test instead of one IsBitmaskNotMatching call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+
+	// Add validation during compilation
+	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
+};
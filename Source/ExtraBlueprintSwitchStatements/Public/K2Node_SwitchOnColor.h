@@ -5,7 +5,9 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnColor.generated.h"
 
 
@@ -22,7 +24,7 @@ class EXTRABLUEPRINTSWITCHSTATEMENTS_API USwitchOnColorGraphSchema : public	UEdG
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnColor : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnColor : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -36,17 +38,42 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<FLinearColor> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
 	//The tolerance value for the comparison, passing this to the comparison function is a little tricky, we effectively tack it on to the
 	// case switch vector data in the form of a struct, this is done in the GetExportTextForPin function
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	float Distance = 0.01f;
 
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the nearest color
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	//The order the First Match lookup tests the cases in, hottest first. Set by the Order Case Tests by Recorded Hits context action, empty means pin order
+	UPROPERTY()
+	TArray<int32> CaseTestOrder;
+
+	//Every object remembers the case this node executed last and tests it first, one distance check instead of a full search while the selection stays put.
+	//Only used in the event graph and when no value is within tolerance of two cases, otherwise the node searches every time
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
+	//The space the colors are compared in, Distance is measured there. The case colors are converted when the blueprint compiles and the selection once per evaluation.
+	//HSV reads both sides as HSV like the node always did without alpha, Oklab and CIELAB match by how different the colors look
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchColorSpace ComparisonSpace = EExtraSwitchColorSpace::HSV;
+
+	//Superseded by ComparisonSpace, kept in step with it (true for LinearRGBA) so nodes saved before it existed load with the same comparison
 	UPROPERTY()
 	bool UseAlpha = false;
 
 
 	UK2Node_SwitchOnColor();
 
+	virtual void PostLoad() override;
+
 	void SetupUseAlpha();
 
 	//this method is used to register the node in the blueprint editor
@@ -75,6 +102,9 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
@@ -82,5 +112,19 @@ public:
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single 4-wide squared distance search over the packed case colors instead of one comparator call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	//True when no selection can be within tolerance of two cases, only then can the cases be tested in a different order without changing the result
+	bool AreCasesDisjoint() const;
+
+	//True when the last case can be cached without changing which pin executes, the cases are disjoint and only one of them runs
+	bool CanCacheLastCase() const;
+
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
+	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
 };
\ No newline at end of file
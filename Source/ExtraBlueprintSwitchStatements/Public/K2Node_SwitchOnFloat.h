@@ -5,14 +5,16 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnFloat.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnFloat : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnFloat : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -25,10 +27,27 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<float> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
 	//The tolerance value for float comparison
 	UPROPERTY(EditAnywhere, Category = Tolerance)
 	float Tolerance = 0.1f;
 
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the nearest value
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	//The order the First Match lookup tests the cases in, hottest first. Set by the Order Case Tests by Recorded Hits context action, empty means pin order
+	UPROPERTY()
+	TArray<int32> CaseTestOrder;
+
+	//Every object remembers the case this node executed last and tests it first, one distance check instead of a full search while the selection stays put.
+	//Only used in the event graph and when no value is within tolerance of two cases, otherwise the node searches every time
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
 	UK2Node_SwitchOnFloat();
 
 	//this method is used to register the node in the blueprint editor
@@ -54,12 +73,29 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single 4-wide search over the packed case floats instead of one comparator call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
+	//True when no selection can be within tolerance of two cases, only then can the cases be tested in a different order without changing the result
+	bool AreCasesDisjoint() const;
+
+	//True when the last case can be cached without changing which pin executes, the cases are disjoint and only one of them runs
+	bool CanCacheLastCase() const;
+
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
+	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
+
 };
@@ -5,14 +5,16 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnFloatRanges.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnFloatRanges : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnFloatRanges : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -25,6 +27,28 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<FExtraSwitchFloatRange> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the narrowest range
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	//True when no value is contained by two ranges, the node then compiles to a single lookup in every match mode. Updated whenever the cases change
+	UPROPERTY(VisibleAnywhere, Transient, Category = PinOptions)
+	bool bCasesDisjoint = false;
+
+	//Every object remembers the case this node executed last and tests that range first, two compares instead of a search while the selection stays in it.
+	//Only used in the event graph and when the ranges are disjoint, hysteresis takes precedence when a margin is set
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
+	//When above 0 every object remembers the case this node executed last and only changes case once the selection is this far past a range boundary,
+	//so a value hovering on a boundary doesn't retrigger the pins every tick. Only kept in the event graph, ignored in AllMatches mode
+	UPROPERTY(EditAnywhere, Category = PinOptions, meta = (ClampMin = "0.0"))
+	float HysteresisMargin = 0.0f;
+
 	UK2Node_SwitchOnFloatRanges();
 
 	//this method is used to register the node in the blueprint editor
@@ -50,14 +74,29 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single binary search over the merged range boundaries instead of one comparator call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
 	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
 
+	//The mode the case table is built for, disjoint cases always compile as FirstMatch since every value matches at most one of them
+	EExtraSwitchMatchMode GetCompiledMatchMode() const;
+
+	//True when the last case can be cached without changing which pin executes, no value is contained by two ranges
+	bool CanCacheLastCase() const;
+
 };
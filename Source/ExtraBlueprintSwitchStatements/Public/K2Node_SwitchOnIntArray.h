@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
+#include "ExtraSwitchDispatch.h"
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnIntArray.generated.h"
 
 
@@ -12,7 +15,7 @@
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnIntArray : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnIntArray : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -25,6 +28,20 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<int> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
+	//The node compiles to a dense jump table (one bounds check and one array index) when its distinct values fill at least this share of the span between the lowest and highest value,
+	//sparser values use a binary search instead. 1 only allows contiguous values, 0 always builds the jump table up to 64K entries
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinJumpTableFill = TIntSetSwitch::DefaultMinDenseFill;
+
+	//Every object remembers the case this node executed last and compares the selection against it first, which skips the search while the selection stays put.
+	//Only used in the event graph
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
 	UK2Node_SwitchOnIntArray();
 
 	//this method is used to register the node in the blueprint editor
@@ -53,16 +70,25 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single jump table or sorted table lookup instead of one AreIntsNotEqual call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
 
 
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
 	// Add validation during compilation
 	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
 };
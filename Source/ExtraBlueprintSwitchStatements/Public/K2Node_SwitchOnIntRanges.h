@@ -7,7 +7,9 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnIntRanges.generated.h"
 
 
@@ -15,7 +17,7 @@
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnIntRanges : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnIntRanges : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -28,6 +30,23 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<FSwitchIntRange> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the narrowest range
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	//True when no value is contained by two ranges, the node then compiles to a single lookup in every match mode. Updated whenever the cases change
+	UPROPERTY(VisibleAnywhere, Transient, Category = PinOptions)
+	bool bCasesDisjoint = false;
+
+	//Every object remembers the case this node executed last and tests that range first, two compares instead of a search while the selection stays in it.
+	//Only used in the event graph and when the ranges are disjoint
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
 	UK2Node_SwitchOnIntRanges();
 
 	//this method is used to register the node in the blueprint editor
@@ -58,13 +77,28 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single binary search over the merged range boundaries instead of one comparator call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
 	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
+
+	//The mode the case table is built for, disjoint cases always compile as FirstMatch since every value matches at most one of them
+	EExtraSwitchMatchMode GetCompiledMatchMode() const;
+
+	//True when the last case can be cached without changing which pin executes, no value is contained by two ranges
+	bool CanCacheLastCase() const;
 };
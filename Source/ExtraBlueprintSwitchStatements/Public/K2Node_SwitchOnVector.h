@@ -5,14 +5,16 @@
 #include "CoreMinimal.h"
 #include "K2Node.h"
 #include "K2Node_Switch.h"
+#include "ExtraSwitchNode.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.h" // Include the function library to access FVectorAndTolerance
+#include "ExtraSwitchCaseSource.h"
 #include "K2Node_SwitchOnVector.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnVector : public UK2Node_Switch
+class EXTRABLUEPRINTSWITCHSTATEMENTS_API UK2Node_SwitchOnVector : public UK2Node_Switch, public IExtraSwitchNode
 {
 	GENERATED_BODY()
 
@@ -24,11 +26,34 @@ public:
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	TArray<FVector> PinValues;
 
+	//Reads the cases from a data table, CSV file or curve instead of the list above. They are read again whenever the source changes and before every compile
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	FExtraSwitchCaseSource CaseSource;
+
 	//The tolerance value for the comparison, passing this to the comparison function is a little tricky, we effectively tack it on to the
 	// case switch vector data in the form of a struct, this is done in the GetExportTextForPin function
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	float Tolerance = 0.1f;
 
+	//Which pins execute when several cases match, AllMatches runs every matching pin in order and BestMatch runs only the nearest vector,
+	//use BestMatch for large sets of case points (zone lookups etc.), the points are then compiled into a k-d tree and the lookup is O(log N)
+	UPROPERTY(EditAnywhere, Category = PinOptions)
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	//The order the First Match lookup tests the cases in, hottest first. Set by the Order Case Tests by Recorded Hits context action, empty means pin order
+	UPROPERTY()
+	TArray<int32> CaseTestOrder;
+
+	//Double measures exactly at any distance from the world origin, RebasedFloat measures in float from the center of the cases which searches
+	//twice as many cases per step and stays accurate while the cases are within a few km of each other, wherever they are in the world
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	EExtraSwitchVectorPrecision Precision = EExtraSwitchVectorPrecision::Double;
+
+	//Every object remembers the case this node executed last and tests it first, one distance check instead of a full search while the selection stays put.
+	//Only used in the event graph and when no value is within tolerance of two cases, otherwise the node searches every time
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = PinOptions)
+	bool bCacheLastCase = false;
+
 	// Array of additional literals to pass to the function (used for tolerance parameter)
 	TArray<FString> PinLiterals;
 
@@ -39,8 +64,8 @@ public:
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 
 	// Legacy function signature - maintained for backward compatibility only
-	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
-	static bool IsVectorWithToleranceNotNearlyEqual(FVector& A, FVectorAndTolerance& B);
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE", BlueprintThreadSafe))
+	static bool IsVectorWithToleranceNotNearlyEqual(const FVector& A, const FVectorAndTolerance& B);
 
 	//as we want to display the details view for the node we need to override this function and return true
 	virtual bool ShouldShowNodeProperties() const override { return true; }
@@ -64,6 +89,9 @@ public:
 	virtual void CreateCasePins() override;
 	virtual FName GetUniquePinName() override;
 
+	//Label of a case pin, used when the pins are created and when PostEditChangeProperty relabels them in place
+	FText GetCaseLabel(int32 CaseIndex) const;
+
 	//Generates the export text for the case pins, this is critical as the blueprint compiler uses this text to generate the structs that are used in the comparison function
 	FString GetExportTextForPin(const UEdGraphPin* InPin) const override;
 
@@ -71,8 +99,20 @@ public:
 	virtual bool SupportsAddPinButton() const { return false; }
 	//End of K2Node_Switch Interface
 
+	//Compiles the node into a single 4-wide squared distance search over the packed case vectors instead of one comparator call per case, see FKCHandler_ExtraSwitchDispatch
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual class FKCHandler_ExtraSwitchDispatch* CreateDispatchHandler(class FKismetCompilerContext& CompilerContext) const override;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
+	//True when no selection can be within tolerance of two cases, only then can the cases be tested in a different order without changing the result
+	bool AreCasesDisjoint() const;
+
+	//True when the last case can be cached without changing which pin executes, the cases are disjoint and only one of them runs
+	bool CanCacheLastCase() const;
+
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
 	// Additional validation during compilation, useful for debugging issues
 	virtual void ValidateNodeDuringCompilation(class FCompilerResultsLog& MessageLog) const override;
 
@@ -14,6 +14,7 @@ public class ExtraSwitchStatementsRuntime : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
+				"GameplayTags",
 			}
 		);
 		PublicIncludePaths.AddRange(new string[] { "Plugins/ExtraBlueprintSwitchStatements/Source/ExtraSwitchStatementsRuntime/Public" });
@@ -0,0 +1,439 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchDispatch.h"
+
+void UExtraSwitchCaseTable::BuildIntCases(TConstArrayView<int32> Values, float MinDenseFill)
+{
+    TIntSetSwitch::BuildTable(Values, IntValues, IntCaseIndices, bIntValuesDense, MinDenseFill);
+    IntCaseValues.Reset();
+    IntCaseValues.Append(Values);
+}
+
+int32 UExtraSwitchCaseTable::FindIntCase(int32 Value) const
+{
+    return TIntSetSwitch::FindInTable(Value, IntValues, IntCaseIndices, bIntValuesDense);
+}
+
+bool UExtraSwitchCaseTable::IsIntCase(int32 Value, int32 CaseIndex) const
+{
+    // Duplicates resolve to their lowest index, so a case FindIntCase returned is the only one for its value
+    return IntCaseValues.IsValidIndex(CaseIndex) && IntCaseValues[CaseIndex] == Value;
+}
+
+void UExtraSwitchCaseTable::BuildNameCases(TConstArrayView<FName> Values)
+{
+    THashSetSwitch<FName>::BuildTable(Values, NameCaseIndices);
+}
+
+int32 UExtraSwitchCaseTable::FindNameCase(FName Value) const
+{
+    return THashSetSwitch<FName>::FindInTable(Value, NameCaseIndices);
+}
+
+void UExtraSwitchCaseTable::BuildGameplayTagCases(TConstArrayView<FGameplayTag> Values, bool bMatchHierarchy)
+{
+    THashSetSwitch<FGameplayTag>::BuildTable(Values, GameplayTagCaseIndices);
+    bGameplayTagsMatchHierarchy = bMatchHierarchy;
+}
+
+int32 UExtraSwitchCaseTable::FindGameplayTagCase(const FGameplayTag& Value) const
+{
+    if (!bGameplayTagsMatchHierarchy)
+    {
+        return THashSetSwitch<FGameplayTag>::FindInTable(Value, GameplayTagCaseIndices);
+    }
+
+    // Every ancestor of the selection that is a case matches, the lowest case index among them is the one a MatchesTag chain would hit
+    int32 Result = INDEX_NONE;
+    for (FGameplayTag Tag = Value; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+    {
+        const int32 CaseIndex = THashSetSwitch<FGameplayTag>::FindInTable(Tag, GameplayTagCaseIndices);
+        if (CaseIndex != INDEX_NONE && (Result == INDEX_NONE || CaseIndex < Result))
+        {
+            Result = CaseIndex;
+        }
+    }
+    return Result;
+}
+
+void UExtraSwitchCaseTable::BuildBitmaskCases(TConstArrayView<FExtraSwitchBitmaskCase> Cases, EExtraSwitchMatchMode InMatchMode)
+{
+    const TArray<TBitmaskSwitch<uint32>::FCase> BitmaskCases = TBitmaskSwitch<uint32>::MakeCases(Cases);
+
+    MatchMode = InMatchMode;
+    TBitmaskSwitch<uint32>::BuildTable(BitmaskCases, BitmaskAndMasks, BitmaskExpected, BitmaskNegate, BitmaskSpecificity);
+}
+
+int32 UExtraSwitchCaseTable::FindBitmaskCase(uint32 Value) const
+{
+    if (MatchMode == EExtraSwitchMatchMode::BestMatch)
+    {
+        return TBitmaskSwitch<uint32>::FindBestInTable(Value, BitmaskAndMasks, BitmaskExpected, BitmaskNegate, BitmaskSpecificity);
+    }
+    return TBitmaskSwitch<uint32>::FindInTable(Value, BitmaskAndMasks, BitmaskExpected, BitmaskNegate);
+}
+
+int32 UExtraSwitchCaseTable::FindNextBitmaskCase(uint32 Value, int32 StartIndex) const
+{
+    return TBitmaskSwitch<uint32>::FindInTable(Value, BitmaskAndMasks, BitmaskExpected, BitmaskNegate, StartIndex);
+}
+
+namespace ExtraSwitchCaseTable
+{
+    template<typename T, typename RangeType>
+    void BuildRangeCases(TConstArrayView<RangeType> Ranges, EExtraSwitchMatchMode MatchMode, TArray<T>& OutBoundaries, TArray<int32>& OutRegionOffsets, TArray<int32>& OutRegionCases)
+    {
+        const TArray<typename TRangeSwitch<T>::FCase> Cases = TRangeSwitch<T>::MakeCases(Ranges);
+
+        if (MatchMode == EExtraSwitchMatchMode::AllMatches)
+        {
+            TRangeSwitch<T>::BuildAllMatchesTable(Cases, OutBoundaries, OutRegionOffsets, OutRegionCases);
+        }
+        else
+        {
+            OutRegionOffsets.Reset();
+            TRangeSwitch<T>::BuildTable(Cases, OutBoundaries, OutRegionCases, MatchMode == EExtraSwitchMatchMode::BestMatch);
+        }
+    }
+
+    template<typename T>
+    int32 FindRangeCase(T Value, int32 StartIndex, TConstArrayView<T> Boundaries, TConstArrayView<int32> RegionOffsets, TConstArrayView<int32> RegionCases)
+    {
+        if (RegionOffsets.Num() > 0)
+        {
+            return TRangeSwitch<T>::FindNextInTable(Value, StartIndex, Boundaries, RegionOffsets, RegionCases);
+        }
+
+        // Tables built for a single winner only know about that one case
+        const int32 CaseIndex = TRangeSwitch<T>::FindInTable(Value, Boundaries, RegionCases);
+        return CaseIndex >= StartIndex ? CaseIndex : INDEX_NONE;
+    }
+
+    template<typename T, typename FReal>
+    void BuildToleranceCases(TConstArrayView<T> Values, float Tolerance, EExtraSwitchMatchMode MatchMode, TConstArrayView<int32> ScanOrder,
+        TArray<FReal>& OutComponents, TArray<FReal>& OutTolerancesSquared, TArray<int32>& OutScanOrder, TArray<int32>& OutCaseSlots)
+    {
+        // The other modes rely on the slots being in case order, AllMatches steps through them and BestMatch breaks ties by index
+        OutScanOrder.Reset();
+        OutCaseSlots.Reset();
+        if (MatchMode == EExtraSwitchMatchMode::FirstMatch && ScanOrder.Num() == Values.Num())
+        {
+            OutScanOrder.Append(ScanOrder);
+            OutCaseSlots.SetNumUninitialized(ScanOrder.Num());
+            for (int32 Slot = 0; Slot < ScanOrder.Num(); ++Slot)
+            {
+                OutCaseSlots[ScanOrder[Slot]] = Slot;
+            }
+        }
+
+        TArray<float> Tolerances;
+        Tolerances.Init(Tolerance, Values.Num());
+        TToleranceSwitch<T, FReal>::BuildTable(Values, Tolerances, OutScanOrder, OutComponents, OutTolerancesSquared);
+    }
+
+    template<typename T, typename FReal>
+    int32 FindToleranceCase(const T& Value, EExtraSwitchMatchMode MatchMode, const TArray<FReal>& Components, const TArray<FReal>& TolerancesSquared, TConstArrayView<int32> ScanOrder)
+    {
+        if (MatchMode == EExtraSwitchMatchMode::BestMatch)
+        {
+            return TToleranceSwitch<T, FReal>::FindNearestInTable(Value, Components, TolerancesSquared);
+        }
+
+        const int32 Slot = TToleranceSwitch<T, FReal>::FindInTable(Value, Components, TolerancesSquared);
+        return (Slot != INDEX_NONE && ScanOrder.Num() > 0) ? ScanOrder[Slot] : Slot;
+    }
+
+    template<typename T, typename FReal>
+    bool IsToleranceCase(const T& Value, int32 CaseIndex, const TArray<FReal>& Components, const TArray<FReal>& TolerancesSquared, TConstArrayView<int32> CaseSlots)
+    {
+        if (CaseSlots.Num() > 0)
+        {
+            return CaseSlots.IsValidIndex(CaseIndex) && TToleranceSwitch<T, FReal>::IsWithinToleranceOfSlot(Value, Components, TolerancesSquared, CaseSlots[CaseIndex]);
+        }
+        return TToleranceSwitch<T, FReal>::IsWithinToleranceOfSlot(Value, Components, TolerancesSquared, CaseIndex);
+    }
+}
+
+void UExtraSwitchCaseTable::BuildIntRangeCases(TConstArrayView<FSwitchIntRange> Ranges, EExtraSwitchMatchMode InMatchMode)
+{
+    MatchMode = InMatchMode;
+    ExtraSwitchCaseTable::BuildRangeCases(Ranges, MatchMode, IntRangeBoundaries, IntRangeCaseOffsets, IntRangeCases);
+    IntRanges.Reset();
+    IntRanges.Append(Ranges);
+}
+
+int32 UExtraSwitchCaseTable::FindIntRangeCase(int32 Value) const
+{
+    return ExtraSwitchCaseTable::FindRangeCase<int32>(Value, 0, IntRangeBoundaries, IntRangeCaseOffsets, IntRangeCases);
+}
+
+int32 UExtraSwitchCaseTable::FindNextIntRangeCase(int32 Value, int32 StartIndex) const
+{
+    return ExtraSwitchCaseTable::FindRangeCase<int32>(Value, StartIndex, IntRangeBoundaries, IntRangeCaseOffsets, IntRangeCases);
+}
+
+bool UExtraSwitchCaseTable::IsIntRangeCase(int32 Value, int32 CaseIndex) const
+{
+    return IntRanges.IsValidIndex(CaseIndex)
+        && TRangeSwitch<int32>::Contains({ IntRanges[CaseIndex].RangeMin, IntRanges[CaseIndex].RangeMax, IntRanges[CaseIndex].Inclusive }, Value);
+}
+
+void UExtraSwitchCaseTable::BuildFloatRangeCases(TConstArrayView<FExtraSwitchFloatRange> Ranges, EExtraSwitchMatchMode InMatchMode)
+{
+    MatchMode = InMatchMode;
+    ExtraSwitchCaseTable::BuildRangeCases(Ranges, MatchMode, FloatRangeBoundaries, FloatRangeCaseOffsets, FloatRangeCases);
+    FloatRanges.Reset();
+    FloatRanges.Append(Ranges);
+}
+
+int32 UExtraSwitchCaseTable::FindFloatRangeCase(float Value) const
+{
+    return ExtraSwitchCaseTable::FindRangeCase<float>(Value, 0, FloatRangeBoundaries, FloatRangeCaseOffsets, FloatRangeCases);
+}
+
+int32 UExtraSwitchCaseTable::FindNextFloatRangeCase(float Value, int32 StartIndex) const
+{
+    return ExtraSwitchCaseTable::FindRangeCase<float>(Value, StartIndex, FloatRangeBoundaries, FloatRangeCaseOffsets, FloatRangeCases);
+}
+
+bool UExtraSwitchCaseTable::IsFloatRangeCase(float Value, int32 CaseIndex) const
+{
+    return FloatRanges.IsValidIndex(CaseIndex)
+        && TRangeSwitch<float>::Contains({ FloatRanges[CaseIndex].RangeMin, FloatRanges[CaseIndex].RangeMax, FloatRanges[CaseIndex].Inclusive }, Value);
+}
+
+void UExtraSwitchCaseTable::SetFloatRangeHysteresis(float Margin)
+{
+    FloatRangeHysteresis = FMath::Max(Margin, 0.0f);
+}
+
+int32 UExtraSwitchCaseTable::FindFloatRangeCaseWithHysteresis(float Value, int32 PreviousCase, bool bHasPrevious) const
+{
+    const bool bHasPreviousRange = bHasPrevious && FloatRanges.IsValidIndex(PreviousCase);
+    if (bHasPreviousRange)
+    {
+        const FExtraSwitchFloatRange& Range = FloatRanges[PreviousCase];
+        const TRangeSwitch<float>::FCase Widened = { Range.RangeMin - FloatRangeHysteresis, Range.RangeMax + FloatRangeHysteresis, Range.Inclusive };
+        if (Range.RangeMin <= Range.RangeMax && TRangeSwitch<float>::Contains(Widened, Value))
+        {
+            return PreviousCase;
+        }
+    }
+
+    const int32 CaseIndex = FindFloatRangeCase(Value);
+    if (!bHasPrevious || bHasPreviousRange || CaseIndex == INDEX_NONE || !FloatRanges.IsValidIndex(CaseIndex))
+    {
+        return CaseIndex;
+    }
+
+    // Coming from the default pin, the selection has to get Margin inside the range. Ranges narrower than twice the margin only need to be entered.
+    const FExtraSwitchFloatRange& Range = FloatRanges[CaseIndex];
+    const TRangeSwitch<float>::FCase Shrunk = { Range.RangeMin + FloatRangeHysteresis, Range.RangeMax - FloatRangeHysteresis, Range.Inclusive };
+    const bool bDeepEnough = Shrunk.Min > Shrunk.Max || TRangeSwitch<float>::Contains(Shrunk, Value);
+    return bDeepEnough ? CaseIndex : INDEX_NONE;
+}
+
+void UExtraSwitchCaseTable::BuildFloatCases(TConstArrayView<float> Values, float Tolerance, EExtraSwitchMatchMode InMatchMode, TConstArrayView<int32> ScanOrder)
+{
+    MatchMode = InMatchMode;
+    ExtraSwitchCaseTable::BuildToleranceCases<float>(Values, Tolerance, MatchMode, ScanOrder, FloatComponents, FloatTolerancesSquared, ToleranceScanOrder, ToleranceCaseSlots);
+}
+
+int32 UExtraSwitchCaseTable::FindFloatCase(float Value) const
+{
+    return ExtraSwitchCaseTable::FindToleranceCase(Value, MatchMode, FloatComponents, FloatTolerancesSquared, ToleranceScanOrder);
+}
+
+int32 UExtraSwitchCaseTable::FindNextFloatCase(float Value, int32 StartIndex) const
+{
+    return TToleranceSwitch<float>::FindInTable(Value, FloatComponents, FloatTolerancesSquared, StartIndex);
+}
+
+bool UExtraSwitchCaseTable::IsFloatCase(float Value, int32 CaseIndex) const
+{
+    return ExtraSwitchCaseTable::IsToleranceCase(Value, CaseIndex, FloatComponents, FloatTolerancesSquared, ToleranceCaseSlots);
+}
+
+void UExtraSwitchCaseTable::BuildVectorCases(TConstArrayView<FVector> Values, float Tolerance, EExtraSwitchMatchMode InMatchMode, TConstArrayView<int32> ScanOrder,
+    EExtraSwitchVectorPrecision InPrecision)
+{
+    MatchMode = InMatchMode;
+    VectorPrecision = InPrecision;
+
+    // Measured from the center of the cases so float planes only lose precision over the spread of the cases and not over the world
+    VectorOrigin = ExtraSwitch::GetCaseOrigin(Values);
+    TArray<FVector> Offsets;
+    Offsets.Reserve(Values.Num());
+    for (const FVector& Value : Values)
+    {
+        Offsets.Add(Value - VectorOrigin);
+    }
+
+    VectorComponents.Reset();
+    VectorTolerancesSquared.Reset();
+    VectorDoubleComponents.Reset();
+    VectorDoubleTolerancesSquared.Reset();
+    VectorTreePoints.Reset();
+    VectorDoubleTreePoints.Reset();
+    VectorTreeCaseIndices.Reset();
+    VectorTreeSplitAxes.Reset();
+    VectorTreeTolerance = Tolerance;
+
+    const bool bBuildTree = MatchMode == EExtraSwitchMatchMode::BestMatch && Values.Num() >= TNearestVectorSwitch<>::MinCasesForTree;
+    if (VectorPrecision == EExtraSwitchVectorPrecision::RebasedFloat)
+    {
+        ExtraSwitchCaseTable::BuildToleranceCases<FVector>(Offsets, Tolerance, MatchMode, ScanOrder, VectorComponents, VectorTolerancesSquared, ToleranceScanOrder, ToleranceCaseSlots);
+        if (bBuildTree)
+        {
+            TNearestVectorSwitch<float>::BuildTable(Offsets, VectorTreePoints, VectorTreeCaseIndices, VectorTreeSplitAxes);
+        }
+    }
+    else
+    {
+        ExtraSwitchCaseTable::BuildToleranceCases<FVector>(Offsets, Tolerance, MatchMode, ScanOrder, VectorDoubleComponents, VectorDoubleTolerancesSquared, ToleranceScanOrder, ToleranceCaseSlots);
+        if (bBuildTree)
+        {
+            TNearestVectorSwitch<double>::BuildTable(Offsets, VectorDoubleTreePoints, VectorTreeCaseIndices, VectorTreeSplitAxes);
+        }
+    }
+}
+
+int32 UExtraSwitchCaseTable::FindVectorCase(const FVector& Value) const
+{
+    const FVector Offset = Value - VectorOrigin;
+    if (VectorPrecision == EExtraSwitchVectorPrecision::RebasedFloat)
+    {
+        if (VectorTreePoints.Num() > 0)
+        {
+            return TNearestVectorSwitch<float>::FindInTable(Offset, TNearestVectorSwitch<float>::GetToleranceSquared(VectorTreeTolerance), VectorTreePoints, VectorTreeCaseIndices, VectorTreeSplitAxes);
+        }
+        return ExtraSwitchCaseTable::FindToleranceCase(Offset, MatchMode, VectorComponents, VectorTolerancesSquared, ToleranceScanOrder);
+    }
+
+    if (VectorDoubleTreePoints.Num() > 0)
+    {
+        return TNearestVectorSwitch<double>::FindInTable(Offset, TNearestVectorSwitch<double>::GetToleranceSquared(VectorTreeTolerance), VectorDoubleTreePoints, VectorTreeCaseIndices, VectorTreeSplitAxes);
+    }
+    return ExtraSwitchCaseTable::FindToleranceCase(Offset, MatchMode, VectorDoubleComponents, VectorDoubleTolerancesSquared, ToleranceScanOrder);
+}
+
+int32 UExtraSwitchCaseTable::FindNextVectorCase(const FVector& Value, int32 StartIndex) const
+{
+    const FVector Offset = Value - VectorOrigin;
+    return VectorPrecision == EExtraSwitchVectorPrecision::RebasedFloat
+        ? TToleranceSwitch<FVector>::FindInTable(Offset, VectorComponents, VectorTolerancesSquared, StartIndex)
+        : TToleranceSwitch<FVector, double>::FindInTable(Offset, VectorDoubleComponents, VectorDoubleTolerancesSquared, StartIndex);
+}
+
+bool UExtraSwitchCaseTable::IsVectorCase(const FVector& Value, int32 CaseIndex) const
+{
+    const FVector Offset = Value - VectorOrigin;
+    return VectorPrecision == EExtraSwitchVectorPrecision::RebasedFloat
+        ? ExtraSwitchCaseTable::IsToleranceCase(Offset, CaseIndex, VectorComponents, VectorTolerancesSquared, ToleranceCaseSlots)
+        : ExtraSwitchCaseTable::IsToleranceCase(Offset, CaseIndex, VectorDoubleComponents, VectorDoubleTolerancesSquared, ToleranceCaseSlots);
+}
+
+void UExtraSwitchCaseTable::BuildColorCases(TConstArrayView<FLinearColor> Values, float Tolerance, EExtraSwitchColorSpace InColorSpace, EExtraSwitchMatchMode InMatchMode,
+    TConstArrayView<int32> ScanOrder)
+{
+    TArray<FLinearColor> Centers;
+    Centers.Reserve(Values.Num());
+    for (const FLinearColor& Value : Values)
+    {
+        Centers.Add(UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(Value, InColorSpace));
+    }
+
+    MatchMode = InMatchMode;
+    ExtraSwitchCaseTable::BuildToleranceCases<FLinearColor>(Centers, Tolerance, MatchMode, ScanOrder, ColorComponents, ColorTolerancesSquared, ToleranceScanOrder, ToleranceCaseSlots);
+    ColorSpace = InColorSpace;
+}
+
+int32 UExtraSwitchCaseTable::FindColorCase(const FLinearColor& Value) const
+{
+    return ExtraSwitchCaseTable::FindToleranceCase(UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(Value, ColorSpace), MatchMode, ColorComponents, ColorTolerancesSquared, ToleranceScanOrder);
+}
+
+int32 UExtraSwitchCaseTable::FindNextColorCase(const FLinearColor& Value, int32 StartIndex) const
+{
+    return TToleranceSwitch<FLinearColor>::FindInTable(UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(Value, ColorSpace), ColorComponents, ColorTolerancesSquared, StartIndex);
+}
+
+bool UExtraSwitchCaseTable::IsColorCase(const FLinearColor& Value, int32 CaseIndex) const
+{
+    return ExtraSwitchCaseTable::IsToleranceCase(UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(Value, ColorSpace), CaseIndex, ColorComponents, ColorTolerancesSquared, ToleranceCaseSlots);
+}
+
+int32 UExtraSwitchCaseTable::AddFusedLevel(UExtraSwitchCaseTable* LevelTable, EExtraSwitchFusedLookup Lookup, int32 NumCases)
+{
+    FusedOutcomeOffsets.Add(FusedNextLevels.Num());
+    FusedNextLevels.AddUninitialized(NumCases + 1);
+    for (int32 Index = FusedNextLevels.Num() - NumCases - 1; Index < FusedNextLevels.Num(); ++Index)
+    {
+        FusedNextLevels[Index] = INDEX_NONE;
+    }
+
+    FusedLookups.Add(Lookup);
+    return FusedLevels.Add(LevelTable);
+}
+
+void UExtraSwitchCaseTable::SetFusedNextLevel(int32 Level, int32 CaseIndex, int32 NextLevel)
+{
+    FusedNextLevels[GetFusedOutcome(Level, CaseIndex) + 1] = NextLevel;
+}
+
+namespace ExtraSwitchFused
+{
+    // The compiler only fuses acyclic chains, so every step moves to a level that hasn't been visited yet
+    template<typename LookupType>
+    int32 FindOutcome(const UExtraSwitchCaseTable& Table, LookupType&& FindLevelCase)
+    {
+        int32 Level = 0;
+        for (int32 Step = 0; Step < Table.FusedLevels.Num(); ++Step)
+        {
+            const int32 Outcome = Table.GetFusedOutcome(Level, FindLevelCase(*Table.FusedLevels[Level], Table.FusedLookups[Level]));
+            const int32 NextLevel = Table.FusedNextLevels[Outcome + 1];
+            if (NextLevel == INDEX_NONE)
+            {
+                return Outcome;
+            }
+            Level = NextLevel;
+        }
+        return INDEX_NONE;
+    }
+}
+
+int32 UExtraSwitchCaseTable::FindFusedIntCase(int32 Value) const
+{
+    return ExtraSwitchFused::FindOutcome(*this, [Value](const UExtraSwitchCaseTable& Level, EExtraSwitchFusedLookup Lookup)
+    {
+        switch (Lookup)
+        {
+        case EExtraSwitchFusedLookup::IntArray:
+            return Level.FindIntCase(Value);
+        case EExtraSwitchFusedLookup::IntRange:
+            return Level.FindIntRangeCase(Value);
+        case EExtraSwitchFusedLookup::Bitmask:
+            return Level.FindBitmaskCase((uint32)Value);
+        default:
+            return INDEX_NONE;
+        }
+    });
+}
+
+int32 UExtraSwitchCaseTable::FindFusedFloatCase(double Value) const
+{
+    return ExtraSwitchFused::FindOutcome(*this, [Value](const UExtraSwitchCaseTable& Level, EExtraSwitchFusedLookup Lookup)
+    {
+        switch (Lookup)
+        {
+        case EExtraSwitchFusedLookup::FloatRange:
+            return Level.FindFloatRangeCase((float)Value);
+        case EExtraSwitchFusedLookup::Float:
+            return Level.FindFloatCase((float)Value);
+        default:
+            return INDEX_NONE;
+        }
+    });
+}
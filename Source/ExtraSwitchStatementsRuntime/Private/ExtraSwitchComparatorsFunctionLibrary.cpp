@@ -1,8 +1,100 @@
 // Copyright Amir Ben-Kiki 2025
 
 #include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchDispatch.h"
+#include "ExtraSwitchProfiler.h"
 #include "Engine/Engine.h"
 
+#if EXTRASWITCH_PROFILING
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("ExtraSwitch"), STATGROUP_ExtraSwitch, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Case Lookup"), STAT_ExtraSwitchLookup, STATGROUP_ExtraSwitch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Switch Evaluations"), STAT_ExtraSwitchEvaluations, STATGROUP_ExtraSwitch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Case Lookups"), STAT_ExtraSwitchLookups, STATGROUP_ExtraSwitch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Default Pin Hits"), STAT_ExtraSwitchDefaultHits, STATGROUP_ExtraSwitch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Case Hits"), STAT_ExtraSwitchCacheHits, STATGROUP_ExtraSwitch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Case Misses"), STAT_ExtraSwitchCacheMisses, STATGROUP_ExtraSwitch);
+
+UE_TRACE_CHANNEL_DEFINE(ExtraSwitchChannel);
+#endif
+
+namespace ExtraSwitchLookup
+{
+    /**
+     * Runs a case table lookup for the compiled switch nodes and feeds the profiling stats
+     * @param StartIndex - 0 for the lookup that starts an evaluation, the next case index for the FindNext calls of AllMatches switches
+     */
+    template<typename LookupType>
+    int32 Resolve(const UExtraSwitchCaseTable* Table, int32 StartIndex, LookupType&& Lookup)
+    {
+        if (Table == nullptr)
+        {
+            return INDEX_NONE;
+        }
+
+#if EXTRASWITCH_PROFILING
+        TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(ExtraSwitch_Lookup, ExtraSwitchChannel);
+        SCOPE_CYCLE_COUNTER(STAT_ExtraSwitchLookup);
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        const int32 CaseIndex = Lookup();
+
+        INC_DWORD_STAT(STAT_ExtraSwitchLookups);
+        if (StartIndex == 0)
+        {
+            INC_DWORD_STAT(STAT_ExtraSwitchEvaluations);
+            if (CaseIndex == INDEX_NONE)
+            {
+                INC_DWORD_STAT(STAT_ExtraSwitchDefaultHits);
+            }
+        }
+
+        if (FExtraSwitchProfiler::IsRecording())
+        {
+            FExtraSwitchProfiler::RecordLookup(Table, CaseIndex, StartIndex > 0, FPlatformTime::Cycles64() - StartCycles);
+        }
+        return CaseIndex;
+#else
+        return Lookup();
+#endif
+    }
+
+    /**
+     * Resolve for the switches that cache their last case. The case stored in CaseSlot is re-checked with a single comparison
+     * and the full lookup only runs when it no longer matches. The default pin is never cached, it can only be confirmed by a search.
+     * Only used for nodes whose cases can't both match a value, so the result is always the one Lookup would give.
+     * @param IsCase - Tests the selection against one case index
+     */
+    template<typename IsCaseType, typename LookupType>
+    int32 ResolveCached(const UExtraSwitchCaseTable* Table, int32& CaseSlot, IsCaseType&& IsCase, LookupType&& Lookup)
+    {
+        const int32 PreviousCase = ExtraSwitch::DecodeCaseSlot(CaseSlot);
+        const int32 CaseIndex = Resolve(Table, 0, [&]
+        {
+            const bool bHit = PreviousCase >= 0 && IsCase(PreviousCase);
+#if EXTRASWITCH_PROFILING
+            if (bHit)
+            {
+                INC_DWORD_STAT(STAT_ExtraSwitchCacheHits);
+            }
+            else
+            {
+                INC_DWORD_STAT(STAT_ExtraSwitchCacheMisses);
+            }
+            if (FExtraSwitchProfiler::IsRecording())
+            {
+                FExtraSwitchProfiler::RecordCacheLookup(Table, bHit);
+            }
+#endif
+            return bHit ? PreviousCase : Lookup();
+        });
+        CaseSlot = ExtraSwitch::EncodeCaseSlot(CaseIndex);
+        return CaseIndex;
+    }
+}
+
 
 
 bool UExtraSwitchComparatorsFunctionLibrary::AreIntsNotEqual(int32 A, int32 B)
@@ -17,44 +109,26 @@ bool UExtraSwitchComparatorsFunctionLibrary::AreIntsNotEqual(int32 A, int32 B)
 
 bool UExtraSwitchComparatorsFunctionLibrary::IsColorWithToleranceNotNearlyEqual(const FLinearColor& A, const FColorAndTolerance& B)
 {
-    float temp = FLinearColor::Dist(A, B.Color);
-    bool result = temp > B.Tolerance;
-
-
-    return result;
+    return !ExtraSwitch::IsWithinTolerance(A, B.Color, B.Tolerance);
 }
 
 bool UExtraSwitchComparatorsFunctionLibrary::IsColorWithToleranceNotNearlyEqualNoAlpha(const FLinearColor& A, const FColorAndTolerance& B)
 {
     FLinearColor AConverted = A.HSVToLinearRGB();
     FLinearColor BConverted = B.Color.HSVToLinearRGB();
-    float temp = FLinearColor::Dist(AConverted, BConverted);
 
-    return temp > B.Tolerance;
+    return !ExtraSwitch::IsWithinTolerance(AConverted, BConverted, B.Tolerance);
 }
 
 bool UExtraSwitchComparatorsFunctionLibrary::IsFloatWithToleranceNotNearlyEqual(float A, const FFloatAndTolerance& B)
 {
-    // Check if we're receiving the expected value
-    bool result = !FMath::IsNearlyEqual(A, B.Value, B.Tolerance);
-
-    return result;
+    return !ExtraSwitch::IsWithinTolerance(A, B.Value, B.Tolerance);
 }
 
 bool UExtraSwitchComparatorsFunctionLibrary::IsFloatNotWithinRange(float A, const FExtraSwitchFloatRange& B)
 {
-
-    // Validate range bounds
-    if (B.RangeMin > B.RangeMax)
-    {
-        return true;  // Skip this pin if range is invalid
-    }
-    
-    // Create range object
-    TRange<float> Range = TRange<float>();
-    Range = B.Inclusive ? Range.Inclusive(B.RangeMin, B.RangeMax) : Range.Exclusive(B.RangeMin, B.RangeMax);
-    
-    bool bContains = Range.Contains(A);
+    // Reversed ranges never contain anything, so the pin is skipped
+    bool bContains = TRangeSwitch<float>::Contains({ B.RangeMin, B.RangeMax, B.Inclusive }, A);
     bool bNotWithinRange = !bContains;  // UK2Node_Switch skips pins that return true, so we want true when NOT in range
         
     return bNotWithinRange;  // Return true when value is NOT within range (so UK2Node_Switch skips this pin)
@@ -63,23 +137,297 @@ bool UExtraSwitchComparatorsFunctionLibrary::IsFloatNotWithinRange(float A, cons
 bool UExtraSwitchComparatorsFunctionLibrary::IsVectorWithToleranceNotNearlyEqual(const FVector& A, const FVectorAndTolerance& B)
 {
     FVector BVector(B.X, B.Y, B.Z);
-    float Distance = FVector::Dist(A, BVector);
-    bool Result = Distance > B.Tolerance;
 
+    return !ExtraSwitch::IsWithinTolerance(A, BVector, B.Tolerance);
+}
+
+bool UExtraSwitchComparatorsFunctionLibrary::IsIntNotWithinRange(int32 A, const FSwitchIntRange& B)
+{
+    bool bContains = TRangeSwitch<int32>::Contains({ B.RangeMin, B.RangeMax, B.Inclusive }, A);
+    bool bNotWithinRange = !bContains;  // UK2Node_Switch skips pins that return true, so we want true when NOT in range
+
+    return bNotWithinRange;
 
-    return Result;
 }
 
-bool UExtraSwitchComparatorsFunctionLibrary::IsIntNotWithinRange(int& A, FSwitchIntRange& B)
+bool UExtraSwitchComparatorsFunctionLibrary::AreNamesNotEqual(FName A, FName B)
 {
-    // Create range object
-    TRange<int32> Range = TRange<int32>();
-    Range = B.Inclusive ? Range.Inclusive(B.RangeMin, B.RangeMax) : Range.Exclusive(B.RangeMin, B.RangeMax);
+    return A != B;
+}
 
-    bool bContains = Range.Contains(A);
-    bool bNotWithinRange = !bContains;  // UK2Node_Switch skips pins that return true, so we want true when NOT in range
+bool UExtraSwitchComparatorsFunctionLibrary::AreGameplayTagsNotEqual(const FGameplayTag& A, const FGameplayTag& B)
+{
+    return A != B;
+}
 
+bool UExtraSwitchComparatorsFunctionLibrary::IsBitmaskNotMatching(int32 A, const FExtraSwitchBitmaskCase& B)
+{
+    return !TBitmaskSwitch<uint32>::Matches({ (uint32)B.Mask, (TBitmaskSwitch<uint32>::ETest)B.Test }, (uint32)A);
+}
 
-    return bNotWithinRange;
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextIntRangeCaseIndex(int32 A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextIntRangeCase(A, StartIndex); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextFloatRangeCaseIndex(double A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextFloatRangeCase((float)A, StartIndex); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextFloatCase((float)A, StartIndex); });
+}
 
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextVectorCaseIndex(const FVector& A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextVectorCase(A, StartIndex); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextColorCaseIndex(const FLinearColor& A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextColorCase(A, StartIndex); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNameCaseIndex(FName A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindNameCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindNextBitmaskCaseIndex(int32 A, const UExtraSwitchCaseTable* Table, int32 StartIndex)
+{
+    return ExtraSwitchLookup::Resolve(Table, StartIndex, [&] { return Table->FindNextBitmaskCase((uint32)A, StartIndex); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindBitmaskCaseIndex(int32 A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindBitmaskCase((uint32)A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindGameplayTagCaseIndex(const FGameplayTag& A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindGameplayTagCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindIntArrayCaseIndex(int32 A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindIntCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindIntRangeCaseIndex(int32 A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindIntRangeCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFloatRangeCaseIndex(double A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindFloatRangeCase((float)A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFloatRangeCaseIndexWithHysteresis(double A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    const int32 CaseIndex = ExtraSwitchLookup::Resolve(Table, 0, [&]
+    {
+        return Table->FindFloatRangeCaseWithHysteresis((float)A, ExtraSwitch::DecodeCaseSlot(CaseSlot), CaseSlot != ExtraSwitch::CaseSlotNotEvaluated);
+    });
+    CaseSlot = ExtraSwitch::EncodeCaseSlot(CaseIndex);
+    return CaseIndex;
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindIntArrayCaseIndexCached(int32 A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsIntCase(A, CaseIndex); },
+        [&] { return Table->FindIntCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindIntRangeCaseIndexCached(int32 A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsIntRangeCase(A, CaseIndex); },
+        [&] { return Table->FindIntRangeCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFloatRangeCaseIndexCached(double A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsFloatRangeCase((float)A, CaseIndex); },
+        [&] { return Table->FindFloatRangeCase((float)A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindFloatCase((float)A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindVectorCaseIndex(const FVector& A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindVectorCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindColorCaseIndex(const FLinearColor& A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindColorCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFusedIntCaseIndex(int32 A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindFusedIntCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFusedFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table)
+{
+    return ExtraSwitchLookup::Resolve(Table, 0, [&] { return Table->FindFusedFloatCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindFloatCaseIndexCached(double A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsFloatCase((float)A, CaseIndex); },
+        [&] { return Table->FindFloatCase((float)A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindVectorCaseIndexCached(const FVector& A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsVectorCase(A, CaseIndex); },
+        [&] { return Table->FindVectorCase(A); });
+}
+
+int32 UExtraSwitchComparatorsFunctionLibrary::FindColorCaseIndexCached(const FLinearColor& A, const UExtraSwitchCaseTable* Table, int32& CaseSlot)
+{
+    return ExtraSwitchLookup::ResolveCached(Table, CaseSlot,
+        [&](int32 CaseIndex) { return Table->IsColorCase(A, CaseIndex); },
+        [&] { return Table->FindColorCase(A); });
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyIntsBySet(const TArray<int32>& Values, const TArray<int32>& CaseValues, TArray<int32>& OutCaseIndices)
+{
+    const TIntSetSwitch Switch(CaseValues);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find(Values[Index]);
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyIntsByRange(const TArray<int32>& Values, const TArray<FSwitchIntRange>& Ranges, TArray<int32>& OutCaseIndices)
+{
+    TArray<TRangeSwitch<int32>::FCase> Cases;
+    Cases.Reserve(Ranges.Num());
+    for (const FSwitchIntRange& Range : Ranges)
+    {
+        Cases.Add({ Range.RangeMin, Range.RangeMax, Range.Inclusive });
+    }
+    const TRangeSwitch<int32> Switch(Cases);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find(Values[Index]);
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyFloatsByRange(const TArray<double>& Values, const TArray<FExtraSwitchFloatRange>& Ranges, TArray<int32>& OutCaseIndices)
+{
+    TArray<TRangeSwitch<float>::FCase> Cases;
+    Cases.Reserve(Ranges.Num());
+    for (const FExtraSwitchFloatRange& Range : Ranges)
+    {
+        Cases.Add({ Range.RangeMin, Range.RangeMax, Range.Inclusive });
+    }
+    const TRangeSwitch<float> Switch(Cases);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find((float)Values[Index]);
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyFloatsByTolerance(const TArray<double>& Values, const TArray<double>& CaseValues, float Tolerance, TArray<int32>& OutCaseIndices)
+{
+    TArray<float> Centers;
+    Centers.Reserve(CaseValues.Num());
+    for (const double CaseValue : CaseValues)
+    {
+        Centers.Add((float)CaseValue);
+    }
+    const TToleranceSwitch<float> Switch(Centers, Tolerance);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find((float)Values[Index]);
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyVectors(const TArray<FVector>& Values, const TArray<FVector>& CaseValues, float Tolerance, TArray<int32>& OutCaseIndices)
+{
+    const TToleranceSwitch<FVector, double> Switch(CaseValues, Tolerance);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find(Values[Index]);
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyColors(const TArray<FLinearColor>& Values, const TArray<FLinearColor>& CaseValues, float Tolerance, bool bUseAlpha, TArray<int32>& OutCaseIndices)
+{
+    ClassifyColorsInSpace(Values, CaseValues, Tolerance, bUseAlpha ? EExtraSwitchColorSpace::LinearRGBA : EExtraSwitchColorSpace::HSV, OutCaseIndices);
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyColorsInSpace(const TArray<FLinearColor>& Values, const TArray<FLinearColor>& CaseValues, float Tolerance, EExtraSwitchColorSpace ColorSpace,
+    TArray<int32>& OutCaseIndices)
+{
+    // Convert the case colors once instead of once per value
+    TArray<FLinearColor> Centers;
+    Centers.Reserve(CaseValues.Num());
+    for (const FLinearColor& CaseValue : CaseValues)
+    {
+        Centers.Add(ConvertToColorComparisonSpace(CaseValue, ColorSpace));
+    }
+    const TToleranceSwitch<FLinearColor> Switch(Centers, Tolerance);
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find(ConvertToColorComparisonSpace(Values[Index], ColorSpace));
+    }
+}
+
+FLinearColor UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace(const FLinearColor& Color, EExtraSwitchColorSpace ColorSpace)
+{
+    switch (ColorSpace)
+    {
+    case EExtraSwitchColorSpace::LinearRGB:
+        return FLinearColor(Color.R, Color.G, Color.B, 0.0f);
+    case EExtraSwitchColorSpace::HSV:
+        return Color.HSVToLinearRGB();
+    case EExtraSwitchColorSpace::Oklab:
+        return ExtraSwitch::LinearRGBToOklab(Color);
+    case EExtraSwitchColorSpace::CIELAB:
+        return ExtraSwitch::LinearRGBToCIELab(Color);
+    default:
+        return Color;
+    }
+}
+
+void UExtraSwitchComparatorsFunctionLibrary::ClassifyBitmasks(const TArray<int32>& Values, const TArray<FExtraSwitchBitmaskCase>& Cases, TArray<int32>& OutCaseIndices)
+{
+    const TBitmaskSwitch<uint32> Switch(TBitmaskSwitch<uint32>::MakeCases(MakeArrayView(Cases)));
+
+    OutCaseIndices.SetNumUninitialized(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutCaseIndices[Index] = Switch.Find((uint32)Values[Index]);
+    }
+}
+
+bool UExtraSwitchComparatorsFunctionLibrary::IsCaseIndexBelow(int32 CaseIndex, int32 Bound)
+{
+    return CaseIndex < Bound;
 }
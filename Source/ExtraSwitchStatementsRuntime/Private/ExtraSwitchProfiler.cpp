@@ -0,0 +1,247 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchProfiler.h"
+
+#if EXTRASWITCH_PROFILING
+
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchStatementsRuntime.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/ObjectKey.h"
+
+namespace ExtraSwitchProfiler
+{
+    static int32 GProfiling = 0;
+    static FAutoConsoleVariableRef CVarProfiling(
+        TEXT("ExtraSwitch.Profiling"),
+        GProfiling,
+        TEXT("When 1 every compiled extra switch node records how often each of its cases executes, see ExtraSwitch.DumpProfile"));
+
+    struct FSwitchStats
+    {
+        FString Name;
+        uint64 Evaluations = 0;
+        uint64 Lookups = 0;
+        uint64 DefaultHits = 0;
+        uint64 Cycles = 0;
+        uint64 CacheLookups = 0;
+        uint64 CacheHits = 0;
+        TArray<uint64> CaseHits;
+    };
+
+    static FCriticalSection StatsLock;
+    static TMap<FObjectKey, FSwitchStats> StatsPerTable;
+
+    // Case hits loaded with ExtraSwitch.ImportProfile, keyed by case table path
+    static TMap<FString, TArray<uint64>> ImportedCaseHits;
+
+    static void AddCaseHits(TArray<uint64>& InOutCaseHits, TConstArrayView<uint64> CaseHits)
+    {
+        if (InOutCaseHits.Num() < CaseHits.Num())
+        {
+            InOutCaseHits.SetNumZeroed(CaseHits.Num());
+        }
+        for (int32 CaseIndex = 0; CaseIndex < CaseHits.Num(); ++CaseIndex)
+        {
+            InOutCaseHits[CaseIndex] += CaseHits[CaseIndex];
+        }
+    }
+
+    static FSwitchStats& FindOrAddStats(const UExtraSwitchCaseTable* Table)
+    {
+        FSwitchStats& Stats = StatsPerTable.FindOrAdd(FObjectKey(Table));
+        if (Stats.Name.IsEmpty())
+        {
+            // The table is named after its node and outered to the generated class, so the path points straight at the switch
+            Stats.Name = Table->GetPathName();
+        }
+        return Stats;
+    }
+}
+
+bool FExtraSwitchProfiler::IsRecording()
+{
+    return ExtraSwitchProfiler::GProfiling != 0;
+}
+
+void FExtraSwitchProfiler::RecordLookup(const UExtraSwitchCaseTable* Table, int32 CaseIndex, bool bContinuation, uint64 Cycles)
+{
+    using namespace ExtraSwitchProfiler;
+
+    FScopeLock Lock(&StatsLock);
+    FSwitchStats& Stats = FindOrAddStats(Table);
+    ++Stats.Lookups;
+    Stats.Cycles += Cycles;
+    if (!bContinuation)
+    {
+        ++Stats.Evaluations;
+    }
+
+    if (CaseIndex != INDEX_NONE)
+    {
+        if (!Stats.CaseHits.IsValidIndex(CaseIndex))
+        {
+            Stats.CaseHits.SetNumZeroed(CaseIndex + 1);
+        }
+        ++Stats.CaseHits[CaseIndex];
+    }
+    else if (!bContinuation)
+    {
+        ++Stats.DefaultHits;
+    }
+}
+
+void FExtraSwitchProfiler::RecordCacheLookup(const UExtraSwitchCaseTable* Table, bool bHit)
+{
+    using namespace ExtraSwitchProfiler;
+
+    FScopeLock Lock(&StatsLock);
+    FSwitchStats& Stats = FindOrAddStats(Table);
+    ++Stats.CacheLookups;
+    if (bHit)
+    {
+        ++Stats.CacheHits;
+    }
+}
+
+void FExtraSwitchProfiler::Reset()
+{
+    FScopeLock Lock(&ExtraSwitchProfiler::StatsLock);
+    ExtraSwitchProfiler::StatsPerTable.Reset();
+    ExtraSwitchProfiler::ImportedCaseHits.Reset();
+}
+
+bool FExtraSwitchProfiler::DumpCsv(const FString& Filename)
+{
+    using namespace ExtraSwitchProfiler;
+
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Switch,Evaluations,Lookups,TotalMilliseconds,CacheLookups,CacheHits,Case,Hits"));
+    {
+        FScopeLock Lock(&StatsLock);
+        for (const TPair<FObjectKey, FSwitchStats>& Pair : StatsPerTable)
+        {
+            const FSwitchStats& Stats = Pair.Value;
+            const FString Prefix = FString::Printf(TEXT("\"%s\",%llu,%llu,%.4f,%llu,%llu"), *Stats.Name, Stats.Evaluations, Stats.Lookups,
+                FPlatformTime::ToMilliseconds64(Stats.Cycles), Stats.CacheLookups, Stats.CacheHits);
+            Lines.Add(FString::Printf(TEXT("%s,Default,%llu"), *Prefix, Stats.DefaultHits));
+            for (int32 CaseIndex = 0; CaseIndex < Stats.CaseHits.Num(); ++CaseIndex)
+            {
+                Lines.Add(FString::Printf(TEXT("%s,%d,%llu"), *Prefix, CaseIndex, Stats.CaseHits[CaseIndex]));
+            }
+        }
+    }
+
+    const FString FullPath = FPaths::IsRelative(Filename) ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("ExtraSwitch"), Filename) : Filename;
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *FullPath))
+    {
+        UE_LOG(LogExtraSwitchRuntime, Warning, TEXT("Failed to write the switch profile to %s"), *FullPath);
+        return false;
+    }
+
+    UE_LOG(LogExtraSwitchRuntime, Log, TEXT("Wrote the switch profile to %s"), *FullPath);
+    return true;
+}
+
+bool FExtraSwitchProfiler::ImportCsv(const FString& Filename)
+{
+    using namespace ExtraSwitchProfiler;
+
+    const FString FullPath = FPaths::IsRelative(Filename) ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("ExtraSwitch"), Filename) : Filename;
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FullPath))
+    {
+        UE_LOG(LogExtraSwitchRuntime, Warning, TEXT("Failed to read a switch profile from %s"), *FullPath);
+        return false;
+    }
+
+    FScopeLock Lock(&StatsLock);
+    int32 NumRows = 0;
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        // Case and Hits are the last two columns, files written before the cache columns were added have 6 instead of 8.
+        // The default pin rows don't help ordering the cases.
+        TArray<FString> Fields;
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+        if ((Fields.Num() != 6 && Fields.Num() != 8) || !Fields[Fields.Num() - 2].IsNumeric())
+        {
+            continue;
+        }
+
+        const int32 CaseIndex = FCString::Atoi(*Fields[Fields.Num() - 2]);
+        if (CaseIndex < 0)
+        {
+            continue;
+        }
+
+        TArray<uint64>& CaseHits = ImportedCaseHits.FindOrAdd(Fields[0].TrimQuotes());
+        if (CaseHits.Num() <= CaseIndex)
+        {
+            CaseHits.SetNumZeroed(CaseIndex + 1);
+        }
+        CaseHits[CaseIndex] += FCString::Strtoui64(*Fields.Last(), nullptr, 10);
+        ++NumRows;
+    }
+
+    UE_LOG(LogExtraSwitchRuntime, Log, TEXT("Imported %d switch case rows from %s"), NumRows, *FullPath);
+    return true;
+}
+
+bool FExtraSwitchProfiler::FindCaseHits(const FString& SwitchPath, TArray<uint64>& OutCaseHits)
+{
+    using namespace ExtraSwitchProfiler;
+
+    OutCaseHits.Reset();
+    bool bFound = false;
+
+    FScopeLock Lock(&StatsLock);
+    for (const TPair<FObjectKey, FSwitchStats>& Pair : StatsPerTable)
+    {
+        if (Pair.Value.Name.StartsWith(SwitchPath))
+        {
+            AddCaseHits(OutCaseHits, Pair.Value.CaseHits);
+            bFound = true;
+        }
+    }
+    for (const TPair<FString, TArray<uint64>>& Pair : ImportedCaseHits)
+    {
+        if (Pair.Key.StartsWith(SwitchPath))
+        {
+            AddCaseHits(OutCaseHits, Pair.Value);
+            bFound = true;
+        }
+    }
+    return bFound;
+}
+
+static FAutoConsoleCommand GExtraSwitchDumpProfileCommand(
+    TEXT("ExtraSwitch.DumpProfile"),
+    TEXT("Writes the case hit counts recorded while ExtraSwitch.Profiling is 1 to a CSV file. Optional argument: the file name"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const FString Filename = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("ExtraSwitchProfile-%s.csv"), *FDateTime::Now().ToString());
+        FExtraSwitchProfiler::DumpCsv(Filename);
+    }));
+
+static FAutoConsoleCommand GExtraSwitchResetProfileCommand(
+    TEXT("ExtraSwitch.ResetProfile"),
+    TEXT("Discards the case hit counts recorded by ExtraSwitch.Profiling"),
+    FConsoleCommandDelegate::CreateStatic(&FExtraSwitchProfiler::Reset));
+
+static FAutoConsoleCommand GExtraSwitchImportProfileCommand(
+    TEXT("ExtraSwitch.ImportProfile"),
+    TEXT("Loads case hit counts from a CSV file written by ExtraSwitch.DumpProfile, used by the switch nodes' Order Case Tests by Recorded Hits action"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() == 0)
+        {
+            UE_LOG(LogExtraSwitchRuntime, Warning, TEXT("Usage: ExtraSwitch.ImportProfile <File>"));
+            return;
+        }
+        FExtraSwitchProfiler::ImportCsv(Args[0]);
+    }));
+
+#endif
@@ -0,0 +1,401 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayTagContainer.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.generated.h"
+
+// The lookup one level of a fused case table runs, the int levels take the selection as an int32 and the float levels as a double
+UENUM()
+enum class EExtraSwitchFusedLookup : uint8
+{
+	IntArray,
+	IntRange,
+	Bitmask,
+	FloatRange,
+	Float,
+};
+
+/**
+ * Lookup table baked from a switch node's PinValues when the owning blueprint is compiled.
+ * The table is outered to the generated class, the compiled switch passes it to a single resolve function
+ * instead of calling a comparator for every case pin. Case indices are the indices into the node's PinValues (the pin SourceIndex).
+ * The lookups themselves are the native switches from ExtraSwitchDispatch.h, so C++ callers get identical results.
+ * The case values are copied straight from the node rather than round tripped through pin export text, so no precision is lost,
+ * and the table is never written after compilation, so one instance is shared by every object of the generated class.
+ */
+UCLASS()
+class EXTRASWITCHSTATEMENTSRUNTIME_API UExtraSwitchCaseTable : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// The match mode the range and tolerance cases were built for
+	UPROPERTY()
+	EExtraSwitchMatchMode MatchMode = EExtraSwitchMatchMode::FirstMatch;
+
+	// Sorted, de-duplicated int case values, or only the lowest one when bIntValuesDense is set
+	UPROPERTY()
+	TArray<int32> IntValues;
+
+	// The case index for each entry in IntValues, or for every value from IntValues[0] up when bIntValuesDense is set (INDEX_NONE for the holes)
+	UPROPERTY()
+	TArray<int32> IntCaseIndices;
+
+	// True when the int cases were built as a dense jump table, the lookup is then a bounds check and an index instead of a binary search
+	UPROPERTY()
+	bool bIntValuesDense = false;
+
+	// The node's int case values by case index, so a cached case can be re-checked with a single compare
+	UPROPERTY()
+	TArray<int32> IntCaseValues;
+
+	/**
+	 * Builds the int lookup from the node's case values, duplicate values keep the lowest case index
+	 * so the result matches the first-match comparator chain of UK2Node_Switch
+	 * @param MinDenseFill - The share of the value span the cases must fill for a dense jump table, see TIntSetSwitch::BuildTable
+	 */
+	void BuildIntCases(TConstArrayView<int32> Values, float MinDenseFill);
+
+	/**
+	 * @param Value - The selection value
+	 * @return The case index matching Value, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindIntCase(int32 Value) const;
+
+	/**
+	 * Single compare against one case, used by the switches that cache their last case
+	 * @param CaseIndex - A case index FindIntCase returned before
+	 * @return True if FindIntCase(Value) would return CaseIndex
+	 */
+	bool IsIntCase(int32 Value, int32 CaseIndex) const;
+
+	// Maps every case name to its case index, duplicate names keep the lowest index
+	UPROPERTY()
+	TMap<FName, int32> NameCaseIndices;
+
+	// Builds the name lookup from the node's case values
+	void BuildNameCases(TConstArrayView<FName> Values);
+
+	/**
+	 * @param Value - The selection value
+	 * @return The case index matching Value, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindNameCase(FName Value) const;
+
+	// Maps every case tag to its case index, duplicate tags keep the lowest index
+	UPROPERTY()
+	TMap<FGameplayTag, int32> GameplayTagCaseIndices;
+
+	// True when a case also matches any child of its tag, the lookup then walks up the selection's parents
+	UPROPERTY()
+	bool bGameplayTagsMatchHierarchy = false;
+
+	/**
+	 * Builds the gameplay tag lookup from the node's case values
+	 * @param bMatchHierarchy - When true a case tag A.B also matches A.B.C, like FGameplayTag::MatchesTag
+	 */
+	void BuildGameplayTagCases(TConstArrayView<FGameplayTag> Values, bool bMatchHierarchy);
+
+	/**
+	 * One map lookup per level of the selection tag, so the cost depends on the tag depth rather than the number of cases
+	 * @param Value - The selection value
+	 * @return The lowest case index matching Value, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindGameplayTagCase(const FGameplayTag& Value) const;
+
+	// TBitmaskSwitch<uint32> planes, a case matches when ((Value & BitmaskAndMasks[i]) ^ BitmaskExpected[i]) == 0 differs from BitmaskNegate[i]
+	UPROPERTY()
+	TArray<uint32> BitmaskAndMasks;
+
+	UPROPERTY()
+	TArray<uint32> BitmaskExpected;
+
+	UPROPERTY()
+	TArray<uint8> BitmaskNegate;
+
+	// Only used in BestMatch mode, the more flags a case tests the narrower it is
+	UPROPERTY()
+	TArray<uint8> BitmaskSpecificity;
+
+	/**
+	 * Folds the node's Any, All and Exact masks into one packed test
+	 * @param InMatchMode - FirstMatch returns the lowest passing case, BestMatch the one testing the most flags and AllMatches steps through them with FindNextBitmaskCase
+	 */
+	void BuildBitmaskCases(TConstArrayView<FExtraSwitchBitmaskCase> Cases, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch);
+
+	/**
+	 * @param Value - The selection flags
+	 * @return The case index picked by MatchMode, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindBitmaskCase(uint32 Value) const;
+
+	// Bitmask version of FindNextFloatCase
+	int32 FindNextBitmaskCase(uint32 Value, int32 StartIndex) const;
+
+	// Sorted, de-duplicated min and max values of every int range
+	UPROPERTY()
+	TArray<int32> IntRangeBoundaries;
+
+	// The winning case index for each int region, laid out like FloatRangeCases
+	UPROPERTY()
+	TArray<int32> IntRangeCases;
+
+	// Only built in AllMatches mode, IntRangeCases then holds every matching case of each region starting at these offsets
+	UPROPERTY()
+	TArray<int32> IntRangeCaseOffsets;
+
+	// The node's ranges by case index, so a cached case can be re-checked without a search
+	UPROPERTY()
+	TArray<FSwitchIntRange> IntRanges;
+
+	// Sorted, de-duplicated min and max values of every float range
+	UPROPERTY()
+	TArray<float> FloatRangeBoundaries;
+
+	// The winning case index for each float region, region 2 * i is the open interval below FloatRangeBoundaries[i],
+	// region 2 * i + 1 is the boundary value itself and the last region lies above every boundary
+	UPROPERTY()
+	TArray<int32> FloatRangeCases;
+
+	// Only built in AllMatches mode, laid out like IntRangeCaseOffsets
+	UPROPERTY()
+	TArray<int32> FloatRangeCaseOffsets;
+
+	// The node's ranges by case index, like IntRanges
+	UPROPERTY()
+	TArray<FExtraSwitchFloatRange> FloatRanges;
+
+	/**
+	 * Merges the node's int ranges into one sorted boundary array, every open interval between boundaries and every boundary value
+	 * stores the case index whose range contains it, reversed and empty ranges never match
+	 * @param InMatchMode - FirstMatch stores the lowest case index, BestMatch the narrowest range and AllMatches every containing range
+	 */
+	void BuildIntRangeCases(TConstArrayView<FSwitchIntRange> Ranges, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch);
+
+	/**
+	 * @param Value - The selection value
+	 * @return The case index picked by MatchMode whose range contains Value, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindIntRangeCase(int32 Value) const;
+
+	/**
+	 * @param Value - The selection value
+	 * @param StartIndex - The lowest case index to consider
+	 * @return The lowest case index >= StartIndex whose range contains Value, or INDEX_NONE when there are no more. Requires AllMatches mode.
+	 */
+	int32 FindNextIntRangeCase(int32 Value, int32 StartIndex) const;
+
+	/**
+	 * Single range test against one case, used by the switches that cache their last case
+	 * @param CaseIndex - A case index FindIntRangeCase returned before
+	 * @return True if the range of CaseIndex contains Value, which only means FindIntRangeCase(Value) returns it again when no two ranges overlap
+	 */
+	bool IsIntRangeCase(int32 Value, int32 CaseIndex) const;
+
+	// Float version of BuildIntRangeCases
+	void BuildFloatRangeCases(TConstArrayView<FExtraSwitchFloatRange> Ranges, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch);
+
+	// Float version of FindIntRangeCase
+	int32 FindFloatRangeCase(float Value) const;
+
+	// Float version of FindNextIntRangeCase
+	int32 FindNextFloatRangeCase(float Value, int32 StartIndex) const;
+
+	// Float version of IsIntRangeCase
+	bool IsFloatRangeCase(float Value, int32 CaseIndex) const;
+
+	// How far past a range boundary the selection must move before a hysteresis lookup changes case, 0 when the node has no hysteresis
+	UPROPERTY()
+	float FloatRangeHysteresis = 0.0f;
+
+	/**
+	 * Sets the margin FindFloatRangeCaseWithHysteresis uses for a table built with BuildFloatRangeCases
+	 * @param Margin - How far the selection must cross a range boundary before the case changes
+	 */
+	void SetFloatRangeHysteresis(float Margin);
+
+	/**
+	 * Stateful version of FindFloatRangeCase that stops a selection hovering on a boundary from toggling cases.
+	 * The previous case is kept while the selection stays within Margin outside of its range, which is checked first so the steady state is O(1).
+	 * Leaving the default pin for a range likewise requires the selection to be Margin inside that range.
+	 * @param Value - The selection value
+	 * @param PreviousCase - The case this lookup returned last time for the same object
+	 * @param bHasPrevious - False on the first evaluation, the plain lookup result is used
+	 * @return The case index to execute, or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindFloatRangeCaseWithHysteresis(float Value, int32 PreviousCase, bool bHasPrevious) const;
+
+	// Case floats packed into TToleranceSwitch<float> planes
+	UPROPERTY()
+	TArray<float> FloatComponents;
+
+	UPROPERTY()
+	TArray<float> FloatTolerancesSquared;
+
+	// When not empty, slot i of the packed float, vector or color planes holds case ToleranceScanOrder[i] instead of case i
+	UPROPERTY()
+	TArray<int32> ToleranceScanOrder;
+
+	// The slot of every case when ToleranceScanOrder is set, so a cached case can be found in the planes
+	UPROPERTY()
+	TArray<int32> ToleranceCaseSlots;
+
+	/**
+	 * Packs the node's case floats for the 4-wide squared distance search
+	 * @param ScanOrder - Optional order to test the cases in, hottest first. Only applied in FirstMatch mode,
+	 *                    the caller must make sure the cases are disjoint (ExtraSwitch::AreToleranceCasesDisjoint) so the result doesn't change.
+	 */
+	void BuildFloatCases(TConstArrayView<float> Values, float Tolerance, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch, TConstArrayView<int32> ScanOrder = {});
+
+	/**
+	 * @param Value - The selection value
+	 * @return The first case index within tolerance of Value (the nearest one in BestMatch mode), or INDEX_NONE if the default pin should execute
+	 */
+	int32 FindFloatCase(float Value) const;
+
+	/**
+	 * @param Value - The selection value
+	 * @param StartIndex - The lowest case index to consider
+	 * @return The lowest case index >= StartIndex within tolerance of Value, or INDEX_NONE when there are no more
+	 */
+	int32 FindNextFloatCase(float Value, int32 StartIndex) const;
+
+	/**
+	 * Single tolerance test against one case with the same math as the full search, used by the switches that cache their last case
+	 * @param CaseIndex - A case index FindFloatCase returned before
+	 * @return True if Value is within tolerance of CaseIndex, which only means FindFloatCase(Value) returns it again when the cases are disjoint
+	 */
+	bool IsFloatCase(float Value, int32 CaseIndex) const;
+
+	// Center of the case vectors, the planes and the k-d tree hold the cases relative to it and the lookups subtract it from the selection in double
+	UPROPERTY()
+	FVector VectorOrigin = FVector::ZeroVector;
+
+	// Which of the planes and trees below the vector lookups use
+	UPROPERTY()
+	EExtraSwitchVectorPrecision VectorPrecision = EExtraSwitchVectorPrecision::Double;
+
+	// Case vectors packed into TToleranceSwitch<FVector> float planes, RebasedFloat precision
+	UPROPERTY()
+	TArray<float> VectorComponents;
+
+	UPROPERTY()
+	TArray<float> VectorTolerancesSquared;
+
+	// Case vectors packed into TToleranceSwitch<FVector, double> planes, Double precision
+	UPROPERTY()
+	TArray<double> VectorDoubleComponents;
+
+	UPROPERTY()
+	TArray<double> VectorDoubleTolerancesSquared;
+
+	// TNearestVectorSwitch k-d tree, only built in BestMatch mode for large case lists, FindVectorCase then walks the tree instead of every case.
+	// The points are in VectorTreePoints for RebasedFloat precision and in VectorDoubleTreePoints for Double
+	UPROPERTY()
+	TArray<FVector3f> VectorTreePoints;
+
+	UPROPERTY()
+	TArray<FVector> VectorDoubleTreePoints;
+
+	UPROPERTY()
+	TArray<int32> VectorTreeCaseIndices;
+
+	UPROPERTY()
+	TArray<uint8> VectorTreeSplitAxes;
+
+	UPROPERTY()
+	float VectorTreeTolerance = -1.0f;
+
+	// Case colors packed into TToleranceSwitch<FLinearColor> planes
+	UPROPERTY()
+	TArray<float> ColorComponents;
+
+	UPROPERTY()
+	TArray<float> ColorTolerancesSquared;
+
+	// The space the case colors were converted to at build time, the selection is converted to it once per lookup
+	UPROPERTY()
+	EExtraSwitchColorSpace ColorSpace = EExtraSwitchColorSpace::LinearRGBA;
+
+	/**
+	 * Packs the node's case vectors for the 4-wide squared distance search,
+	 * in BestMatch mode a list of at least TNearestVectorSwitch::MinCasesForTree vectors also gets a k-d tree
+	 * @param ScanOrder - See BuildFloatCases
+	 * @param InPrecision - Double or float planes, both are measured from the center of the cases
+	 */
+	void BuildVectorCases(TConstArrayView<FVector> Values, float Tolerance, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch, TConstArrayView<int32> ScanOrder = {},
+		EExtraSwitchVectorPrecision InPrecision = EExtraSwitchVectorPrecision::Double);
+
+	// Vector version of FindFloatCase
+	int32 FindVectorCase(const FVector& Value) const;
+
+	// Vector version of FindNextFloatCase
+	int32 FindNextVectorCase(const FVector& Value, int32 StartIndex) const;
+
+	// Vector version of IsFloatCase
+	bool IsVectorCase(const FVector& Value, int32 CaseIndex) const;
+
+	/**
+	 * Packs the node's case colors for the 4-wide squared distance search
+	 * @param InColorSpace - The space both sides are compared in, see UExtraSwitchComparatorsFunctionLibrary::ConvertToColorComparisonSpace
+	 * @param ScanOrder - See BuildFloatCases
+	 */
+	void BuildColorCases(TConstArrayView<FLinearColor> Values, float Tolerance, EExtraSwitchColorSpace InColorSpace, EExtraSwitchMatchMode InMatchMode = EExtraSwitchMatchMode::FirstMatch,
+		TConstArrayView<int32> ScanOrder = {});
+
+	// Color version of FindFloatCase
+	int32 FindColorCase(const FLinearColor& Value) const;
+
+	// Color version of FindNextFloatCase
+	int32 FindNextColorCase(const FLinearColor& Value, int32 StartIndex) const;
+
+	// Color version of IsFloatCase
+	bool IsColorCase(const FLinearColor& Value, int32 CaseIndex) const;
+
+	// The tables of the switch nodes fused into one lookup, level 0 is the node the compiled call belongs to
+	UPROPERTY()
+	TArray<TObjectPtr<UExtraSwitchCaseTable>> FusedLevels;
+
+	UPROPERTY()
+	TArray<EExtraSwitchFusedLookup> FusedLookups;
+
+	// The outcome of the default pin of each level plus one, the outcome of case i of the level is FusedOutcomeOffsets[Level] + i
+	UPROPERTY()
+	TArray<int32> FusedOutcomeOffsets;
+
+	// The level each outcome continues to, indexed by the outcome plus one, INDEX_NONE when the outcome runs a pin
+	UPROPERTY()
+	TArray<int32> FusedNextLevels;
+
+	/**
+	 * Appends a level to a fused table, the outcomes of the levels are numbered one after the other starting at INDEX_NONE
+	 * for the default pin of level 0, so a fused table with a single level returns the same indices as the level itself
+	 * @param LevelTable - The level's own table, built like the node would build it, should be outered to this table
+	 * @param NumCases - The number of case pins of the level
+	 * @return The index of the new level
+	 */
+	int32 AddFusedLevel(UExtraSwitchCaseTable* LevelTable, EExtraSwitchFusedLookup Lookup, int32 NumCases);
+
+	/**
+	 * Makes an outcome of a level continue with the lookup of another level instead of running a pin
+	 * @param CaseIndex - The case of Level, INDEX_NONE for its default pin
+	 */
+	void SetFusedNextLevel(int32 Level, int32 CaseIndex, int32 NextLevel);
+
+	// The outcome number FindFusedIntCase and FindFusedFloatCase return for a case of a level, INDEX_NONE for its default pin
+	int32 GetFusedOutcome(int32 Level, int32 CaseIndex) const { return FusedOutcomeOffsets[Level] + CaseIndex; }
+
+	/**
+	 * Runs the levels from level 0 until one of them resolves to a pin, every level looks up the same selection
+	 * @param Value - The selection value
+	 * @return The outcome of the level that resolved the selection, see GetFusedOutcome
+	 */
+	int32 FindFusedIntCase(int32 Value) const;
+
+	// Float version of FindFusedIntCase, the levels compare at float precision like their own nodes
+	int32 FindFusedFloatCase(double Value) const;
+};
@@ -4,8 +4,85 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "GameplayTagContainer.h"
 #include "ExtraSwitchComparatorsFunctionLibrary.generated.h"
 
+class UExtraSwitchCaseTable;
+
+
+/**
+ * How a range or tolerance switch picks the pins to execute when several cases match the selection
+ */
+UENUM(BlueprintType)
+enum class EExtraSwitchMatchMode : uint8
+{
+	// Execute the first matching pin, like the stock switch nodes
+	FirstMatch,
+	// Execute every matching pin in pin order, like a Sequence node, the default pin only executes if none match
+	AllMatches,
+	// Execute the single best pin, the nearest value for tolerance switches and the narrowest range for range switches
+	BestMatch
+};
+
+/**
+ * How a Switch on Bitmask case mask is tested against the selection
+ */
+UENUM(BlueprintType)
+enum class EExtraSwitchBitmaskTest : uint8
+{
+	// At least one of the mask's flags is set
+	Any,
+	// Every flag of the mask is set, other flags may be set too
+	All,
+	// The selection is exactly the mask
+	Exact
+};
+
+/**
+ * How precisely a Switch on Vector measures the distance to its cases. Both measure from the center of the cases rather than the world origin,
+ * so cases far out in a large world are as precise as cases near the origin
+ */
+UENUM(BlueprintType)
+enum class EExtraSwitchVectorPrecision : uint8
+{
+	// Double precision distances, exact at any large world coordinate
+	Double,
+	// Float distances from the center of the cases, twice as many cases per SIMD step. Good to about 0.1 units for cases spread over 1000000 units
+	RebasedFloat
+};
+
+/**
+ * The space a Switch on Color compares colors in, the case colors are converted once when the node compiles and the selection once per lookup
+ */
+UENUM(BlueprintType)
+enum class EExtraSwitchColorSpace : uint8
+{
+	// Linear RGB with alpha, the distance covers all four channels
+	LinearRGBA,
+	// Linear RGB, alpha is ignored
+	LinearRGB,
+	// Both colors are read as HSV and converted with HSVToLinearRGB before the distance, like IsColorWithToleranceNotNearlyEqualNoAlpha. Alpha is compared
+	HSV,
+	// Perceptual Oklab of the linear color, equal distances look about equally different. Alpha is ignored
+	Oklab,
+	// CIELAB (D65) of the linear color divided by 100, the older perceptual space. Alpha is ignored
+	CIELAB
+};
+
+/**
+ * One case of a Switch on Bitmask node
+ */
+USTRUCT(BlueprintType)
+struct EXTRASWITCHSTATEMENTSRUNTIME_API FExtraSwitchBitmaskCase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Switch Comparisons", meta = (Bitmask))
+	int32 Mask = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Switch Comparisons")
+	EExtraSwitchBitmaskTest Test = EExtraSwitchBitmaskTest::All;
+};
 
 /**
  * This struct is used to pass additional data to the comparison function, the comparison function is static and takes two arguments, the first is the vector to compare
@@ -15,14 +92,15 @@ struct FVectorAndTolerance
 {
 	GENERATED_BODY()
 
+	// Double like FVector so case points in a large world keep their precision
 	UPROPERTY()
-	float X = 0.0f;
+	double X = 0.0;
 
 	UPROPERTY()
-	float Y = 0.0f;
+	double Y = 0.0;
 
 	UPROPERTY()
-	float Z = 0.f;
+	double Z = 0.0;
 
 	UPROPERTY(EditAnywhere, Category = PinOptions)
 	float Tolerance = 0.1f;
@@ -86,20 +164,23 @@ struct FSwitchIntRange
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, Category = PinOptions, meta = (NoSpinbox = true))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PinOptions, meta = (NoSpinbox = true))
 	int RangeMax = 0;
 
-	UPROPERTY(EditAnywhere, Category = PinOptions)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PinOptions)
 	int RangeMin = 0;
 
-	UPROPERTY(EditAnywhere, Category = PinOptions)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PinOptions)
 	bool Inclusive = true;
 };
 
 /**
- * Blueprint Function Library containing the comparator functions used by the ExtraBlueprintSwitchStatements plugin
+ * Blueprint Function Library containing the comparator functions used by the ExtraBlueprintSwitchStatements plugin.
+ * Every function only reads its arguments and the case table, which is never written after the blueprint compiled,
+ * so the switch nodes can run in thread safe functions such as Animation Blueprint worker thread updates.
+ * The cached and hysteresis lookups write their CaseSlot, which belongs to the calling frame.
  */
-UCLASS()
+UCLASS(meta = (BlueprintThreadSafe))
 class EXTRASWITCHSTATEMENTSRUNTIME_API UExtraSwitchComparatorsFunctionLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
@@ -153,11 +234,283 @@ public:
 
 
 	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
-	static bool IsIntNotWithinRange(int& A, FSwitchIntRange& B);
+	static bool IsIntNotWithinRange(int32 A, const FSwitchIntRange& B);
 
 
 	// Use int32 for both parameters, matching SwitchOnInt
 	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
 	static bool AreIntsNotEqual(int32 A, int32 B);
 
+	// Used by Switch on Name Set when it is compiled through the stock per-pin comparator chain
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static bool AreNamesNotEqual(FName A, FName B);
+
+	/**
+	 * Used by Switch on Gameplay Tag when it is compiled through the stock per-pin comparator chain
+	 * @param A - The selection tag
+	 * @param B - The case tag
+	 * @return True if A is not exactly B
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static bool AreGameplayTagsNotEqual(const FGameplayTag& A, const FGameplayTag& B);
+
+	/**
+	 * Used by Switch on Bitmask when it is compiled through the stock per-pin comparator chain
+	 * @param A - The selection flags
+	 * @param B - The case mask and how it is tested
+	 * @return True if A does not pass the case's test
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static bool IsBitmaskNotMatching(int32 A, const FExtraSwitchBitmaskCase& B);
+
+	/**
+	 * Steps through every matching case of a Switch on Int Range compiled in AllMatches mode
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @param StartIndex - The lowest case index to consider
+	 * @return The lowest index >= StartIndex of a range containing A, or INDEX_NONE when there are no more
+	 */
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextIntRangeCaseIndex(int32 A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	// Float range version of FindNextIntRangeCaseIndex, A is compared at float precision
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextFloatRangeCaseIndex(double A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	// Switch on Float version of FindNextIntRangeCaseIndex, returns the next case within tolerance
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	// Switch on Vector version of FindNextIntRangeCaseIndex, returns the next case within tolerance
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextVectorCaseIndex(const FVector& A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	// Switch on Color version of FindNextIntRangeCaseIndex, returns the next case within tolerance
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextColorCaseIndex(const FLinearColor& A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	// Switch on Bitmask version of FindNextIntRangeCaseIndex, returns the next case whose test A passes
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNextBitmaskCaseIndex(int32 A, const UExtraSwitchCaseTable* Table, int32 StartIndex);
+
+	/**
+	 * Resolves the selection against the hashed names baked by a Switch on Name Set node
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the matching case pin, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindNameCaseIndex(FName A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the hashed tags baked by a Switch on Gameplay Tag node
+	 * @param A - The selection tag
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first matching case pin, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindGameplayTagCaseIndex(const FGameplayTag& A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the packed masks baked by a Switch on Bitmask node
+	 * @param A - The selection flags
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first case whose test A passes (the most specific one in BestMatch mode), or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindBitmaskCaseIndex(int32 A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the table baked by a Switch on Int Array node
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the matching case pin, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindIntArrayCaseIndex(int32 A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the merged range boundaries baked by a Switch on Int Range node
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first range containing A, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindIntRangeCaseIndex(int32 A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the merged range boundaries baked by a Switch on Float Range node
+	 * @param A - The selection value, compared at float precision like IsFloatNotWithinRange
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first range containing A, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFloatRangeCaseIndex(double A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection of a Switch on Float Range node with a hysteresis margin, see UExtraSwitchCaseTable::FindFloatRangeCaseWithHysteresis
+	 * @param A - The selection value, compared at float precision like IsFloatNotWithinRange
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @param CaseSlot - The node's per-object state in the event graph frame, read and updated by the call
+	 * @return The index of the range to execute, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFloatRangeCaseIndexWithHysteresis(double A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	/**
+	 * Resolves the selection against the packed case floats baked by a Switch on Float node
+	 * @param A - The selection value, compared at float precision like IsFloatWithToleranceNotNearlyEqual
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first case within tolerance of A, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the packed case vectors baked by a Switch on Vector node
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first case within tolerance of A, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindVectorCaseIndex(const FVector& A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection against the packed case colors baked by a Switch on Color node
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @return The index of the first case within tolerance of A, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindColorCaseIndex(const FLinearColor& A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection through a chain of Int Array, Int Range and Bitmask switches that was fused into one table at compile time
+	 * @param A - The selection value shared by every switch in the chain
+	 * @param Table - The fused table baked when the blueprint was compiled
+	 * @return The outcome of the switch that ran last, see UExtraSwitchCaseTable::GetFusedOutcome
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFusedIntCaseIndex(int32 A, const UExtraSwitchCaseTable* Table);
+
+	// Float Range and Float version of FindFusedIntCaseIndex
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFusedFloatCaseIndex(double A, const UExtraSwitchCaseTable* Table);
+
+	/**
+	 * Resolves the selection of a Switch on Int Array node with Cache Last Case, the previous case is re-checked with one compare before searching
+	 * @param A - The selection value
+	 * @param Table - The case table baked when the blueprint was compiled
+	 * @param CaseSlot - The node's per-object state in the event graph frame, read and updated by the call
+	 * @return The index of the case to execute, or INDEX_NONE if the default pin should execute
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindIntArrayCaseIndexCached(int32 A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	// Switch on Int Range version of FindIntArrayCaseIndexCached, only used when the ranges are disjoint
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindIntRangeCaseIndexCached(int32 A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	// Switch on Float Range version of FindIntArrayCaseIndexCached, only used when the ranges are disjoint
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFloatRangeCaseIndexCached(double A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	// Switch on Float version of FindIntArrayCaseIndexCached, only used when no two cases are within tolerance of the same value
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindFloatCaseIndexCached(double A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	// Switch on Vector version of FindFloatCaseIndexCached
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindVectorCaseIndexCached(const FVector& A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	// Switch on Color version of FindFloatCaseIndexCached
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons", meta = (BlueprintInternalUseOnly = "TRUE"))
+	static int32 FindColorCaseIndexCached(const FLinearColor& A, const UExtraSwitchCaseTable* Table, UPARAM(ref) int32& CaseSlot);
+
+	/**
+	 * Classifies a whole array of ints against a Switch on Int Array case list in one call
+	 * @param Values - The values to classify
+	 * @param CaseValues - The switch's case values, duplicates resolve to the first index
+	 * @param OutCaseIndices - For each value, the index of the matching case or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyIntsBySet(const TArray<int32>& Values, const TArray<int32>& CaseValues, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Classifies a whole array of ints against a Switch on Int Range case list in one call
+	 * @param Values - The values to classify
+	 * @param Ranges - The switch's ranges, the first range containing a value wins
+	 * @param OutCaseIndices - For each value, the index of the matching range or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyIntsByRange(const TArray<int32>& Values, const TArray<FSwitchIntRange>& Ranges, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Classifies a whole array of floats against a Switch on Float Range case list in one call
+	 * @param Values - The values to classify, compared at float precision like the switch node
+	 * @param Ranges - The switch's ranges, the first range containing a value wins
+	 * @param OutCaseIndices - For each value, the index of the matching range or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyFloatsByRange(const TArray<double>& Values, const TArray<FExtraSwitchFloatRange>& Ranges, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Classifies a whole array of floats against a Switch on Float case list in one call
+	 * @param Values - The values to classify, compared at float precision like the switch node
+	 * @param CaseValues - The switch's case values
+	 * @param Tolerance - The switch's tolerance
+	 * @param OutCaseIndices - For each value, the index of the first case within tolerance or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyFloatsByTolerance(const TArray<double>& Values, const TArray<double>& CaseValues, float Tolerance, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Classifies a whole array of vectors against a Switch on Vector case list in one call
+	 * @param Values - The vectors to classify
+	 * @param CaseValues - The switch's case vectors
+	 * @param Tolerance - The switch's tolerance
+	 * @param OutCaseIndices - For each vector, the index of the first case within tolerance or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyVectors(const TArray<FVector>& Values, const TArray<FVector>& CaseValues, float Tolerance, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Classifies a whole array of colors against a Switch on Color case list in one call
+	 * @param Values - The colors to classify
+	 * @param CaseValues - The switch's case colors
+	 * @param Tolerance - The switch's distance
+	 * @param bUseAlpha - Matches the node's UseAlpha option, when false both sides are converted with HSVToLinearRGB like IsColorWithToleranceNotNearlyEqualNoAlpha
+	 * @param OutCaseIndices - For each color, the index of the first case within tolerance or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyColors(const TArray<FLinearColor>& Values, const TArray<FLinearColor>& CaseValues, float Tolerance, bool bUseAlpha, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * ClassifyColors comparing in any of the Switch on Color comparison spaces
+	 * @param ColorSpace - Matches the node's Comparison Space option
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyColorsInSpace(const TArray<FLinearColor>& Values, const TArray<FLinearColor>& CaseValues, float Tolerance, EExtraSwitchColorSpace ColorSpace, TArray<int32>& OutCaseIndices);
+
+	/**
+	 * Converts a color into the space a Switch on Color compares in, the distance between two converted colors is the one tested against the tolerance
+	 * @param Color - The color as entered on the node or passed to the selection pin
+	 * @param ColorSpace - The node's Comparison Space option
+	 */
+	UFUNCTION(BlueprintPure, Category = "Switch Comparisons")
+	static FLinearColor ConvertToColorComparisonSpace(const FLinearColor& Color, EExtraSwitchColorSpace ColorSpace);
+
+	/**
+	 * Classifies a whole array of flag values against a Switch on Bitmask case list in one call
+	 * @param Values - The flag values to classify
+	 * @param Cases - The switch's masks and tests
+	 * @param OutCaseIndices - For each value, the index of the first case whose test it passes or INDEX_NONE (-1) for the default case
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Switch Comparisons|Batch")
+	static void ClassifyBitmasks(const TArray<int32>& Values, const TArray<FExtraSwitchBitmaskCase>& Cases, TArray<int32>& OutCaseIndices);
+
+	// Used by the compiled switch dispatch to binary search the case index returned by the Find*CaseIndex functions
+	UFUNCTION(BlueprintPure, Category = PinOptions, meta = (BlueprintInternalUseOnly = "TRUE"))
+	static bool IsCaseIndexBelow(int32 CaseIndex, int32 Bound);
+
 };
\ No newline at end of file
@@ -0,0 +1,1176 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+#include "Algo/Sort.h"
+
+/**
+ * Native switch dispatch shared by gameplay code and the compiled blueprint switch nodes.
+ * Each switch is built once from its case table and then resolves a value to the index of the first matching case,
+ * or INDEX_NONE when no case matches (the default pin of the blueprint nodes).
+ * The static *Table functions work on plain arrays so UExtraSwitchCaseTable can serialize the same data the switches use.
+ */
+namespace ExtraSwitch
+{
+	/**
+	 * Compiled switches that remember their last case per object keep it in an int of the event graph frame, which starts zeroed,
+	 * so the slot stores the case index + 2: 0 means not evaluated yet and 1 the default pin
+	 */
+	constexpr int32 CaseSlotNotEvaluated = 0;
+
+	FORCEINLINE int32 EncodeCaseSlot(int32 CaseIndex)
+	{
+		return CaseIndex + 2;
+	}
+
+	FORCEINLINE int32 DecodeCaseSlot(int32 CaseSlot)
+	{
+		return CaseSlot - 2;
+	}
+
+	/** Tolerance test used by the float switch, matches FMath::IsNearlyEqual as used by IsFloatWithToleranceNotNearlyEqual */
+	FORCEINLINE bool IsWithinTolerance(float A, float B, float Tolerance)
+	{
+		return FMath::Abs(A - B) <= Tolerance;
+	}
+
+	/** Tolerance test used by the vector switch, the distance is truncated to float like IsVectorWithToleranceNotNearlyEqual did */
+	FORCEINLINE bool IsWithinTolerance(const FVector& A, const FVector& B, float Tolerance)
+	{
+		const float Distance = FVector::Dist(A, B);
+		return !(Distance > Tolerance);
+	}
+
+	/** Tolerance test used by the color switch, matches IsColorWithToleranceNotNearlyEqual */
+	FORCEINLINE bool IsWithinTolerance(const FLinearColor& A, const FLinearColor& B, float Tolerance)
+	{
+		const float Distance = FLinearColor::Dist(A, B);
+		return !(Distance > Tolerance);
+	}
+
+	/** Cube root that keeps the sign, the perceptual spaces below take it of the cone responses which go negative outside the sRGB gamut */
+	FORCEINLINE float SignedCbrt(float Value)
+	{
+		return FMath::Sign(Value) * FMath::Pow(FMath::Abs(Value), 1.0f / 3.0f);
+	}
+
+	/** Oklab (L, a, b) of a linear sRGB color in R, G and B with A set to 0, so the color switch's 4-wide distance ignores alpha */
+	inline FLinearColor LinearRGBToOklab(const FLinearColor& Color)
+	{
+		const float L = SignedCbrt(0.4122214708f * Color.R + 0.5363325363f * Color.G + 0.0514459929f * Color.B);
+		const float M = SignedCbrt(0.2119034982f * Color.R + 0.6806995451f * Color.G + 0.1073969566f * Color.B);
+		const float S = SignedCbrt(0.0883024619f * Color.R + 0.2817188376f * Color.G + 0.6299787005f * Color.B);
+
+		return FLinearColor(
+			0.2104542553f * L + 0.7936177850f * M - 0.0040720468f * S,
+			1.9779984951f * L - 2.4285922050f * M + 0.4505937099f * S,
+			0.0259040371f * L + 0.7827717662f * M - 0.8086757660f * S,
+			0.0f);
+	}
+
+	/**
+	 * CIELAB (L*, a*, b*) of a linear sRGB color against the D65 white point, divided by 100 so L* spans 0 to 1 like Oklab's L
+	 * and a tolerance means roughly the same in both spaces. A is set to 0 like LinearRGBToOklab.
+	 */
+	inline FLinearColor LinearRGBToCIELab(const FLinearColor& Color)
+	{
+		auto F = [](float T)
+		{
+			constexpr float Delta = 6.0f / 29.0f;
+			return T > Delta * Delta * Delta ? SignedCbrt(T) : T / (3.0f * Delta * Delta) + 4.0f / 29.0f;
+		};
+
+		const float X = F((0.4124564f * Color.R + 0.3575761f * Color.G + 0.1804375f * Color.B) / 0.95047f);
+		const float Y = F(0.2126729f * Color.R + 0.7151522f * Color.G + 0.0721750f * Color.B);
+		const float Z = F((0.0193339f * Color.R + 0.1191920f * Color.G + 0.9503041f * Color.B) / 1.08883f);
+
+		return FLinearColor(1.16f * Y - 0.16f, 5.0f * (X - Y), 2.0f * (Y - Z), 0.0f);
+	}
+
+	/** Splits a TToleranceSwitch value into the float or double components its SIMD search compares */
+	template<typename T>
+	struct TToleranceTraits;
+
+	template<>
+	struct TToleranceTraits<float>
+	{
+		static constexpr int32 NumComponents = 1;
+		template<typename FReal>
+		static void ToComponents(float Value, FReal* OutComponents)
+		{
+			OutComponents[0] = (FReal)Value;
+		}
+	};
+
+	template<>
+	struct TToleranceTraits<FVector>
+	{
+		static constexpr int32 NumComponents = 3;
+		template<typename FReal>
+		static void ToComponents(const FVector& Value, FReal* OutComponents)
+		{
+			OutComponents[0] = (FReal)Value.X;
+			OutComponents[1] = (FReal)Value.Y;
+			OutComponents[2] = (FReal)Value.Z;
+		}
+	};
+
+	template<>
+	struct TToleranceTraits<FLinearColor>
+	{
+		static constexpr int32 NumComponents = 4;
+		template<typename FReal>
+		static void ToComponents(const FLinearColor& Value, FReal* OutComponents)
+		{
+			OutComponents[0] = Value.R;
+			OutComponents[1] = Value.G;
+			OutComponents[2] = Value.B;
+			OutComponents[3] = Value.A;
+		}
+	};
+
+	/** The 4-wide register a TToleranceSwitch searches with, double planes take VectorRegister4Double */
+	template<typename FReal>
+	using TToleranceRegister = std::conditional_t<std::is_same_v<FReal, double>, VectorRegister4Double, VectorRegister4Float>;
+
+	/**
+	 * Center of the bounds of the case vectors, the origin UExtraSwitchCaseTable measures a vector switch from.
+	 * The offsets from it are as small as the spread of the cases, so they keep their precision when truncated to float
+	 * however far from the world origin the cases are.
+	 */
+	inline FVector GetCaseOrigin(TConstArrayView<FVector> CaseValues)
+	{
+		if (CaseValues.Num() == 0)
+		{
+			return FVector::ZeroVector;
+		}
+		return FBox(CaseValues.GetData(), CaseValues.Num()).GetCenter();
+	}
+
+	/**
+	 * True when no value can be within Tolerance of two different cases, the order the cases are tested in then can't change the result.
+	 * Cases must be more than twice the tolerance apart, with a small margin for the float rounding of the runtime distance.
+	 */
+	template<typename T>
+	bool AreToleranceCasesDisjoint(TConstArrayView<T> CaseValues, float Tolerance)
+	{
+		if (Tolerance < 0.0f)
+		{
+			return true;
+		}
+
+		using FTraits = TToleranceTraits<T>;
+		const double MinDistance = 2.0 * Tolerance * (1.0 + UE_KINDA_SMALL_NUMBER) + UE_KINDA_SMALL_NUMBER;
+		for (int32 First = 0; First < CaseValues.Num(); ++First)
+		{
+			double FirstComponents[FTraits::NumComponents];
+			FTraits::ToComponents(CaseValues[First], FirstComponents);
+			for (int32 Second = First + 1; Second < CaseValues.Num(); ++Second)
+			{
+				double SecondComponents[FTraits::NumComponents];
+				FTraits::ToComponents(CaseValues[Second], SecondComponents);
+
+				double DistanceSquared = 0.0;
+				for (int32 Component = 0; Component < FTraits::NumComponents; ++Component)
+				{
+					DistanceSquared += FMath::Square(FirstComponents[Component] - SecondComponents[Component]);
+				}
+				if (DistanceSquared <= MinDistance * MinDistance)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+/**
+ * Switch over an arbitrary set of ints.
+ * When the case values fill enough of the span between the lowest and highest one the table is a dense jump table
+ * (value minus the lowest value indexes the case, INDEX_NONE marks the holes) and a lookup is one bounds check and one load,
+ * sparser sets fall back to an O(log N) binary search over the sorted values.
+ * Duplicate values resolve to the lowest case index.
+ */
+class TIntSetSwitch
+{
+public:
+	// The share of the value span that must be case values before BuildTable picks the dense jump table, {100..140} minus a few is well above it
+	static constexpr float DefaultMinDenseFill = 0.5f;
+
+	// Dense tables never grow past this many entries, whatever the fill
+	static constexpr int32 MaxDenseEntries = 64 * 1024;
+
+	TIntSetSwitch() = default;
+
+	explicit TIntSetSwitch(TConstArrayView<int32> CaseValues, float MinDenseFill = DefaultMinDenseFill)
+	{
+		Build(CaseValues, MinDenseFill);
+	}
+
+	void Build(TConstArrayView<int32> CaseValues, float MinDenseFill = DefaultMinDenseFill)
+	{
+		BuildTable(CaseValues, Values, CaseIndices, bDense, MinDenseFill);
+	}
+
+	int32 Find(int32 Value) const
+	{
+		return FindInTable(Value, Values, CaseIndices, bDense);
+	}
+
+	/**
+	 * @param bOutDense - True when a jump table was built, OutValues then only holds the lowest case value and OutCaseIndices
+	 *                    holds the case index of every value from it up to the highest one, INDEX_NONE for the holes
+	 * @param MinDenseFill - Number of distinct case values divided by their span at or above which the jump table is built,
+	 *                       1 only accepts contiguous values and anything above 1 always uses the binary search
+	 */
+	static void BuildTable(TConstArrayView<int32> CaseValues, TArray<int32>& OutValues, TArray<int32>& OutCaseIndices, bool& bOutDense,
+		float MinDenseFill = DefaultMinDenseFill)
+	{
+		TArray<TPair<int32, int32>> SortedCases;
+		SortedCases.Reserve(CaseValues.Num());
+		for (int32 Index = 0; Index < CaseValues.Num(); ++Index)
+		{
+			SortedCases.Emplace(CaseValues[Index], Index);
+		}
+
+		// Sort by value, then by case index so the first entry of every run of duplicates is the one a first-match chain would hit
+		SortedCases.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+		OutValues.Reset(SortedCases.Num());
+		OutCaseIndices.Reset(SortedCases.Num());
+		for (const TPair<int32, int32>& Case : SortedCases)
+		{
+			if (OutValues.Num() == 0 || OutValues.Last() != Case.Key)
+			{
+				OutValues.Add(Case.Key);
+				OutCaseIndices.Add(Case.Value);
+			}
+		}
+
+		bOutDense = false;
+		if (OutValues.Num() == 0)
+		{
+			return;
+		}
+
+		const int64 Span = (int64)OutValues.Last() - (int64)OutValues[0] + 1;
+		if (Span > MaxDenseEntries || (double)OutValues.Num() < (double)Span * MinDenseFill)
+		{
+			return;
+		}
+
+		TArray<int32> DenseCaseIndices;
+		DenseCaseIndices.Init(INDEX_NONE, (int32)Span);
+		for (int32 Entry = 0; Entry < OutValues.Num(); ++Entry)
+		{
+			DenseCaseIndices[(int32)((int64)OutValues[Entry] - (int64)OutValues[0])] = OutCaseIndices[Entry];
+		}
+
+		OutValues.SetNum(1);
+		OutCaseIndices = MoveTemp(DenseCaseIndices);
+		bOutDense = true;
+	}
+
+	static int32 FindInTable(int32 Value, TConstArrayView<int32> Values, TConstArrayView<int32> CaseIndices, bool bDense)
+	{
+		if (Values.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		if (bDense)
+		{
+			// Values below the lowest case wrap around to a huge offset, so one unsigned compare covers both ends
+			const uint64 Offset = (uint64)((int64)Value - (int64)Values[0]);
+			return Offset < (uint64)CaseIndices.Num() ? CaseIndices[(int32)Offset] : INDEX_NONE;
+		}
+
+		const int32 Found = Algo::BinarySearch(Values, Value);
+		return Found != INDEX_NONE ? CaseIndices[Found] : INDEX_NONE;
+	}
+
+private:
+	TArray<int32> Values;
+	TArray<int32> CaseIndices;
+	bool bDense = false;
+};
+
+/**
+ * Switch over an arbitrary set of hashable keys such as FName or FGameplayTag, resolved with a single O(1) map lookup.
+ * Duplicate keys resolve to the lowest case index.
+ */
+template<typename KeyType>
+class THashSetSwitch
+{
+public:
+	THashSetSwitch() = default;
+
+	explicit THashSetSwitch(TConstArrayView<KeyType> CaseValues)
+	{
+		Build(CaseValues);
+	}
+
+	void Build(TConstArrayView<KeyType> CaseValues)
+	{
+		BuildTable(CaseValues, CaseIndices);
+	}
+
+	int32 Find(const KeyType& Value) const
+	{
+		return FindInTable(Value, CaseIndices);
+	}
+
+	static void BuildTable(TConstArrayView<KeyType> CaseValues, TMap<KeyType, int32>& OutCaseIndices)
+	{
+		OutCaseIndices.Reset();
+		OutCaseIndices.Reserve(CaseValues.Num());
+		for (int32 Index = 0; Index < CaseValues.Num(); ++Index)
+		{
+			// Keep the first index of a duplicate, that is the pin a first-match comparator chain would hit
+			if (!OutCaseIndices.Contains(CaseValues[Index]))
+			{
+				OutCaseIndices.Add(CaseValues[Index], Index);
+			}
+		}
+	}
+
+	static int32 FindInTable(const KeyType& Value, const TMap<KeyType, int32>& CaseIndices)
+	{
+		const int32* Found = CaseIndices.Find(Value);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+private:
+	TMap<KeyType, int32> CaseIndices;
+};
+
+/**
+ * Switch over flag values where every case is a mask with an Any, All or Exact test.
+ * The three tests are folded into one form at build time, case i matches when ((Value & AndMasks[i]) ^ Expected[i]) == 0 differs from Negate[i],
+ * so a lookup is a single AND and compare pass over packed arrays without branching on the kind of test.
+ */
+template<typename T>
+class TBitmaskSwitch
+{
+	static_assert(std::is_unsigned_v<T>, "TBitmaskSwitch works on uint32 or uint64 flags");
+
+public:
+	// Same order as EExtraSwitchBitmaskTest
+	enum class ETest : uint8
+	{
+		Any,
+		All,
+		Exact
+	};
+
+	struct FCase
+	{
+		T Mask;
+		ETest Test;
+	};
+
+	TBitmaskSwitch() = default;
+
+	explicit TBitmaskSwitch(TConstArrayView<FCase> Cases)
+	{
+		Build(Cases);
+	}
+
+	void Build(TConstArrayView<FCase> Cases)
+	{
+		BuildTable(Cases, AndMasks, Expected, Negate, Specificity);
+	}
+
+	int32 Find(T Value) const
+	{
+		return FindInTable(Value, AndMasks, Expected, Negate);
+	}
+
+	// Converts any struct with Mask and Test members whose test enum has the same order as ETest, such as FExtraSwitchBitmaskCase
+	template<typename CaseType>
+	static TArray<FCase> MakeCases(TConstArrayView<CaseType> Cases)
+	{
+		TArray<FCase> Result;
+		Result.Reserve(Cases.Num());
+		for (const CaseType& Case : Cases)
+		{
+			Result.Add({ (T)Case.Mask, (ETest)Case.Test });
+		}
+		return Result;
+	}
+
+	static bool Matches(const FCase& Case, T Value)
+	{
+		switch (Case.Test)
+		{
+		case ETest::Any:
+			return (Value & Case.Mask) != 0;
+		case ETest::All:
+			return (Value & Case.Mask) == Case.Mask;
+		default:
+			return Value == Case.Mask;
+		}
+	}
+
+	/**
+	 * @param OutSpecificity - How narrow each case is, the number of mask flags and one more than every flag for Exact cases, used by FindBestInTable
+	 */
+	static void BuildTable(TConstArrayView<FCase> Cases, TArray<T>& OutAndMasks, TArray<T>& OutExpected, TArray<uint8>& OutNegate, TArray<uint8>& OutSpecificity)
+	{
+		OutAndMasks.Reset(Cases.Num());
+		OutExpected.Reset(Cases.Num());
+		OutNegate.Reset(Cases.Num());
+		OutSpecificity.Reset(Cases.Num());
+		for (const FCase& Case : Cases)
+		{
+			const bool bExact = Case.Test == ETest::Exact;
+			OutAndMasks.Add(bExact ? ~T(0) : Case.Mask);
+			OutExpected.Add(Case.Test == ETest::Any ? T(0) : Case.Mask);
+			OutNegate.Add(Case.Test == ETest::Any ? 1 : 0);
+			OutSpecificity.Add(bExact ? uint8(sizeof(T) * 8 + 1) : uint8(FMath::CountBits((uint64)Case.Mask)));
+		}
+	}
+
+	/**
+	 * @param StartIndex - The lowest case index to consider, pass the last result + 1 to step through every matching case
+	 * @return The lowest case index >= StartIndex whose test Value passes, or INDEX_NONE when there are no more
+	 */
+	static int32 FindInTable(T Value, TConstArrayView<T> AndMasks, TConstArrayView<T> Expected, TConstArrayView<uint8> Negate, int32 StartIndex = 0)
+	{
+		for (int32 CaseIndex = FMath::Max(StartIndex, 0); CaseIndex < AndMasks.Num(); ++CaseIndex)
+		{
+			if ((uint8)(((Value & AndMasks[CaseIndex]) ^ Expected[CaseIndex]) == 0) != Negate[CaseIndex])
+			{
+				return CaseIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// @return The matching case with the highest specificity, ties keep the lowest case index, or INDEX_NONE if none match
+	static int32 FindBestInTable(T Value, TConstArrayView<T> AndMasks, TConstArrayView<T> Expected, TConstArrayView<uint8> Negate, TConstArrayView<uint8> Specificity)
+	{
+		int32 Best = INDEX_NONE;
+		for (int32 CaseIndex = 0; CaseIndex < AndMasks.Num(); ++CaseIndex)
+		{
+			const bool bMatches = (uint8)(((Value & AndMasks[CaseIndex]) ^ Expected[CaseIndex]) == 0) != Negate[CaseIndex];
+			if (bMatches && (Best == INDEX_NONE || Specificity[CaseIndex] > Specificity[Best]))
+			{
+				Best = CaseIndex;
+			}
+		}
+		return Best;
+	}
+
+private:
+	TArray<T> AndMasks;
+	TArray<T> Expected;
+	TArray<uint8> Negate;
+	TArray<uint8> Specificity;
+};
+
+/**
+ * Switch over a list of [Min, Max] or (Min, Max) ranges, resolved with a single O(log N) binary search.
+ * All ranges are merged into one sorted boundary array, every open interval between two boundaries and every boundary value
+ * stores the lowest case index whose range contains it. Reversed ranges (Min > Max) never match, the same as the range comparators.
+ */
+template<typename T>
+class TRangeSwitch
+{
+public:
+	struct FCase
+	{
+		T Min;
+		T Max;
+		bool bInclusive;
+	};
+
+	TRangeSwitch() = default;
+
+	explicit TRangeSwitch(TConstArrayView<FCase> Cases)
+	{
+		Build(Cases);
+	}
+
+	void Build(TConstArrayView<FCase> Cases)
+	{
+		BuildTable(Cases, Boundaries, RegionCases);
+	}
+
+	int32 Find(T Value) const
+	{
+		return FindInTable(Value, Boundaries, RegionCases);
+	}
+
+	// Converts any struct with RangeMin, RangeMax and Inclusive members, such as FSwitchIntRange or FExtraSwitchFloatRange
+	template<typename RangeType>
+	static TArray<FCase> MakeCases(TConstArrayView<RangeType> Ranges)
+	{
+		TArray<FCase> Cases;
+		Cases.Reserve(Ranges.Num());
+		for (const RangeType& Range : Ranges)
+		{
+			Cases.Add({ Range.RangeMin, Range.RangeMax, Range.Inclusive });
+		}
+		return Cases;
+	}
+
+	// A run of values, for int ranges both ends are always inclusive
+	struct FInterval
+	{
+		T Low;
+		T High;
+		bool bLowInclusive;
+		bool bHighInclusive;
+	};
+
+	// A run of values between the lowest and highest covered value that no range contains, CaseBelow and CaseAbove are cases touching either end
+	struct FGap
+	{
+		FInterval Values;
+		int32 CaseBelow;
+		int32 CaseAbove;
+	};
+
+	struct FAnalysis
+	{
+		// Every pair of cases sharing at least one value, lower case index first
+		TArray<TPair<int32, int32>> Overlaps;
+
+		TArray<FGap> Gaps;
+
+		// From the lowest to the highest value any case contains, only valid if bAnyCovered
+		FInterval Span;
+
+		bool bAnyCovered = false;
+
+		// No value is contained by two cases, so the first, best and all matches of every value are the same single case
+		bool IsDisjoint() const { return Overlaps.Num() == 0; }
+
+		// Every value in Span executes a case
+		bool IsSpanCovered() const { return bAnyCovered && Gaps.Num() == 0; }
+	};
+
+	/**
+	 * Interval analysis over the same regions BuildTable uses, run once at compile time so the cost is O(regions * cases)
+	 * @return The overlapping cases, the gaps between them and the covered span
+	 */
+	static FAnalysis Analyze(TConstArrayView<FCase> Cases)
+	{
+		FAnalysis Analysis;
+
+		TArray<T> Boundaries;
+		BuildBoundaries(Cases, Boundaries);
+
+		TArray<int32> RegionMatches;
+		int32 LastCoveredRegion = INDEX_NONE;
+		int32 LastCase = INDEX_NONE;
+		int32 GapFirstRegion = INDEX_NONE;
+		int32 GapLastRegion = INDEX_NONE;
+		const int32 NumRegions = Boundaries.Num() * 2 + 1;
+		for (int32 Region = 0; Region < NumRegions; ++Region)
+		{
+			double Value;
+			if (!GetRegionValue(Boundaries, Region, Value) || !RegionHasValues(Boundaries, Region))
+			{
+				continue;
+			}
+
+			RegionMatches.Reset();
+			for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); ++CaseIndex)
+			{
+				if (Contains(Cases[CaseIndex], Value))
+				{
+					RegionMatches.Add(CaseIndex);
+				}
+			}
+
+			if (RegionMatches.Num() == 0)
+			{
+				// Only values between two covered regions are a gap, everything outside the span is plainly the default
+				if (LastCoveredRegion != INDEX_NONE)
+				{
+					GapFirstRegion = GapFirstRegion == INDEX_NONE ? Region : GapFirstRegion;
+					GapLastRegion = Region;
+				}
+				continue;
+			}
+
+			for (int32 First = 0; First < RegionMatches.Num(); ++First)
+			{
+				for (int32 Second = First + 1; Second < RegionMatches.Num(); ++Second)
+				{
+					Analysis.Overlaps.AddUnique(TPair<int32, int32>(RegionMatches[First], RegionMatches[Second]));
+				}
+			}
+
+			if (GapFirstRegion != INDEX_NONE)
+			{
+				Analysis.Gaps.Add({ MakeInterval(Boundaries, GapFirstRegion, GapLastRegion), LastCase, RegionMatches[0] });
+				GapFirstRegion = INDEX_NONE;
+			}
+
+			if (!Analysis.bAnyCovered)
+			{
+				Analysis.Span = MakeInterval(Boundaries, Region, Region);
+				Analysis.bAnyCovered = true;
+			}
+			const FInterval Last = MakeInterval(Boundaries, Region, Region);
+			Analysis.Span.High = Last.High;
+			Analysis.Span.bHighInclusive = Last.bHighInclusive;
+
+			LastCoveredRegion = Region;
+			LastCase = RegionMatches.Last();
+		}
+		return Analysis;
+	}
+
+	template<typename ValueType>
+	static bool Contains(const FCase& Case, ValueType Value)
+	{
+		if (Case.Min > Case.Max)
+		{
+			return false;
+		}
+		return Case.bInclusive ? (Case.Min <= Value && Value <= Case.Max) : (Case.Min < Value && Value < Case.Max);
+	}
+
+	/**
+	 * Region 2 * i of OutRegionCases is the open interval below OutBoundaries[i], region 2 * i + 1 is the boundary value itself
+	 * and the last region lies above every boundary
+	 * @param bPreferNarrowest - When true each region stores the narrowest range containing it instead of the first one (ties keep the lowest case index)
+	 */
+	static void BuildTable(TConstArrayView<FCase> Cases, TArray<T>& OutBoundaries, TArray<int32>& OutRegionCases, bool bPreferNarrowest = false)
+	{
+		BuildBoundaries(Cases, OutBoundaries);
+
+		// Built once, so the linear scan keeps the winner rule identical to a first-match comparator chain
+		auto FindWinner = [&Cases, bPreferNarrowest](double Value) -> int32
+		{
+			int32 Winner = INDEX_NONE;
+			for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); ++CaseIndex)
+			{
+				if (Contains(Cases[CaseIndex], Value))
+				{
+					if (!bPreferNarrowest)
+					{
+						return CaseIndex;
+					}
+					if (Winner == INDEX_NONE || GetWidth(Cases[CaseIndex]) < GetWidth(Cases[Winner]))
+					{
+						Winner = CaseIndex;
+					}
+				}
+			}
+			return Winner;
+		};
+
+		const int32 NumRegions = OutBoundaries.Num() * 2 + 1;
+		OutRegionCases.Reset(NumRegions);
+		for (int32 Region = 0; Region < NumRegions; ++Region)
+		{
+			double Value;
+			OutRegionCases.Add(GetRegionValue(OutBoundaries, Region, Value) ? FindWinner(Value) : INDEX_NONE);
+		}
+	}
+
+	static int32 FindInTable(T Value, TConstArrayView<T> Boundaries, TConstArrayView<int32> RegionCases)
+	{
+		if (RegionCases.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+		return RegionCases[FindRegion(Value, Boundaries)];
+	}
+
+	/**
+	 * Same regions as BuildTable, but every region stores all the ranges containing it in ascending case order.
+	 * The cases of region R are OutRegionCases[OutRegionOffsets[R]] up to OutRegionCases[OutRegionOffsets[R + 1]].
+	 */
+	static void BuildAllMatchesTable(TConstArrayView<FCase> Cases, TArray<T>& OutBoundaries, TArray<int32>& OutRegionOffsets, TArray<int32>& OutRegionCases)
+	{
+		BuildBoundaries(Cases, OutBoundaries);
+
+		const int32 NumRegions = OutBoundaries.Num() * 2 + 1;
+		OutRegionOffsets.Reset(NumRegions + 1);
+		OutRegionCases.Reset();
+		for (int32 Region = 0; Region < NumRegions; ++Region)
+		{
+			OutRegionOffsets.Add(OutRegionCases.Num());
+
+			double Value;
+			if (GetRegionValue(OutBoundaries, Region, Value))
+			{
+				for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); ++CaseIndex)
+				{
+					if (Contains(Cases[CaseIndex], Value))
+					{
+						OutRegionCases.Add(CaseIndex);
+					}
+				}
+			}
+		}
+		OutRegionOffsets.Add(OutRegionCases.Num());
+	}
+
+	/**
+	 * @param StartIndex - The lowest case index to consider, pass the last result + 1 to step through every matching case
+	 * @return The lowest case index >= StartIndex whose range contains Value, or INDEX_NONE when there are no more
+	 */
+	static int32 FindNextInTable(T Value, int32 StartIndex, TConstArrayView<T> Boundaries, TConstArrayView<int32> RegionOffsets, TConstArrayView<int32> RegionCases)
+	{
+		if (RegionOffsets.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Region = FindRegion(Value, Boundaries);
+		for (int32 Entry = RegionOffsets[Region]; Entry < RegionOffsets[Region + 1]; ++Entry)
+		{
+			if (RegionCases[Entry] >= StartIndex)
+			{
+				return RegionCases[Entry];
+			}
+		}
+		return INDEX_NONE;
+	}
+
+private:
+	static void BuildBoundaries(TConstArrayView<FCase> Cases, TArray<T>& OutBoundaries)
+	{
+		OutBoundaries.Reset(Cases.Num() * 2);
+		for (const FCase& Case : Cases)
+		{
+			if (Case.Min <= Case.Max)
+			{
+				OutBoundaries.Add(Case.Min);
+				OutBoundaries.Add(Case.Max);
+			}
+		}
+
+		OutBoundaries.Sort();
+		OutBoundaries.SetNum(Algo::Unique(OutBoundaries));
+	}
+
+	/**
+	 * Any value strictly between two neighbouring boundaries behaves the same for every range, so the midpoint represents the whole interval.
+	 * Returns false for the regions below and above every boundary, no range can contain them.
+	 */
+	static bool GetRegionValue(TConstArrayView<T> Boundaries, int32 Region, double& OutValue)
+	{
+		const int32 Boundary = Region / 2;
+		if (Boundary >= Boundaries.Num() || (Region % 2 == 0 && Boundary == 0))
+		{
+			return false;
+		}
+
+		OutValue = Region % 2 == 1 ? (double)Boundaries[Boundary] : ((double)Boundaries[Boundary - 1] + (double)Boundaries[Boundary]) * 0.5;
+		return true;
+	}
+
+	// Open regions between two neighbouring ints hold no int at all
+	static bool RegionHasValues(TConstArrayView<T> Boundaries, int32 Region)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			if (Region % 2 == 0)
+			{
+				const int32 Boundary = Region / 2;
+				return (int64)Boundaries[Boundary] - (int64)Boundaries[Boundary - 1] > 1;
+			}
+		}
+		return true;
+	}
+
+	// The values from the start of FirstRegion to the end of LastRegion, both must lie between the lowest and highest boundary
+	static FInterval MakeInterval(TConstArrayView<T> Boundaries, int32 FirstRegion, int32 LastRegion)
+	{
+		FInterval Interval;
+		Interval.bLowInclusive = FirstRegion % 2 == 1;
+		Interval.Low = Interval.bLowInclusive ? Boundaries[FirstRegion / 2] : Boundaries[FirstRegion / 2 - 1];
+		Interval.bHighInclusive = LastRegion % 2 == 1;
+		Interval.High = Boundaries[LastRegion / 2];
+
+		if constexpr (std::is_integral_v<T>)
+		{
+			if (!Interval.bLowInclusive)
+			{
+				++Interval.Low;
+			}
+			if (!Interval.bHighInclusive)
+			{
+				--Interval.High;
+			}
+			Interval.bLowInclusive = true;
+			Interval.bHighInclusive = true;
+		}
+		return Interval;
+	}
+
+	static int32 FindRegion(T Value, TConstArrayView<T> Boundaries)
+	{
+		const int32 Boundary = Algo::LowerBound(Boundaries, Value);
+		const bool bOnBoundary = Boundary < Boundaries.Num() && Boundaries[Boundary] == Value;
+		return Boundary * 2 + (bOnBoundary ? 1 : 0);
+	}
+
+	static double GetWidth(const FCase& Case)
+	{
+		return (double)Case.Max - (double)Case.Min;
+	}
+
+	TArray<T> Boundaries;
+	TArray<int32> RegionCases;
+};
+
+/**
+ * Switch over a list of values that match within a per-case tolerance (float, FVector or FLinearColor), the first case within tolerance wins
+ * unless the nearest one is asked for.
+ * The case centers are packed into structure-of-arrays planes so every step of the search tests 4 cases at once
+ * with a squared distance compare, no square root is taken.
+ * The planes are float by default, FReal = double keeps large world coordinates exact at the cost of half as many cases per SSE instruction.
+ */
+template<typename T, typename FReal = float>
+class TToleranceSwitch
+{
+	using FTraits = ExtraSwitch::TToleranceTraits<T>;
+	using FRegister = ExtraSwitch::TToleranceRegister<FReal>;
+
+public:
+	static constexpr int32 NumComponents = FTraits::NumComponents;
+
+	TToleranceSwitch() = default;
+
+	TToleranceSwitch(TConstArrayView<T> CaseValues, float Tolerance)
+	{
+		Build(CaseValues, Tolerance);
+	}
+
+	void Build(TConstArrayView<T> CaseValues, float Tolerance)
+	{
+		TArray<float> Tolerances;
+		Tolerances.Init(Tolerance, CaseValues.Num());
+		Build(CaseValues, Tolerances);
+	}
+
+	void Build(TConstArrayView<T> CaseValues, TConstArrayView<float> Tolerances)
+	{
+		BuildTable(CaseValues, Tolerances, Components, TolerancesSquared);
+	}
+
+	int32 Find(const T& Value) const
+	{
+		return FindInTable(Value, Components, TolerancesSquared);
+	}
+
+	/**
+	 * OutComponents holds NumComponents planes of one entry per case, OutTolerancesSquared one entry per case.
+	 * Both are padded to a multiple of 4 cases, padding and negative tolerances get a squared tolerance of -1 so they never match.
+	 */
+	static void BuildTable(TConstArrayView<T> CaseValues, TConstArrayView<float> Tolerances, TArray<FReal>& OutComponents, TArray<FReal>& OutTolerancesSquared)
+	{
+		BuildTable(CaseValues, Tolerances, TConstArrayView<int32>(), OutComponents, OutTolerancesSquared);
+	}
+
+	/**
+	 * @param ScanOrder - When not empty, slot i of the table holds case ScanOrder[i] and the Find functions return slots instead of case indices.
+	 *                    Only use it when AreToleranceCasesDisjoint holds, otherwise the first match changes.
+	 */
+	static void BuildTable(TConstArrayView<T> CaseValues, TConstArrayView<float> Tolerances, TConstArrayView<int32> ScanOrder, TArray<FReal>& OutComponents, TArray<FReal>& OutTolerancesSquared)
+	{
+		check(CaseValues.Num() == Tolerances.Num());
+		check(ScanOrder.Num() == 0 || ScanOrder.Num() == CaseValues.Num());
+		const int32 NumPadded = Align(CaseValues.Num(), 4);
+
+		OutComponents.Init(0, NumPadded * NumComponents);
+		OutTolerancesSquared.Init(-1, NumPadded);
+		for (int32 Slot = 0; Slot < CaseValues.Num(); ++Slot)
+		{
+			const int32 CaseIndex = ScanOrder.Num() > 0 ? ScanOrder[Slot] : Slot;
+			FReal CaseComponents[NumComponents];
+			FTraits::ToComponents(CaseValues[CaseIndex], CaseComponents);
+			for (int32 Component = 0; Component < NumComponents; ++Component)
+			{
+				OutComponents[Component * NumPadded + Slot] = CaseComponents[Component];
+			}
+			const FReal Tolerance = (FReal)Tolerances[CaseIndex];
+			OutTolerancesSquared[Slot] = Tolerance >= 0 ? Tolerance * Tolerance : -1;
+		}
+	}
+
+	/**
+	 * @param StartIndex - The lowest case index to consider, pass the last result + 1 to step through every case within tolerance
+	 * @return The lowest case index >= StartIndex within tolerance of Value, or INDEX_NONE when there are no more
+	 */
+	static int32 FindInTable(const T& Value, TConstArrayView<FReal> Components, TConstArrayView<FReal> TolerancesSquared, int32 StartIndex = 0)
+	{
+		const int32 NumPadded = TolerancesSquared.Num();
+		checkSlow(Components.Num() == NumPadded * NumComponents);
+
+		FRegister ValueRegisters[NumComponents];
+		LoadValue(Value, ValueRegisters);
+
+		for (int32 Block = FMath::Max(StartIndex, 0) / 4 * 4; Block < NumPadded; Block += 4)
+		{
+			// One bit per case in the block, the lowest set bit is the first case within tolerance
+			uint32 Mask = (uint32)VectorMaskBits(VectorCompareLE(GetDistanceSquared(ValueRegisters, Components, Block), VectorLoad(TolerancesSquared.GetData() + Block)));
+			if (StartIndex > Block)
+			{
+				Mask &= ~0u << (StartIndex - Block);
+			}
+			if (Mask != 0)
+			{
+				return Block + (int32)FMath::CountTrailingZeros(Mask);
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Tests a single slot with the same 4-wide math as FindInTable, so the answer always agrees with a full search
+	 * @return True if Value is within the tolerance of the case in Slot
+	 */
+	static bool IsWithinToleranceOfSlot(const T& Value, TConstArrayView<FReal> Components, TConstArrayView<FReal> TolerancesSquared, int32 Slot)
+	{
+		if (!TolerancesSquared.IsValidIndex(Slot))
+		{
+			return false;
+		}
+
+		FRegister ValueRegisters[NumComponents];
+		LoadValue(Value, ValueRegisters);
+
+		const int32 Block = Slot / 4 * 4;
+		const uint32 Mask = (uint32)VectorMaskBits(VectorCompareLE(GetDistanceSquared(ValueRegisters, Components, Block), VectorLoad(TolerancesSquared.GetData() + Block)));
+		return (Mask & (1u << (Slot - Block))) != 0;
+	}
+
+	/**
+	 * Visits every case but still skips the square root, the nearest center within tolerance wins and ties keep the lowest case index
+	 * @return The index of the nearest case within tolerance of Value, or INDEX_NONE if no case is within tolerance
+	 */
+	static int32 FindNearestInTable(const T& Value, TConstArrayView<FReal> Components, TConstArrayView<FReal> TolerancesSquared)
+	{
+		const int32 NumPadded = TolerancesSquared.Num();
+		checkSlow(Components.Num() == NumPadded * NumComponents);
+
+		FRegister ValueRegisters[NumComponents];
+		LoadValue(Value, ValueRegisters);
+
+		int32 Nearest = INDEX_NONE;
+		FReal NearestDistanceSquared = 0;
+		for (int32 Block = 0; Block < NumPadded; Block += 4)
+		{
+			const FRegister DistanceSquared = GetDistanceSquared(ValueRegisters, Components, Block);
+			uint32 Mask = (uint32)VectorMaskBits(VectorCompareLE(DistanceSquared, VectorLoad(TolerancesSquared.GetData() + Block)));
+			if (Mask == 0)
+			{
+				continue;
+			}
+
+			alignas(32) FReal Distances[4];
+			VectorStoreAligned(DistanceSquared, Distances);
+			for (; Mask != 0; Mask &= Mask - 1)
+			{
+				const int32 Lane = (int32)FMath::CountTrailingZeros(Mask);
+				if (Nearest == INDEX_NONE || Distances[Lane] < NearestDistanceSquared)
+				{
+					Nearest = Block + Lane;
+					NearestDistanceSquared = Distances[Lane];
+				}
+			}
+		}
+		return Nearest;
+	}
+
+private:
+	static void LoadValue(const T& Value, FRegister* OutRegisters)
+	{
+		FReal ValueComponents[NumComponents];
+		FTraits::ToComponents(Value, ValueComponents);
+		for (int32 Component = 0; Component < NumComponents; ++Component)
+		{
+			OutRegisters[Component] = VectorSetFloat1(ValueComponents[Component]);
+		}
+	}
+
+	static FRegister GetDistanceSquared(const FRegister* ValueRegisters, TConstArrayView<FReal> Components, int32 Block)
+	{
+		const int32 NumPadded = Components.Num() / NumComponents;
+		FRegister DistanceSquared = VectorSetFloat1((FReal)0);
+		for (int32 Component = 0; Component < NumComponents; ++Component)
+		{
+			const FRegister Delta = VectorSubtract(VectorLoad(Components.GetData() + Component * NumPadded + Block), ValueRegisters[Component]);
+			DistanceSquared = VectorMultiplyAdd(Delta, Delta, DistanceSquared);
+		}
+		return DistanceSquared;
+	}
+
+	TArray<FReal> Components;
+	TArray<FReal> TolerancesSquared;
+};
+
+/**
+ * Nearest-neighbour switch over 3D case points that share one tolerance, backed by a static k-d tree.
+ * The tree is stored implicitly: every sub-range [Begin, End) of the arrays is a subtree whose root is its middle element,
+ * so building it is a recursive sort and the query needs no child pointers.
+ * A query visits O(log N) nodes for well spread points instead of every case, the nearest point wins and ties keep the lowest case index.
+ * The points are float by default like TToleranceSwitch<FVector>, FReal = double keeps them exact for the double precision planes.
+ */
+template<typename FReal = float>
+class TNearestVectorSwitch
+{
+	using FPoint = UE::Math::TVector<FReal>;
+	using FBounds = UE::Math::TBox<FReal>;
+
+public:
+	// Below this many cases the 4-wide linear search of TToleranceSwitch is faster than walking the tree
+	static constexpr int32 MinCasesForTree = 32;
+
+	TNearestVectorSwitch() = default;
+
+	TNearestVectorSwitch(TConstArrayView<FVector> CaseValues, float Tolerance)
+	{
+		Build(CaseValues, Tolerance);
+	}
+
+	void Build(TConstArrayView<FVector> CaseValues, float Tolerance)
+	{
+		BuildTable(CaseValues, Points, CaseIndices, SplitAxes);
+		ToleranceSquared = GetToleranceSquared(Tolerance);
+	}
+
+	int32 Find(const FVector& Value) const
+	{
+		return FindInTable(Value, ToleranceSquared, Points, CaseIndices, SplitAxes);
+	}
+
+	// The squared tolerance FindInTable takes, squared in FReal like TToleranceSwitch squares it so both agree on the edge
+	static FReal GetToleranceSquared(float Tolerance)
+	{
+		const FReal RealTolerance = (FReal)Tolerance;
+		return RealTolerance >= 0 ? RealTolerance * RealTolerance : -1;
+	}
+
+	static void BuildTable(TConstArrayView<FVector> CaseValues, TArray<FPoint>& OutPoints, TArray<int32>& OutCaseIndices, TArray<uint8>& OutSplitAxes)
+	{
+		TArray<FPoint> CasePoints;
+		CasePoints.Reserve(CaseValues.Num());
+		for (const FVector& Value : CaseValues)
+		{
+			// Converted to FReal like the linear search so both give the same answer
+			CasePoints.Add(FPoint(Value));
+		}
+
+		OutCaseIndices.Reset(CaseValues.Num());
+		for (int32 CaseIndex = 0; CaseIndex < CaseValues.Num(); ++CaseIndex)
+		{
+			OutCaseIndices.Add(CaseIndex);
+		}
+		OutSplitAxes.Init(0, CaseValues.Num());
+		BuildSubtree(CasePoints, OutCaseIndices, OutSplitAxes, 0, CaseValues.Num());
+
+		OutPoints.Reset(CaseValues.Num());
+		for (int32 CaseIndex : OutCaseIndices)
+		{
+			OutPoints.Add(CasePoints[CaseIndex]);
+		}
+	}
+
+	/**
+	 * @param ToleranceSquared - Points further than this never match, it also bounds the search from the start
+	 * @return The case index of the nearest point within tolerance of Value, or INDEX_NONE if there is none
+	 */
+	static int32 FindInTable(const FVector& Value, FReal ToleranceSquared, TConstArrayView<FPoint> Points, TConstArrayView<int32> CaseIndices, TConstArrayView<uint8> SplitAxes)
+	{
+		if (ToleranceSquared < 0)
+		{
+			return INDEX_NONE;
+		}
+
+		FSearch Search{ FPoint(Value), Points, CaseIndices, SplitAxes, ToleranceSquared, INDEX_NONE };
+		Search.Visit(0, Points.Num());
+		return Search.Nearest;
+	}
+
+private:
+	static void BuildSubtree(TConstArrayView<FPoint> CasePoints, TArray<int32>& Order, TArray<uint8>& SplitAxes, int32 Begin, int32 End)
+	{
+		if (End - Begin <= 1)
+		{
+			return;
+		}
+
+		// Split along the axis with the largest extent, this keeps the cells close to cubes for clustered points
+		FBounds Bounds(ForceInit);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Bounds += CasePoints[Order[Index]];
+		}
+		const FPoint Extent = Bounds.GetSize();
+		const uint8 Axis = Extent.X >= Extent.Y ? (Extent.X >= Extent.Z ? 0 : 2) : (Extent.Y >= Extent.Z ? 1 : 2);
+
+		Algo::Sort(MakeArrayView(Order.GetData() + Begin, End - Begin), [&CasePoints, Axis](int32 A, int32 B)
+		{
+			const FReal ValueA = CasePoints[A][Axis];
+			const FReal ValueB = CasePoints[B][Axis];
+			return ValueA != ValueB ? ValueA < ValueB : A < B;
+		});
+
+		const int32 Mid = (Begin + End) / 2;
+		SplitAxes[Mid] = Axis;
+		BuildSubtree(CasePoints, Order, SplitAxes, Begin, Mid);
+		BuildSubtree(CasePoints, Order, SplitAxes, Mid + 1, End);
+	}
+
+	struct FSearch
+	{
+		FPoint Value;
+		TConstArrayView<FPoint> Points;
+		TConstArrayView<int32> CaseIndices;
+		TConstArrayView<uint8> SplitAxes;
+		FReal BestDistanceSquared;
+		int32 Nearest;
+
+		void Visit(int32 Begin, int32 End)
+		{
+			if (Begin >= End)
+			{
+				return;
+			}
+
+			const int32 Mid = (Begin + End) / 2;
+			const FReal DistanceSquared = (Points[Mid] - Value).SizeSquared();
+			const int32 CaseIndex = CaseIndices[Mid];
+			const bool bCloser = Nearest == INDEX_NONE ? DistanceSquared <= BestDistanceSquared
+				: (DistanceSquared < BestDistanceSquared || (DistanceSquared == BestDistanceSquared && CaseIndex < Nearest));
+			if (bCloser)
+			{
+				BestDistanceSquared = DistanceSquared;
+				Nearest = CaseIndex;
+			}
+
+			// Points of the far subtree are at least as far as the split plane, equal distances are still visited for the lowest index tie break
+			const uint8 Axis = SplitAxes[Mid];
+			const FReal PlaneDelta = Value[Axis] - Points[Mid][Axis];
+			const bool bBelow = PlaneDelta < 0;
+			Visit(bBelow ? Begin : Mid + 1, bBelow ? Mid : End);
+			if (PlaneDelta * PlaneDelta <= BestDistanceSquared)
+			{
+				Visit(bBelow ? Mid + 1 : Begin, bBelow ? End : Mid);
+			}
+		}
+	};
+
+	TArray<FPoint> Points;
+	TArray<int32> CaseIndices;
+	TArray<uint8> SplitAxes;
+	FReal ToleranceSquared = -1;
+};
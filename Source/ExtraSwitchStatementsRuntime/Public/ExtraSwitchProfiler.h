@@ -0,0 +1,68 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UExtraSwitchCaseTable;
+
+// Instrumentation of the compiled switch lookups, compiled out of Shipping builds unless the target overrides it
+#ifndef EXTRASWITCH_PROFILING
+#define EXTRASWITCH_PROFILING !UE_BUILD_SHIPPING
+#endif
+
+#if EXTRASWITCH_PROFILING
+
+/**
+ * Records how the compiled switch nodes resolve their cases.
+ * The totals are always fed to `stat ExtraSwitch` and every lookup is a CPU scope on the ExtraSwitch trace channel.
+ * Per switch case hit counts are only gathered while ExtraSwitch.Profiling is 1, ExtraSwitch.DumpProfile writes them to a CSV file
+ * so hot cases and expensive switches can be found.
+ */
+class EXTRASWITCHSTATEMENTSRUNTIME_API FExtraSwitchProfiler
+{
+public:
+	// True while ExtraSwitch.Profiling is set, per switch stats are only recorded then
+	static bool IsRecording();
+
+	/**
+	 * Called after every lookup of a case table
+	 * @param Table - The table that was searched
+	 * @param CaseIndex - The case the lookup resolved to, INDEX_NONE for the default pin (or the end of the matches when continuing)
+	 * @param bContinuation - True for the FindNext calls an AllMatches switch makes after its first match
+	 * @param Cycles - The time the lookup took
+	 */
+	static void RecordLookup(const UExtraSwitchCaseTable* Table, int32 CaseIndex, bool bContinuation, uint64 Cycles);
+
+	/**
+	 * Called by the switches that cache their last case, before the lookup is recorded
+	 * @param bHit - True if the cached case still matched and the search was skipped
+	 */
+	static void RecordCacheLookup(const UExtraSwitchCaseTable* Table, bool bHit);
+
+	// Discards every recorded per switch stat
+	static void Reset();
+
+	/**
+	 * Writes one row per switch case with its hit count and the switch totals
+	 * @param Filename - Where to write, relative paths are under the profiling directory
+	 * @return True if the file was written
+	 */
+	static bool DumpCsv(const FString& Filename);
+
+	/**
+	 * Loads the case hit counts of a CSV file written by DumpCsv, e.g. from a play session on another machine
+	 * @return True if the file could be read
+	 */
+	static bool ImportCsv(const FString& Filename);
+
+	/**
+	 * Sums the case hits recorded or imported for every case table whose path starts with SwitchPath
+	 * @param SwitchPath - The case table path without the suffix MakeUniqueObjectName may add, e.g. /Game/BP_Zone.BP_Zone_C:K2Node_SwitchOnVector_0_CaseTable
+	 * @param OutCaseHits - The hit count of every case index, only as long as the highest case that was hit
+	 * @return True if anything was recorded for the switch
+	 */
+	static bool FindCaseHits(const FString& SwitchPath, TArray<uint64>& OutCaseHits);
+};
+
+#endif
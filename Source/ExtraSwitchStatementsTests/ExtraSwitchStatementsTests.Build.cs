@@ -0,0 +1,25 @@
+// Copyright Amir Ben-Kiki 2025
+
+using UnrealBuildTool;
+
+public class ExtraSwitchStatementsTests : ModuleRules
+{
+	public ExtraSwitchStatementsTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"UnrealEd",
+				"BlueprintGraph",
+				"Json",
+				"ExtraSwitchStatementsRuntime",
+				"ExtraBlueprintSwitchStatements",
+			}
+		);
+	}
+}
@@ -0,0 +1,499 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchBenchmark.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchTestGraph.h"
+#include "K2Node_SwitchOnBitmask.h"
+#include "K2Node_SwitchOnColor.h"
+#include "K2Node_SwitchOnFloat.h"
+#include "K2Node_SwitchOnFloatRanges.h"
+#include "K2Node_SwitchOnIntArray.h"
+#include "K2Node_SwitchOnIntRanges.h"
+#include "K2Node_SwitchOnNameSet.h"
+#include "K2Node_SwitchOnVector.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSwitchBenchmark);
+
+namespace ExtraSwitchBenchmark
+{
+    // Selections are generated once and cycled, so the timed loops only pay for the lookups
+    static constexpr int32 MaxSelections = 4096;
+    static constexpr int32 RandomSeed = 0x5317;
+
+    /**
+     * Calls a function of the comparator library through ProcessEvent with a reflected parameter buffer,
+     * so every call pays the thunk and the parameter copies a compiled blueprint pays
+     */
+    class FScriptCall
+    {
+    public:
+        explicit FScriptCall(FName FunctionName)
+            : Function(UExtraSwitchComparatorsFunctionLibrary::StaticClass()->FindFunctionByName(FunctionName))
+        {
+            check(Function);
+            Params = (uint8*)FMemory::Malloc(FMath::Max<int32>(Function->ParmsSize, 1), Function->GetMinAlignment());
+            Function->InitializeStruct(Params);
+        }
+
+        ~FScriptCall()
+        {
+            Function->DestroyStruct(Params);
+            FMemory::Free(Params);
+        }
+
+        FScriptCall(const FScriptCall&) = delete;
+        FScriptCall& operator=(const FScriptCall&) = delete;
+
+        // @return The storage of a parameter in the buffer, T must be its native type
+        template<typename T>
+        T& GetParam(FName Name) const
+        {
+            const FProperty* Property = Function->FindPropertyByName(Name);
+            check(Property && Property->GetSize() == sizeof(T));
+            return *Property->ContainerPtrToValuePtr<T>(Params);
+        }
+
+        template<typename T>
+        T& GetReturnValue() const
+        {
+            const FProperty* Property = Function->GetReturnProperty();
+            check(Property && Property->GetSize() == sizeof(T));
+            return *Property->ContainerPtrToValuePtr<T>(Params);
+        }
+
+        void Call() const
+        {
+            GetMutableDefault<UExtraSwitchComparatorsFunctionLibrary>()->ProcessEvent(Function, Params);
+        }
+
+    private:
+        UFunction* Function;
+        uint8* Params;
+    };
+
+    // @param Lookup - Resolves the selection with the given index and returns its case index
+    template<typename LookupType>
+    FResult Measure(const FSettings& Settings, const TCHAR* Shape, const TCHAR* Form, int32 NumCases, int32 NumSelections, LookupType&& Lookup)
+    {
+        // Warms the caches and the branch predictors so the first shape measured isn't penalised
+        for (int32 Index = 0; Index < FMath::Min(Settings.Iterations, NumSelections); ++Index)
+        {
+            Lookup(Index);
+        }
+
+        FResult Result;
+        Result.Shape = Shape;
+        Result.Form = Form;
+        Result.NumCases = NumCases;
+        Result.Iterations = Settings.Iterations;
+
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Iteration = 0; Iteration < Settings.Iterations; ++Iteration)
+        {
+            Result.Checksum += Lookup(Iteration % NumSelections) + 1;
+        }
+        Result.TotalMilliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+        return Result;
+    }
+
+    /**
+     * Measures one shape at one case count in every form
+     * @param IsNotMatching - The native comparator, true skips the case like the comparator chain of the stock switch node
+     * @param Find - The native case table lookup
+     * @param ComparatorName - The comparator function, its A parameter is a ComparatorValueType and B a CaseType
+     * @param ConfigureNode - Gives a node of NodeClass the same cases as the table, its selection parameter is a FindValueType
+     * @return False if the forms resolved to different cases or the node didn't compile
+     */
+    template<typename ComparatorValueType, typename FindValueType, typename ValueType, typename CaseType, typename ComparatorType, typename FindType>
+    bool RunShape(const FSettings& Settings, TArray<FResult>& Results, const TCHAR* Shape, const TArray<ValueType>& Selections, const TArray<CaseType>& Cases,
+        const UExtraSwitchCaseTable* Table, ComparatorType&& IsNotMatching, FindType&& Find, FName ComparatorName,
+        TSubclassOf<UK2Node_Switch> NodeClass, TFunctionRef<void(UK2Node_Switch&)> ConfigureNode)
+    {
+        const int32 NumCases = Cases.Num();
+        const int32 NumSelections = Selections.Num();
+        const int32 FirstResult = Results.Num();
+
+        Results.Add(Measure(Settings, Shape, TEXT("ComparatorNative"), NumCases, NumSelections, [&](int32 Index)
+        {
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                if (!IsNotMatching(Selections[Index], Cases[CaseIndex]))
+                {
+                    return CaseIndex;
+                }
+            }
+            return (int32)INDEX_NONE;
+        }));
+
+        Results.Add(Measure(Settings, Shape, TEXT("TableNative"), NumCases, NumSelections, [&](int32 Index)
+        {
+            return Find(Selections[Index], Table);
+        }));
+
+        if (Settings.bScript)
+        {
+            const FScriptCall Comparator(ComparatorName);
+            ComparatorValueType& ComparatorA = Comparator.GetParam<ComparatorValueType>(TEXT("A"));
+            CaseType& ComparatorB = Comparator.GetParam<CaseType>(TEXT("B"));
+            const bool& bNotMatching = Comparator.GetReturnValue<bool>();
+            Results.Add(Measure(Settings, Shape, TEXT("ComparatorScript"), NumCases, NumSelections, [&](int32 Index)
+            {
+                for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+                {
+                    ComparatorA = (ComparatorValueType)Selections[Index];
+                    ComparatorB = Cases[CaseIndex];
+                    Comparator.Call();
+                    if (!bNotMatching)
+                    {
+                        return CaseIndex;
+                    }
+                }
+                return (int32)INDEX_NONE;
+            }));
+
+            // The node itself compiled into a blueprint function, every pin records the case it stands for
+            FExtraSwitchTestGraph Graph;
+            const FExtraSwitchTestGraph::FEntry Entry = Graph.AddFunction(TEXT("Dispatch"), NodeClass.GetDefaultObject()->GetPinType());
+            UK2Node_Switch* SwitchNode = Graph.AddSwitch(Entry.Graph, NodeClass, ConfigureNode);
+            Graph.Connect(Entry.Then, SwitchNode->GetExecPin());
+            Graph.Connect(Entry.Selection, SwitchNode->GetSelectionPin());
+            Graph.RecordPins(SwitchNode, 0);
+
+            FString Errors;
+            if (!Graph.Compile(Errors))
+            {
+                UE_LOG(LogExtraSwitchBenchmark, Error, TEXT("%s with %d cases didn't compile: %s"), Shape, NumCases, *Errors);
+                return false;
+            }
+
+            const FExtraSwitchTestGraph::FCall Dispatch(Graph.GetInstance(), TEXT("Dispatch"));
+            FindValueType& DispatchSelection = Dispatch.GetSelection<FindValueType>();
+            const TArray<FIntPoint>& FiredPins = Graph.GetInstance()->FiredPins;
+            Results.Add(Measure(Settings, Shape, TEXT("Compiled"), NumCases, NumSelections, [&](int32 Index)
+            {
+                DispatchSelection = (FindValueType)Selections[Index];
+                Dispatch.Call();
+                // Running no pin or several can't match any case index, so the checksum tells
+                return FiredPins.Num() == 1 ? FiredPins[0].Y : (int32)INDEX_NONE - 1;
+            }));
+        }
+
+        bool bAgree = true;
+        for (int32 ResultIndex = FirstResult + 1; ResultIndex < Results.Num(); ++ResultIndex)
+        {
+            if (Results[ResultIndex].Checksum != Results[FirstResult].Checksum)
+            {
+                UE_LOG(LogExtraSwitchBenchmark, Error, TEXT("%s with %d cases: %s resolved to different cases than %s"),
+                    Shape, NumCases, *Results[ResultIndex].Form, *Results[FirstResult].Form);
+                bAgree = false;
+            }
+        }
+        return bAgree;
+    }
+
+    static UExtraSwitchCaseTable* NewTable()
+    {
+        return NewObject<UExtraSwitchCaseTable>(GetTransientPackage());
+    }
+
+    bool RunCaseCount(const FSettings& Settings, int32 NumCases, TArray<FResult>& Results)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        FRandomStream Random(RandomSeed + NumCases);
+        bool bAgree = true;
+
+        auto MakeIntArray = [&](const TCHAR* Shape, int32 Stride)
+        {
+            TArray<int32> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                Cases.Add(CaseIndex * Stride);
+            }
+
+            // About half the selections hit a case
+            TArray<int32> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                Selections.Add(Random.RandRange(-NumCases * Stride, NumCases * Stride));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildIntCases(Cases, TIntSetSwitch::DefaultMinDenseFill);
+            bAgree &= RunShape<int32, int32>(Settings, Results, Shape, Selections, Cases, Table.Get(),
+                [](int32 A, int32 B) { return Library::AreIntsNotEqual(A, B); },
+                [](int32 A, const UExtraSwitchCaseTable* InTable) { return Library::FindIntArrayCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, AreIntsNotEqual), UK2Node_SwitchOnIntArray::StaticClass(),
+                [&Cases](UK2Node_Switch& Node) { CastChecked<UK2Node_SwitchOnIntArray>(&Node)->PinValues = Cases; });
+        };
+
+        // Every third value is too sparse for the jump table, so this is the binary search
+        if (Settings.ShouldRun(TEXT("IntArray")))
+        {
+            MakeIntArray(TEXT("IntArray"), 3);
+        }
+        if (Settings.ShouldRun(TEXT("IntArrayDense")))
+        {
+            MakeIntArray(TEXT("IntArrayDense"), 1);
+        }
+
+        if (Settings.ShouldRun(TEXT("IntRange")))
+        {
+            // Ranges of 8 values with a gap of 2 between them
+            TArray<FSwitchIntRange> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                FSwitchIntRange& Range = Cases.AddDefaulted_GetRef();
+                Range.RangeMin = CaseIndex * 10;
+                Range.RangeMax = CaseIndex * 10 + 7;
+            }
+
+            TArray<int32> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                Selections.Add(Random.RandRange(-10, NumCases * 10 + 10));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildIntRangeCases(Cases);
+            bAgree &= RunShape<int32, int32>(Settings, Results, TEXT("IntRange"), Selections, Cases, Table.Get(),
+                [](int32 A, const FSwitchIntRange& B) { return Library::IsIntNotWithinRange(A, B); },
+                [](int32 A, const UExtraSwitchCaseTable* InTable) { return Library::FindIntRangeCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsIntNotWithinRange), UK2Node_SwitchOnIntRanges::StaticClass(),
+                [&Cases](UK2Node_Switch& Node) { CastChecked<UK2Node_SwitchOnIntRanges>(&Node)->PinValues = Cases; });
+        }
+
+        if (Settings.ShouldRun(TEXT("FloatRange")))
+        {
+            TArray<FExtraSwitchFloatRange> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                FExtraSwitchFloatRange& Range = Cases.AddDefaulted_GetRef();
+                Range.RangeMin = (float)CaseIndex;
+                Range.RangeMax = CaseIndex + 0.75f;
+            }
+
+            TArray<float> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                Selections.Add(Random.FRandRange(-1.0f, NumCases + 1.0f));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildFloatRangeCases(Cases);
+            bAgree &= RunShape<float, double>(Settings, Results, TEXT("FloatRange"), Selections, Cases, Table.Get(),
+                [](float A, const FExtraSwitchFloatRange& B) { return Library::IsFloatNotWithinRange(A, B); },
+                [](float A, const UExtraSwitchCaseTable* InTable) { return Library::FindFloatRangeCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsFloatNotWithinRange), UK2Node_SwitchOnFloatRanges::StaticClass(),
+                [&Cases](UK2Node_Switch& Node) { CastChecked<UK2Node_SwitchOnFloatRanges>(&Node)->PinValues = Cases; });
+        }
+
+        // The tolerance selections are either well inside a case or halfway between two, so float rounding can't make the forms disagree
+        if (Settings.ShouldRun(TEXT("Float")))
+        {
+            constexpr float Tolerance = 0.25f;
+            TArray<float> Values;
+            TArray<FFloatAndTolerance> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                Values.Add((float)CaseIndex);
+                FFloatAndTolerance& Case = Cases.AddDefaulted_GetRef();
+                Case.Value = (float)CaseIndex;
+                Case.Tolerance = Tolerance;
+            }
+
+            TArray<float> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                const float Center = (float)Random.RandRange(-1, NumCases);
+                Selections.Add(Center + (Random.RandRange(0, 1) == 0 ? Random.FRandRange(-0.1f, 0.1f) : 0.5f));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildFloatCases(Values, Tolerance);
+            bAgree &= RunShape<float, double>(Settings, Results, TEXT("Float"), Selections, Cases, Table.Get(),
+                [](float A, const FFloatAndTolerance& B) { return Library::IsFloatWithToleranceNotNearlyEqual(A, B); },
+                [](float A, const UExtraSwitchCaseTable* InTable) { return Library::FindFloatCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsFloatWithToleranceNotNearlyEqual), UK2Node_SwitchOnFloat::StaticClass(),
+                [&Values](UK2Node_Switch& Node)
+                {
+                    UK2Node_SwitchOnFloat* FloatNode = CastChecked<UK2Node_SwitchOnFloat>(&Node);
+                    FloatNode->PinValues = Values;
+                    FloatNode->Tolerance = Tolerance;
+                });
+        }
+
+        // The same grid near the world origin in double precision and 10 km out in float measured from the center of the cases
+        struct FVectorShape
+        {
+            const TCHAR* Shape;
+            FVector Base;
+            EExtraSwitchVectorPrecision Precision;
+        };
+        for (const FVectorShape& VectorShape : { FVectorShape{ TEXT("Vector"), FVector::ZeroVector, EExtraSwitchVectorPrecision::Double },
+            FVectorShape{ TEXT("VectorRebased"), FVector(1000000.0, 1000000.0, 0.0), EExtraSwitchVectorPrecision::RebasedFloat } })
+        {
+            if (!Settings.ShouldRun(VectorShape.Shape))
+            {
+                continue;
+            }
+
+            // A 16 x 16 x 4 grid with 100 units between the points
+            constexpr float Tolerance = 25.0f;
+            auto GetPoint = [&VectorShape](int32 CaseIndex)
+            {
+                return VectorShape.Base + FVector(CaseIndex % 16, CaseIndex / 16 % 16, CaseIndex / 256) * 100.0;
+            };
+
+            TArray<FVector> Values;
+            TArray<FVectorAndTolerance> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                const FVector Point = GetPoint(CaseIndex);
+                Values.Add(Point);
+                FVectorAndTolerance& Case = Cases.AddDefaulted_GetRef();
+                Case.X = Point.X;
+                Case.Y = Point.Y;
+                Case.Z = Point.Z;
+                Case.Tolerance = Tolerance;
+            }
+
+            TArray<FVector> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                const FVector Point = GetPoint(Random.RandRange(0, NumCases * 2));
+                Selections.Add(Point + (Random.RandRange(0, 1) == 0 ? FVector(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), 0.0) : FVector(50.0, 0.0, 0.0)));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildVectorCases(Values, Tolerance, EExtraSwitchMatchMode::FirstMatch, {}, VectorShape.Precision);
+            bAgree &= RunShape<FVector, FVector>(Settings, Results, VectorShape.Shape, Selections, Cases, Table.Get(),
+                [](const FVector& A, const FVectorAndTolerance& B) { return Library::IsVectorWithToleranceNotNearlyEqual(A, B); },
+                [](const FVector& A, const UExtraSwitchCaseTable* InTable) { return Library::FindVectorCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsVectorWithToleranceNotNearlyEqual), UK2Node_SwitchOnVector::StaticClass(),
+                [&Values, &VectorShape](UK2Node_Switch& Node)
+                {
+                    UK2Node_SwitchOnVector* VectorNode = CastChecked<UK2Node_SwitchOnVector>(&Node);
+                    VectorNode->PinValues = Values;
+                    VectorNode->Tolerance = Tolerance;
+                    VectorNode->Precision = VectorShape.Precision;
+                });
+        }
+
+        if (Settings.ShouldRun(TEXT("Color")))
+        {
+            // An 8 x 8 x 16 grid of opaque colors an eighth apart
+            constexpr float Tolerance = 0.03f;
+            auto GetColor = [](int32 CaseIndex)
+            {
+                return FLinearColor(CaseIndex % 8 * 0.125f, CaseIndex / 8 % 8 * 0.125f, CaseIndex / 64 * 0.125f, 1.0f);
+            };
+
+            TArray<FLinearColor> Values;
+            TArray<FColorAndTolerance> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                Values.Add(GetColor(CaseIndex));
+                FColorAndTolerance& Case = Cases.AddDefaulted_GetRef();
+                Case.Color = GetColor(CaseIndex);
+                Case.Tolerance = Tolerance;
+            }
+
+            TArray<FLinearColor> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                const FLinearColor Color = GetColor(Random.RandRange(0, NumCases * 2));
+                Selections.Add(Color + (Random.RandRange(0, 1) == 0 ? FLinearColor(Random.FRandRange(-0.01f, 0.01f), Random.FRandRange(-0.01f, 0.01f), 0.0f, 0.0f) : FLinearColor(0.0625f, 0.0f, 0.0f, 0.0f)));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildColorCases(Values, Tolerance, EExtraSwitchColorSpace::LinearRGBA);
+            bAgree &= RunShape<FLinearColor, FLinearColor>(Settings, Results, TEXT("Color"), Selections, Cases, Table.Get(),
+                [](const FLinearColor& A, const FColorAndTolerance& B) { return Library::IsColorWithToleranceNotNearlyEqual(A, B); },
+                [](const FLinearColor& A, const UExtraSwitchCaseTable* InTable) { return Library::FindColorCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsColorWithToleranceNotNearlyEqual), UK2Node_SwitchOnColor::StaticClass(),
+                [&Values](UK2Node_Switch& Node)
+                {
+                    UK2Node_SwitchOnColor* ColorNode = CastChecked<UK2Node_SwitchOnColor>(&Node);
+                    ColorNode->PinValues = Values;
+                    ColorNode->Distance = Tolerance;
+                    ColorNode->ComparisonSpace = EExtraSwitchColorSpace::LinearRGBA;
+                });
+        }
+
+        if (Settings.ShouldRun(TEXT("Name")))
+        {
+            TArray<FName> Names;
+            for (int32 Index = 0; Index < NumCases * 2; ++Index)
+            {
+                Names.Add(*FString::Printf(TEXT("Case_%d"), Index));
+            }
+            TArray<FName> Cases(Names.GetData(), NumCases);
+
+            TArray<FName> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                Selections.Add(Names[Random.RandRange(0, Names.Num() - 1)]);
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildNameCases(Cases);
+            bAgree &= RunShape<FName, FName>(Settings, Results, TEXT("Name"), Selections, Cases, Table.Get(),
+                [](FName A, FName B) { return Library::AreNamesNotEqual(A, B); },
+                [](FName A, const UExtraSwitchCaseTable* InTable) { return Library::FindNameCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, AreNamesNotEqual), UK2Node_SwitchOnNameSet::StaticClass(),
+                [&Cases](UK2Node_Switch& Node) { CastChecked<UK2Node_SwitchOnNameSet>(&Node)->PinValues = Cases; });
+        }
+
+        if (Settings.ShouldRun(TEXT("Bitmask")))
+        {
+            // Two flag masks cycling through the three tests, tested against three flag selections
+            auto RandomFlags = [&Random](int32 NumFlags)
+            {
+                int32 Flags = 0;
+                for (int32 Flag = 0; Flag < NumFlags; ++Flag)
+                {
+                    Flags |= 1 << Random.RandRange(0, 15);
+                }
+                return Flags;
+            };
+
+            TArray<FExtraSwitchBitmaskCase> Cases;
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                FExtraSwitchBitmaskCase& Case = Cases.AddDefaulted_GetRef();
+                Case.Mask = RandomFlags(2);
+                Case.Test = (EExtraSwitchBitmaskTest)(CaseIndex % 3);
+            }
+
+            TArray<int32> Selections;
+            for (int32 Index = 0; Index < MaxSelections; ++Index)
+            {
+                Selections.Add(RandomFlags(3));
+            }
+
+            const TStrongObjectPtr<UExtraSwitchCaseTable> Table(NewTable());
+            Table->BuildBitmaskCases(Cases);
+            bAgree &= RunShape<int32, int32>(Settings, Results, TEXT("Bitmask"), Selections, Cases, Table.Get(),
+                [](int32 A, const FExtraSwitchBitmaskCase& B) { return Library::IsBitmaskNotMatching(A, B); },
+                [](int32 A, const UExtraSwitchCaseTable* InTable) { return Library::FindBitmaskCaseIndex(A, InTable); },
+                GET_FUNCTION_NAME_CHECKED(Library, IsBitmaskNotMatching), UK2Node_SwitchOnBitmask::StaticClass(),
+                [&Cases](UK2Node_Switch& Node) { CastChecked<UK2Node_SwitchOnBitmask>(&Node)->PinValues = Cases; });
+        }
+
+        // The blueprints built for this case count are garbage now, a run over every count would otherwise keep all of them
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        return bAgree;
+    }
+
+    TConstArrayView<const TCHAR*> GetShapes()
+    {
+        static const TCHAR* const Shapes[] = { TEXT("IntArray"), TEXT("IntArrayDense"), TEXT("IntRange"), TEXT("FloatRange"), TEXT("Float"),
+            TEXT("Vector"), TEXT("VectorRebased"), TEXT("Color"), TEXT("Name"), TEXT("Bitmask") };
+        return Shapes;
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSwitchBenchmark, Log, All);
+
+/**
+ * The switch shapes the ExtraSwitchBenchmark commandlet and the ExtraSwitch.Benchmark automation tests time.
+ * Each shape is measured in four forms on the same selections: the per pin comparator chain of the stock K2Node_Switch and the case table lookup,
+ * both called natively, the comparator chain called through ProcessEvent like the stock node's bytecode calls it, and a compiled blueprint function
+ * holding the extra switch node itself.
+ */
+namespace ExtraSwitchBenchmark
+{
+	struct FSettings
+	{
+		TArray<FString> Shapes;
+		int32 Iterations = 100000;
+		// Also measures the forms that run in the blueprint VM
+		bool bScript = true;
+
+		bool ShouldRun(const TCHAR* Shape) const
+		{
+			return Shapes.Num() == 0 || Shapes.Contains(Shape);
+		}
+	};
+
+	struct FResult
+	{
+		FString Shape;
+		FString Form;
+		int32 NumCases = 0;
+		int32 Iterations = 0;
+		double TotalMilliseconds = 0.0;
+		// Sum of the case index + 1 of every lookup, every form of a shape must agree on it
+		int64 Checksum = 0;
+
+		double GetNanosecondsPerLookup() const
+		{
+			return Iterations > 0 ? TotalMilliseconds * 1.0e6 / Iterations : 0.0;
+		}
+	};
+
+	// Every shape, in the order they are measured
+	TConstArrayView<const TCHAR*> GetShapes();
+
+	/**
+	 * Builds the cases and selections of every shape the settings select and measures them
+	 * @return False if any shape's forms disagreed or its blueprint didn't compile
+	 */
+	bool RunCaseCount(const FSettings& Settings, int32 NumCases, TArray<FResult>& Results);
+}
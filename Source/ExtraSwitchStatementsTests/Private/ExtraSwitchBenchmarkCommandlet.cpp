@@ -0,0 +1,124 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchBenchmarkCommandlet.h"
+#include "ExtraSwitchBenchmark.h"
+#include "ExtraSwitchProfiler.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ExtraSwitchBenchmark
+{
+    static bool WriteResults(const FString& BasePath, TConstArrayView<FResult> Results)
+    {
+        TArray<FString> Lines;
+        Lines.Add(TEXT("Shape,Form,Cases,Iterations,TotalMilliseconds,NanosecondsPerLookup"));
+        for (const FResult& Result : Results)
+        {
+            Lines.Add(FString::Printf(TEXT("%s,%s,%d,%d,%.4f,%.2f"), *Result.Shape, *Result.Form, Result.NumCases, Result.Iterations,
+                Result.TotalMilliseconds, Result.GetNanosecondsPerLookup()));
+        }
+
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("Platform"), FString(FPlatformProperties::IniPlatformName()));
+        Writer->WriteValue(TEXT("Configuration"), FString(LexToString(FApp::GetBuildConfiguration())));
+        // The profiling stats are counted inside every table lookup, results with and without them are not comparable
+        Writer->WriteValue(TEXT("Profiling"), EXTRASWITCH_PROFILING != 0);
+        Writer->WriteArrayStart(TEXT("Results"));
+        for (const FResult& Result : Results)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("Shape"), Result.Shape);
+            Writer->WriteValue(TEXT("Form"), Result.Form);
+            Writer->WriteValue(TEXT("Cases"), Result.NumCases);
+            Writer->WriteValue(TEXT("Iterations"), Result.Iterations);
+            Writer->WriteValue(TEXT("TotalMilliseconds"), Result.TotalMilliseconds);
+            Writer->WriteValue(TEXT("NanosecondsPerLookup"), Result.GetNanosecondsPerLookup());
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        const FString CsvPath = BasePath + TEXT(".csv");
+        const FString JsonPath = BasePath + TEXT(".json");
+        if (!FFileHelper::SaveStringArrayToFile(Lines, *CsvPath) || !FFileHelper::SaveStringToFile(Json, *JsonPath))
+        {
+            UE_LOG(LogExtraSwitchBenchmark, Error, TEXT("Failed to write the benchmark results to %s"), *BasePath);
+            return false;
+        }
+
+        UE_LOG(LogExtraSwitchBenchmark, Display, TEXT("Wrote the benchmark results to %s and %s"), *CsvPath, *JsonPath);
+        return true;
+    }
+}
+
+UExtraSwitchBenchmarkCommandlet::UExtraSwitchBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UExtraSwitchBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace ExtraSwitchBenchmark;
+
+    FSettings Settings;
+    FParse::Value(*Params, TEXT("Iterations="), Settings.Iterations);
+    Settings.Iterations = FMath::Max(Settings.Iterations, 1);
+    Settings.bScript = !FParse::Param(*Params, TEXT("NoScript"));
+
+    TArray<int32> CaseCounts;
+    FString CaseCountsParam;
+    if (FParse::Value(*Params, TEXT("Cases="), CaseCountsParam, false))
+    {
+        TArray<FString> Counts;
+        CaseCountsParam.ParseIntoArray(Counts, TEXT(","));
+        for (const FString& Count : Counts)
+        {
+            CaseCounts.Add(FMath::Clamp(FCString::Atoi(*Count), 1, 1024));
+        }
+    }
+    if (CaseCounts.Num() == 0)
+    {
+        for (int32 NumCases = 1; NumCases <= 1024; NumCases *= 2)
+        {
+            CaseCounts.Add(NumCases);
+        }
+    }
+
+    FString Shapes;
+    if (FParse::Value(*Params, TEXT("Shapes="), Shapes, false))
+    {
+        Shapes.ParseIntoArray(Settings.Shapes, TEXT(","));
+    }
+
+    FString Output = FString::Printf(TEXT("ExtraSwitchBenchmark-%s"), *FDateTime::Now().ToString());
+    FParse::Value(*Params, TEXT("Output="), Output);
+    Output = FPaths::GetBaseFilename(Output, false);
+    const FString BasePath = FPaths::IsRelative(Output) ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("ExtraSwitch"), Output) : Output;
+
+    TArray<FResult> Results;
+    bool bAgree = true;
+    for (const int32 NumCases : CaseCounts)
+    {
+        UE_LOG(LogExtraSwitchBenchmark, Display, TEXT("Measuring %d cases"), NumCases);
+        bAgree &= RunCaseCount(Settings, NumCases, Results);
+    }
+
+    for (const FResult& Result : Results)
+    {
+        UE_LOG(LogExtraSwitchBenchmark, Display, TEXT("%-14s %-17s %5d cases %10.2f ns"), *Result.Shape, *Result.Form, Result.NumCases, Result.GetNanosecondsPerLookup());
+    }
+
+    if (!WriteResults(BasePath, Results))
+    {
+        return 1;
+    }
+    return bAgree ? 0 : 1;
+}
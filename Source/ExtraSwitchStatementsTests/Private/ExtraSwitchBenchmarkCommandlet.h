@@ -0,0 +1,27 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExtraSwitchBenchmarkCommandlet.generated.h"
+
+/**
+ * Times every switch shape at a range of case counts, so a change to the comparators or the case tables can be checked for regressions on a build machine.
+ * Each shape is measured in the forms listed in ExtraSwitchBenchmark.h, the Compiled form runs a transient blueprint with the extra switch node compiled into it.
+ * The ExtraSwitch.Benchmark automation tests time the same shapes without writing any files.
+ *
+ * UnrealEditor-Cmd <Project> -run=ExtraSwitchBenchmark -nullrhi [-Cases=1,4,16] [-Iterations=100000] [-Shapes=IntArray,Float] [-NoScript] [-Output=<File>]
+ *
+ * Writes <File>.csv and <File>.json, by default under Saved/Profiling/ExtraSwitch. Returns 1 when two forms of a shape disagree on a case.
+ */
+UCLASS()
+class UExtraSwitchBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExtraSwitchBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,51 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchBenchmark.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ExtraSwitchBenchmarkTests
+{
+    // Far fewer than the commandlet's default, the tests are for comparing the forms of a shape rather than tracking builds
+    static constexpr int32 Iterations = 20000;
+
+    // Times one shape at 1 to 1024 cases in every form and fails when the compiled node runs another pin than the lookups return
+    static bool RunShape(FAutomationTestBase& Test, const TCHAR* Shape)
+    {
+        ExtraSwitchBenchmark::FSettings Settings;
+        Settings.Shapes.Add(Shape);
+        Settings.Iterations = Iterations;
+
+        TArray<ExtraSwitchBenchmark::FResult> Results;
+        bool bAgree = true;
+        for (int32 NumCases = 1; NumCases <= 1024; NumCases *= 2)
+        {
+            bAgree &= ExtraSwitchBenchmark::RunCaseCount(Settings, NumCases, Results);
+        }
+
+        for (const ExtraSwitchBenchmark::FResult& Result : Results)
+        {
+            Test.AddInfo(FString::Printf(TEXT("%-17s %5d cases %10.2f ns"), *Result.Form, Result.NumCases, Result.GetNanosecondsPerLookup()));
+        }
+        return Test.TestTrue(TEXT("Every form resolves the same cases"), bAgree);
+    }
+}
+
+// One test per shape, named after it
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FExtraSwitchBenchmarkTest, "ExtraSwitch.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+void FExtraSwitchBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const TCHAR* Shape : ExtraSwitchBenchmark::GetShapes())
+    {
+        OutBeautifiedNames.Add(Shape);
+        OutTestCommands.Add(Shape);
+    }
+}
+
+bool FExtraSwitchBenchmarkTest::RunTest(const FString& Parameters)
+{
+    return ExtraSwitchBenchmarkTests::RunShape(*this, *Parameters);
+}
+
+#endif
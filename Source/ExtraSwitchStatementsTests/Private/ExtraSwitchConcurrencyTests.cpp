@@ -0,0 +1,410 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchDispatch.h"
+#include "ExtraSwitchProfiler.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ExtraSwitchConcurrencyTests
+{
+    using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+    static constexpr int32 NumCases = 64;
+    static constexpr int32 NumSelections = 1024;
+    // How often each worker thread repeats the lookups, enough for the threads to overlap
+    static constexpr int32 Repeats = 8;
+    static constexpr int32 RandomSeed = 0x7417;
+
+    static int32 GetNumThreads()
+    {
+        return FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 2);
+    }
+
+    /**
+     * The library is marked BlueprintThreadSafe, so the lookups must give the same answers when worker threads share a case table.
+     * Every thread repeats Lookups and is compared with a run on the calling thread, Lookups must keep any case slot it uses to itself
+     */
+    static void CheckConcurrent(FAutomationTestBase& Test, const TCHAR* What, TFunctionRef<TArray<int32>()> Lookups)
+    {
+        const TArray<int32> Expected = Lookups();
+        const int32 NumThreads = GetNumThreads();
+        std::atomic<int32> Mismatches = 0;
+        ParallelFor(NumThreads, [&Lookups, &Expected, &Mismatches](int32)
+        {
+            for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+            {
+                if (Lookups() != Expected)
+                {
+                    ++Mismatches;
+                }
+            }
+        });
+
+        Test.TestEqual(FString::Printf(TEXT("%s runs on %d threads that disagree with the calling thread"), What, NumThreads), Mismatches.load(), 0);
+    }
+
+    // Every selection twice in a row, so the cached lookups hit their cache as often as they miss it
+    template<typename ValueType, typename FindType>
+    TArray<int32> RunCached(const TArray<ValueType>& Selections, FindType&& FindCached)
+    {
+        TArray<int32> Results;
+        int32 CaseSlot = ExtraSwitch::CaseSlotNotEvaluated;
+        for (const ValueType& Selection : Selections)
+        {
+            Results.Add(FindCached(Selection, CaseSlot));
+            Results.Add(FindCached(Selection, CaseSlot));
+        }
+        return Results;
+    }
+
+    template<typename ValueType, typename FindType>
+    TArray<int32> RunResolve(const TArray<ValueType>& Selections, FindType&& Find)
+    {
+        TArray<int32> Results;
+        for (const ValueType& Selection : Selections)
+        {
+            Results.Add(Find(Selection));
+            Results.Add(Find(Selection));
+        }
+        return Results;
+    }
+
+    // Every match of every selection followed by INDEX_NONE, like the loop an AllMatches switch runs
+    template<typename ValueType, typename FindNextType>
+    TArray<int32> RunAllMatches(const TArray<ValueType>& Selections, FindNextType&& FindNext)
+    {
+        TArray<int32> Results;
+        for (const ValueType& Selection : Selections)
+        {
+            for (int32 CaseIndex = FindNext(Selection, 0); CaseIndex != INDEX_NONE && Results.Num() < NumSelections * (NumCases + 1); CaseIndex = FindNext(Selection, CaseIndex + 1))
+            {
+                Results.Add(CaseIndex);
+            }
+            Results.Add(INDEX_NONE);
+        }
+        return Results;
+    }
+
+    static TStrongObjectPtr<UExtraSwitchCaseTable> NewTable(const TCHAR* BaseName = TEXT("ExtraSwitchConcurrencyTable"))
+    {
+        return TStrongObjectPtr<UExtraSwitchCaseTable>(NewObject<UExtraSwitchCaseTable>(GetTransientPackage(),
+            MakeUniqueObjectName(GetTransientPackage(), UExtraSwitchCaseTable::StaticClass(), BaseName)));
+    }
+
+    // Cases and selections of every shape, the selections hit about half the cases and fall between them otherwise
+    struct FShapes
+    {
+        TArray<int32> IntValues;
+        TArray<FSwitchIntRange> IntRanges;
+        TArray<FExtraSwitchFloatRange> FloatRanges;
+        // Every range overlaps the next one, for the AllMatches lookup
+        TArray<FExtraSwitchFloatRange> OverlappingFloatRanges;
+        TArray<float> FloatValues;
+        TArray<FVector> VectorValues;
+        TArray<FLinearColor> ColorValues;
+        TArray<FName> NameValues;
+        TArray<FExtraSwitchBitmaskCase> BitmaskCases;
+
+        TArray<int32> IntSelections;
+        TArray<double> FloatSelections;
+        TArray<FVector> VectorSelections;
+        TArray<FLinearColor> ColorSelections;
+        TArray<FName> NameSelections;
+        TArray<int32> FlagSelections;
+
+        FShapes()
+        {
+            FRandomStream Random(RandomSeed);
+            for (int32 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex)
+            {
+                IntValues.Add(CaseIndex * 3);
+
+                FSwitchIntRange& IntRange = IntRanges.AddDefaulted_GetRef();
+                IntRange.RangeMin = CaseIndex * 3;
+                IntRange.RangeMax = CaseIndex * 3 + 1;
+
+                FExtraSwitchFloatRange& FloatRange = FloatRanges.AddDefaulted_GetRef();
+                FloatRange.RangeMin = CaseIndex * 3.0f;
+                FloatRange.RangeMax = CaseIndex * 3.0f + 1.5f;
+
+                FExtraSwitchFloatRange& OverlappingRange = OverlappingFloatRanges.AddDefaulted_GetRef();
+                OverlappingRange.RangeMin = CaseIndex * 3.0f;
+                OverlappingRange.RangeMax = CaseIndex * 3.0f + 4.5f;
+
+                FloatValues.Add(CaseIndex * 3.0f);
+                VectorValues.Add(FVector(CaseIndex % 8, CaseIndex / 8, 0.0) * 300.0);
+                ColorValues.Add(FLinearColor(CaseIndex % 4 * 0.25f, CaseIndex / 4 % 4 * 0.25f, CaseIndex / 16 * 0.25f, 1.0f));
+                NameValues.Add(*FString::Printf(TEXT("Case_%d"), CaseIndex));
+
+                FExtraSwitchBitmaskCase& BitmaskCase = BitmaskCases.AddDefaulted_GetRef();
+                BitmaskCase.Mask = (1 << Random.RandRange(0, 15)) | (1 << Random.RandRange(0, 15));
+                BitmaskCase.Test = (EExtraSwitchBitmaskTest)(CaseIndex % 3);
+            }
+
+            for (int32 Index = 0; Index < NumSelections; ++Index)
+            {
+                const int32 CaseIndex = Random.RandRange(0, NumCases * 2);
+                IntSelections.Add(CaseIndex * 3 + Random.RandRange(0, 2));
+                FloatSelections.Add(CaseIndex * 3.0 + Random.FRandRange(-0.5f, 2.5f));
+                VectorSelections.Add(FVector(CaseIndex % 8, CaseIndex / 8, 0.0) * 300.0 + FVector(Random.FRandRange(-20.0f, 20.0f), 0.0, 0.0));
+                ColorSelections.Add(FLinearColor(CaseIndex % 4 * 0.25f + Random.FRandRange(-0.02f, 0.02f), CaseIndex / 4 % 4 * 0.25f, CaseIndex / 16 * 0.25f, 1.0f));
+                NameSelections.Add(*FString::Printf(TEXT("Case_%d"), CaseIndex));
+                FlagSelections.Add((1 << Random.RandRange(0, 15)) | (1 << Random.RandRange(0, 15)) | (1 << Random.RandRange(0, 15)));
+            }
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExtraSwitchConcurrencyResolveTest, "ExtraSwitch.Concurrency.Resolve", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FExtraSwitchConcurrencyResolveTest::RunTest(const FString& Parameters)
+{
+    using namespace ExtraSwitchConcurrencyTests;
+    const FShapes Shapes;
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> IntTable = NewTable();
+    IntTable->BuildIntCases(Shapes.IntValues, TIntSetSwitch::DefaultMinDenseFill);
+    CheckConcurrent(*this, TEXT("FindIntArrayCaseIndex"), [&] { return RunResolve(Shapes.IntSelections, [&](int32 A) { return Library::FindIntArrayCaseIndex(A, IntTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> IntRangeTable = NewTable();
+    IntRangeTable->BuildIntRangeCases(Shapes.IntRanges, EExtraSwitchMatchMode::AllMatches);
+    CheckConcurrent(*this, TEXT("FindIntRangeCaseIndex"), [&] { return RunResolve(Shapes.IntSelections, [&](int32 A) { return Library::FindIntRangeCaseIndex(A, IntRangeTable.Get()); }); });
+    CheckConcurrent(*this, TEXT("FindNextIntRangeCaseIndex"), [&]
+    {
+        return RunAllMatches(Shapes.IntSelections, [&](int32 A, int32 StartIndex) { return Library::FindNextIntRangeCaseIndex(A, IntRangeTable.Get(), StartIndex); });
+    });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> FloatRangeTable = NewTable();
+    FloatRangeTable->BuildFloatRangeCases(Shapes.OverlappingFloatRanges, EExtraSwitchMatchMode::AllMatches);
+    CheckConcurrent(*this, TEXT("FindNextFloatRangeCaseIndex"), [&]
+    {
+        return RunAllMatches(Shapes.FloatSelections, [&](double A, int32 StartIndex) { return Library::FindNextFloatRangeCaseIndex(A, FloatRangeTable.Get(), StartIndex); });
+    });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> FloatTable = NewTable();
+    FloatTable->BuildFloatCases(Shapes.FloatValues, 0.5f);
+    CheckConcurrent(*this, TEXT("FindFloatCaseIndex"), [&] { return RunResolve(Shapes.FloatSelections, [&](double A) { return Library::FindFloatCaseIndex(A, FloatTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> VectorTable = NewTable();
+    VectorTable->BuildVectorCases(Shapes.VectorValues, 50.0f);
+    CheckConcurrent(*this, TEXT("FindVectorCaseIndex"), [&] { return RunResolve(Shapes.VectorSelections, [&](const FVector& A) { return Library::FindVectorCaseIndex(A, VectorTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> ColorTable = NewTable();
+    ColorTable->BuildColorCases(Shapes.ColorValues, 0.05f, EExtraSwitchColorSpace::Oklab);
+    CheckConcurrent(*this, TEXT("FindColorCaseIndex"), [&] { return RunResolve(Shapes.ColorSelections, [&](const FLinearColor& A) { return Library::FindColorCaseIndex(A, ColorTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> NameTable = NewTable();
+    NameTable->BuildNameCases(Shapes.NameValues);
+    CheckConcurrent(*this, TEXT("FindNameCaseIndex"), [&] { return RunResolve(Shapes.NameSelections, [&](FName A) { return Library::FindNameCaseIndex(A, NameTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> BitmaskTable = NewTable();
+    BitmaskTable->BuildBitmaskCases(Shapes.BitmaskCases, EExtraSwitchMatchMode::AllMatches);
+    CheckConcurrent(*this, TEXT("FindNextBitmaskCaseIndex"), [&]
+    {
+        return RunAllMatches(Shapes.FlagSelections, [&](int32 A, int32 StartIndex) { return Library::FindNextBitmaskCaseIndex(A, BitmaskTable.Get(), StartIndex); });
+    });
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExtraSwitchConcurrencyCachedTest, "ExtraSwitch.Concurrency.CachedCaseSlot", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FExtraSwitchConcurrencyCachedTest::RunTest(const FString& Parameters)
+{
+    using namespace ExtraSwitchConcurrencyTests;
+    const FShapes Shapes;
+
+    // Each run owns its case slot like each object owns its event graph frame, the cache must not change any case either
+    auto CheckCached = [this](const TCHAR* What, TFunctionRef<TArray<int32>()> Cached, TFunctionRef<TArray<int32>()> Resolve)
+    {
+        TestEqual(FString::Printf(TEXT("%s resolves the same cases as the search"), What), Cached(), Resolve());
+        CheckConcurrent(*this, What, Cached);
+    };
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> IntTable = NewTable();
+    IntTable->BuildIntCases(Shapes.IntValues, TIntSetSwitch::DefaultMinDenseFill);
+    CheckCached(TEXT("FindIntArrayCaseIndexCached"),
+        [&] { return RunCached(Shapes.IntSelections, [&](int32 A, int32& CaseSlot) { return Library::FindIntArrayCaseIndexCached(A, IntTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.IntSelections, [&](int32 A) { return Library::FindIntArrayCaseIndex(A, IntTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> IntRangeTable = NewTable();
+    IntRangeTable->BuildIntRangeCases(Shapes.IntRanges);
+    CheckCached(TEXT("FindIntRangeCaseIndexCached"),
+        [&] { return RunCached(Shapes.IntSelections, [&](int32 A, int32& CaseSlot) { return Library::FindIntRangeCaseIndexCached(A, IntRangeTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.IntSelections, [&](int32 A) { return Library::FindIntRangeCaseIndex(A, IntRangeTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> FloatRangeTable = NewTable();
+    FloatRangeTable->BuildFloatRangeCases(Shapes.FloatRanges);
+    CheckCached(TEXT("FindFloatRangeCaseIndexCached"),
+        [&] { return RunCached(Shapes.FloatSelections, [&](double A, int32& CaseSlot) { return Library::FindFloatRangeCaseIndexCached(A, FloatRangeTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.FloatSelections, [&](double A) { return Library::FindFloatRangeCaseIndex(A, FloatRangeTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> FloatTable = NewTable();
+    FloatTable->BuildFloatCases(Shapes.FloatValues, 0.5f);
+    CheckCached(TEXT("FindFloatCaseIndexCached"),
+        [&] { return RunCached(Shapes.FloatSelections, [&](double A, int32& CaseSlot) { return Library::FindFloatCaseIndexCached(A, FloatTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.FloatSelections, [&](double A) { return Library::FindFloatCaseIndex(A, FloatTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> VectorTable = NewTable();
+    VectorTable->BuildVectorCases(Shapes.VectorValues, 50.0f);
+    CheckCached(TEXT("FindVectorCaseIndexCached"),
+        [&] { return RunCached(Shapes.VectorSelections, [&](const FVector& A, int32& CaseSlot) { return Library::FindVectorCaseIndexCached(A, VectorTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.VectorSelections, [&](const FVector& A) { return Library::FindVectorCaseIndex(A, VectorTable.Get()); }); });
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> ColorTable = NewTable();
+    ColorTable->BuildColorCases(Shapes.ColorValues, 0.05f, EExtraSwitchColorSpace::LinearRGBA);
+    CheckCached(TEXT("FindColorCaseIndexCached"),
+        [&] { return RunCached(Shapes.ColorSelections, [&](const FLinearColor& A, int32& CaseSlot) { return Library::FindColorCaseIndexCached(A, ColorTable.Get(), CaseSlot); }); },
+        [&] { return RunResolve(Shapes.ColorSelections, [&](const FLinearColor& A) { return Library::FindColorCaseIndex(A, ColorTable.Get()); }); });
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExtraSwitchConcurrencyHysteresisTest, "ExtraSwitch.Concurrency.HysteresisCaseSlot", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FExtraSwitchConcurrencyHysteresisTest::RunTest(const FString& Parameters)
+{
+    using namespace ExtraSwitchConcurrencyTests;
+    const FShapes Shapes;
+
+    static constexpr float HysteresisMargin = 0.25f;
+    const TStrongObjectPtr<UExtraSwitchCaseTable> Table = NewTable();
+    Table->BuildFloatRangeCases(Shapes.FloatRanges);
+    Table->SetFloatRangeHysteresis(HysteresisMargin);
+
+    // A selection drifting over every range boundary while it jitters by more than the margin, so the remembered case decides often
+    TArray<double> Selections;
+    FRandomStream Random(RandomSeed);
+    for (int32 Index = 0; Index < NumSelections; ++Index)
+    {
+        Selections.Add(Index * NumCases * 3.0 / NumSelections + Random.FRandRange(-0.4f, 0.4f));
+    }
+
+    auto RunHysteresis = [&Selections, &Table]()
+    {
+        TArray<int32> Results;
+        int32 CaseSlot = ExtraSwitch::CaseSlotNotEvaluated;
+        for (const double Selection : Selections)
+        {
+            Results.Add(Library::FindFloatRangeCaseIndexWithHysteresis(Selection, Table.Get(), CaseSlot));
+        }
+        return Results;
+    };
+
+    // The margin must actually keep cases, otherwise this only tests the plain lookup again
+    TArray<int32> Plain;
+    for (const double Selection : Selections)
+    {
+        Plain.Add(Library::FindFloatRangeCaseIndex(Selection, Table.Get()));
+    }
+    const TArray<int32> Sticky = RunHysteresis();
+    TestNotEqual(TEXT("The hysteresis margin keeps some cases the plain lookup leaves"), Sticky, Plain);
+
+    // Every difference must be the previous case held on, with the selection no further than the margin from the bounds of the range
+    // that decided it: the kept range, or the range the selection hasn't gone deep enough into when the default pin is kept
+    const float Margin = HysteresisMargin + KINDA_SMALL_NUMBER;
+    for (int32 Index = 0; Index < Selections.Num(); ++Index)
+    {
+        if (Sticky[Index] == Plain[Index])
+        {
+            continue;
+        }
+
+        const int32 Previous = Index > 0 ? Sticky[Index - 1] : INDEX_NONE;
+        const float Selection = (float)Selections[Index];
+        const int32 RangeIndex = Sticky[Index] != INDEX_NONE ? Sticky[Index] : Plain[Index];
+        const FExtraSwitchFloatRange& Range = Shapes.FloatRanges[RangeIndex];
+        const bool bNearBounds = Sticky[Index] != INDEX_NONE
+            ? Selection >= Range.RangeMin - Margin && Selection <= Range.RangeMax + Margin
+            : Selection < Range.RangeMin + Margin || Selection > Range.RangeMax - Margin;
+        if (!TestEqual(FString::Printf(TEXT("Case of selection %d (%f) the plain lookup resolves to %d"), Index, Selection, Plain[Index]), Sticky[Index], Previous)
+            || !TestTrue(FString::Printf(TEXT("Selection %d (%f) is within the margin of the bounds of case %d"), Index, Selection, RangeIndex), bNearBounds))
+        {
+            break;
+        }
+    }
+
+    CheckConcurrent(*this, TEXT("FindFloatRangeCaseIndexWithHysteresis"), RunHysteresis);
+    return true;
+}
+
+#if EXTRASWITCH_PROFILING
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FExtraSwitchConcurrencyProfilerTest, "ExtraSwitch.Concurrency.ProfilerLock", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FExtraSwitchConcurrencyProfilerTest::RunTest(const FString& Parameters)
+{
+    using namespace ExtraSwitchConcurrencyTests;
+    const FShapes Shapes;
+
+    IConsoleVariable* ProfilingVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("ExtraSwitch.Profiling"));
+    if (!TestNotNull(TEXT("ExtraSwitch.Profiling"), ProfilingVariable))
+    {
+        return false;
+    }
+    const int32 PreviousProfiling = ProfilingVariable->GetInt();
+    ProfilingVariable->Set(1, ECVF_SetByCode);
+    FExtraSwitchProfiler::Reset();
+
+    // Every selection is one of the names, so every lookup lands on a case and the hits of all threads must add up exactly.
+    // FindCaseHits matches by path prefix, so the table gets a name no other table of the tests starts with
+    const TStrongObjectPtr<UExtraSwitchCaseTable> NameTable = NewTable(TEXT("ExtraSwitchProfiledNames"));
+    NameTable->BuildNameCases(Shapes.NameValues);
+    TArray<FName> Selections;
+    for (int32 Index = 0; Index < NumSelections; ++Index)
+    {
+        Selections.Add(Shapes.NameValues[Index % NumCases]);
+    }
+
+    const TStrongObjectPtr<UExtraSwitchCaseTable> FloatTable = NewTable();
+    FloatTable->BuildFloatCases(Shapes.FloatValues, 0.5f);
+
+    // One thread keeps reading the hits while the others record, the cached lookups also record their cache hits under the same lock
+    const int32 NumThreads = GetNumThreads();
+    const FString NamePath = NameTable->GetPathName();
+    ParallelFor(NumThreads + 1, [&](int32 ThreadIndex)
+    {
+        if (ThreadIndex == NumThreads)
+        {
+            TArray<uint64> CaseHits;
+            for (int32 Repeat = 0; Repeat < NumSelections; ++Repeat)
+            {
+                FExtraSwitchProfiler::FindCaseHits(NamePath, CaseHits);
+            }
+            return;
+        }
+
+        int32 CaseSlot = ExtraSwitch::CaseSlotNotEvaluated;
+        for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            for (const FName Selection : Selections)
+            {
+                Library::FindNameCaseIndex(Selection, NameTable.Get());
+            }
+            for (const double Selection : Shapes.FloatSelections)
+            {
+                Library::FindFloatCaseIndexCached(Selection, FloatTable.Get(), CaseSlot);
+            }
+        }
+    });
+
+    TArray<uint64> CaseHits;
+    FExtraSwitchProfiler::FindCaseHits(NamePath, CaseHits);
+    TestEqual(TEXT("Recorded cases"), CaseHits.Num(), NumCases);
+    for (int32 CaseIndex = 0; CaseIndex < CaseHits.Num(); ++CaseIndex)
+    {
+        TestEqual(FString::Printf(TEXT("Hits of case %d"), CaseIndex), CaseHits[CaseIndex], (uint64)NumThreads * Repeats * NumSelections / NumCases);
+    }
+
+    FExtraSwitchProfiler::Reset();
+    ProfilingVariable->Set(PreviousProfiling, ECVF_SetByCode);
+    return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,1346 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchConformanceCommandlet.h"
+#include "ExtraSwitchComparatorsFunctionLibrary.h"
+#include "ExtraSwitchCaseTable.h"
+#include "ExtraSwitchDispatch.h"
+#include "ExtraSwitchTestGraph.h"
+#include "K2Node_SwitchOnBitmask.h"
+#include "K2Node_SwitchOnColor.h"
+#include "K2Node_SwitchOnFloat.h"
+#include "K2Node_SwitchOnFloatRanges.h"
+#include "K2Node_SwitchOnIntArray.h"
+#include "K2Node_SwitchOnIntRanges.h"
+#include "K2Node_SwitchOnNameSet.h"
+#include "K2Node_SwitchOnVector.h"
+#include "Algo/Transform.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include <cmath>
+
+DEFINE_LOG_CATEGORY_STATIC(LogExtraSwitchConformance, Log, All);
+
+namespace ExtraSwitchConformance
+{
+    // Only the first failures of a shape are logged in full, the rest are counted
+    static constexpr int32 MaxLoggedFailures = 10;
+
+    // Every case set compiles a blueprint, the ones of earlier trials are collected this often
+    static constexpr int32 TrialsPerGarbageCollection = 50;
+
+    // A compiled switch that ran no pin or several stands for no case index at all
+    static constexpr int32 NoSinglePin = INDEX_NONE - 1;
+
+    // The functions and events of a case set's blueprint, the match mode functions are named after EExtraSwitchMatchMode
+    static const TCHAR* const CachedEvent = TEXT("Cached");
+    static const TCHAR* const HysteresisEvent = TEXT("Hysteresis");
+    static const TCHAR* const ConstantFunction = TEXT("Constant");
+    static const EExtraSwitchMatchMode AllMatchModes[] = { EExtraSwitchMatchMode::FirstMatch, EExtraSwitchMatchMode::AllMatches, EExtraSwitchMatchMode::BestMatch };
+
+    struct FReport
+    {
+        FString Shape;
+        // Also compiles every case set into a blueprint and checks the pins it runs
+        bool bBlueprints = true;
+        int32 CaseSets = 0;
+        int32 Checks = 0;
+        int32 Failures = 0;
+        int32 BoundaryDifferences = 0;
+
+        void Expect(const FString& Path, const FString& Expected, const FString& Actual, bool bAmbiguous, TFunctionRef<FString()> DescribeInput)
+        {
+            ++Checks;
+            if (Expected == Actual)
+            {
+                return;
+            }
+
+            if (bAmbiguous)
+            {
+                ++BoundaryDifferences;
+                return;
+            }
+
+            if (++Failures <= MaxLoggedFailures)
+            {
+                UE_LOG(LogExtraSwitchConformance, Error, TEXT("%s %s: expected %s but got %s for %s"), *Shape, *Path, *Expected, *Actual, *DescribeInput());
+            }
+        }
+    };
+
+    static FString ToString(int32 CaseIndex)
+    {
+        switch (CaseIndex)
+        {
+        case INDEX_NONE:
+            return TEXT("Default");
+        case NoSinglePin:
+            return TEXT("no single pin");
+        default:
+            return FString::FromInt(CaseIndex);
+        }
+    }
+
+    static FString ToString(TConstArrayView<int32> CaseIndices)
+    {
+        return FString::Printf(TEXT("[%s]"), *FString::JoinBy(CaseIndices, TEXT(","), [](int32 CaseIndex) { return FString::FromInt(CaseIndex); }));
+    }
+
+    static FString GetFunctionName(EExtraSwitchMatchMode MatchMode)
+    {
+        return StaticEnum<EExtraSwitchMatchMode>()->GetNameStringByValue((int64)MatchMode);
+    }
+
+    // The case the pin a compiled switch ran stands for
+    static int32 ToCaseIndex(const TArray<FIntPoint>& FiredPins)
+    {
+        return FiredPins.Num() == 1 ? FiredPins[0].Y : NoSinglePin;
+    }
+
+    // The cases of the pins a compiled AllMatches switch ran, the default pin alone means no case matched
+    static TArray<int32> ToCaseIndices(const TArray<FIntPoint>& FiredPins)
+    {
+        TArray<int32> CaseIndices;
+        if (FiredPins.Num() != 1 || FiredPins[0].Y != INDEX_NONE)
+        {
+            Algo::Transform(FiredPins, CaseIndices, [](const FIntPoint& Pin) { return Pin.Y; });
+        }
+        return CaseIndices;
+    }
+
+    /**
+     * One generated case set with its reference semantics and every implementation to compare against it.
+     * The reference is written from the documented behaviour of the comparators, independently of the case tables.
+     */
+    template<typename ValueType>
+    struct TCaseSet
+    {
+        // Optional, the blueprint the compiled paths run, declared first so it outlives the calls they hold
+        TSharedPtr<FExtraSwitchTestGraph> Blueprint;
+
+        int32 NumCases = 0;
+        FString Description;
+        TArray<ValueType> Inputs;
+
+        // Reference: does the case with this index match the input
+        TFunction<bool(const ValueType&, int32)> Matches;
+        // Reference order of BestMatch, the matching case with the lowest key wins and ties keep the lowest index
+        TFunction<double(const ValueType&, int32)> BestKey;
+        // True when float rounding may legitimately decide the input either way
+        TFunction<bool(const ValueType&)> IsAmbiguous;
+        TFunction<FString(const ValueType&)> DescribeInput;
+
+        // Optional, the reference of a switch that remembers its case between inputs: the case of the input after the previous one, unset for the first input
+        TFunction<int32(const ValueType&, const TOptional<int32>&)> Remembered;
+
+        // First match implementations
+        TArray<TPair<FString, TFunction<int32(const ValueType&)>>> FirstMatchPaths;
+        // Every matching case in pin order, the FindNext loop of a table built for AllMatches or a compiled AllMatches switch
+        TArray<TPair<FString, TFunction<TArray<int32>(const ValueType&)>>> AllMatchesPaths;
+        // The lookup of a table built for BestMatch or a compiled BestMatch switch
+        TArray<TPair<FString, TFunction<int32(const ValueType&)>>> BestMatchPaths;
+        // Cached lookups, only added when no input can match two cases. Each path keeps its own case slot over all inputs
+        TArray<TPair<FString, TFunction<int32(const ValueType&, int32&)>>> CachedPaths;
+        // Lookups that remember their case the way Remembered describes, each with its own case slot
+        TArray<TPair<FString, TFunction<int32(const ValueType&, int32&)>>> RememberedPaths;
+        // Optional, the batch classification of every input
+        TFunction<void(const TArray<ValueType>&, TArray<int32>&)> Classify;
+
+        // The input the compiled Constant function's selection pin holds as its default value, and that value as text
+        ValueType ConstantInput = ValueType();
+        FString ConstantValue;
+        // Optional, runs the compiled Constant function
+        TFunction<int32()> Constant;
+    };
+
+    template<typename ValueType>
+    void Check(FReport& Report, const TCaseSet<ValueType>& Set)
+    {
+        ++Report.CaseSets;
+
+        TArray<int32> ExpectedFirst;
+        TArray<bool> Ambiguous;
+        TArray<int32> CaseSlots;
+        CaseSlots.Init(ExtraSwitch::CaseSlotNotEvaluated, Set.CachedPaths.Num());
+        TArray<int32> RememberedSlots;
+        RememberedSlots.Init(ExtraSwitch::CaseSlotNotEvaluated, Set.RememberedPaths.Num());
+        TOptional<int32> ExpectedRemembered;
+        for (const ValueType& Input : Set.Inputs)
+        {
+            auto Describe = [&Set, &Input]() { return FString::Printf(TEXT("%s with cases %s"), *Set.DescribeInput(Input), *Set.Description); };
+            const bool bAmbiguous = Set.IsAmbiguous && Set.IsAmbiguous(Input);
+
+            TArray<int32> ExpectedAll;
+            for (int32 CaseIndex = 0; CaseIndex < Set.NumCases; ++CaseIndex)
+            {
+                if (Set.Matches(Input, CaseIndex))
+                {
+                    ExpectedAll.Add(CaseIndex);
+                }
+            }
+            const int32 Expected = ExpectedAll.Num() > 0 ? ExpectedAll[0] : INDEX_NONE;
+            ExpectedFirst.Add(Expected);
+            Ambiguous.Add(bAmbiguous);
+
+            for (const TPair<FString, TFunction<int32(const ValueType&)>>& Path : Set.FirstMatchPaths)
+            {
+                Report.Expect(Path.Key, ToString(Expected), ToString(Path.Value(Input)), bAmbiguous, Describe);
+            }
+
+            for (const TPair<FString, TFunction<TArray<int32>(const ValueType&)>>& Path : Set.AllMatchesPaths)
+            {
+                Report.Expect(Path.Key, ToString(ExpectedAll), ToString(Path.Value(Input)), bAmbiguous, Describe);
+            }
+
+            if (Set.BestMatchPaths.Num() > 0)
+            {
+                int32 ExpectedBest = INDEX_NONE;
+                for (const int32 CaseIndex : ExpectedAll)
+                {
+                    if (ExpectedBest == INDEX_NONE || Set.BestKey(Input, CaseIndex) < Set.BestKey(Input, ExpectedBest))
+                    {
+                        ExpectedBest = CaseIndex;
+                    }
+                }
+                for (const TPair<FString, TFunction<int32(const ValueType&)>>& Path : Set.BestMatchPaths)
+                {
+                    Report.Expect(Path.Key, ToString(ExpectedBest), ToString(Path.Value(Input)), bAmbiguous, Describe);
+                }
+            }
+
+            // Twice in a row, so both the miss and the hit of the cache are checked
+            for (int32 PathIndex = 0; PathIndex < Set.CachedPaths.Num(); ++PathIndex)
+            {
+                const TPair<FString, TFunction<int32(const ValueType&, int32&)>>& Path = Set.CachedPaths[PathIndex];
+                Report.Expect(Path.Key, ToString(Expected), ToString(Path.Value(Input, CaseSlots[PathIndex])), bAmbiguous, Describe);
+                Report.Expect(Path.Key + TEXT(" (repeat)"), ToString(Expected), ToString(Path.Value(Input, CaseSlots[PathIndex])), bAmbiguous, Describe);
+            }
+
+            if (Set.Remembered)
+            {
+                ExpectedRemembered = Set.Remembered(Input, ExpectedRemembered);
+                for (int32 PathIndex = 0; PathIndex < Set.RememberedPaths.Num(); ++PathIndex)
+                {
+                    const TPair<FString, TFunction<int32(const ValueType&, int32&)>>& Path = Set.RememberedPaths[PathIndex];
+                    Report.Expect(Path.Key, ToString(ExpectedRemembered.GetValue()), ToString(Path.Value(Input, RememberedSlots[PathIndex])), bAmbiguous, Describe);
+                }
+            }
+        }
+
+        if (Set.Classify)
+        {
+            TArray<int32> Actual;
+            Set.Classify(Set.Inputs, Actual);
+            for (int32 Index = 0; Index < Set.Inputs.Num(); ++Index)
+            {
+                Report.Expect(TEXT("Classify"), ToString(ExpectedFirst[Index]), Actual.IsValidIndex(Index) ? ToString(Actual[Index]) : FString(TEXT("missing")), Ambiguous[Index],
+                    [&Set, Index]() { return FString::Printf(TEXT("%s with cases %s"), *Set.DescribeInput(Set.Inputs[Index]), *Set.Description); });
+            }
+        }
+
+        if (Set.Constant)
+        {
+            int32 Expected = INDEX_NONE;
+            for (int32 CaseIndex = 0; CaseIndex < Set.NumCases && Expected == INDEX_NONE; ++CaseIndex)
+            {
+                Expected = Set.Matches(Set.ConstantInput, CaseIndex) ? CaseIndex : INDEX_NONE;
+            }
+            Report.Expect(TEXT("Constant"), ToString(Expected), ToString(Set.Constant()), Set.IsAmbiguous && Set.IsAmbiguous(Set.ConstantInput),
+                [&Set]() { return FString::Printf(TEXT("%s folded into cases %s"), *Set.ConstantValue, *Set.Description); });
+        }
+    }
+
+    static TStrongObjectPtr<UExtraSwitchCaseTable> NewTable()
+    {
+        return TStrongObjectPtr<UExtraSwitchCaseTable>(NewObject<UExtraSwitchCaseTable>(GetTransientPackage()));
+    }
+
+    // Every case a FindNext lookup returns for an input, the same loop a compiled AllMatches switch runs
+    template<typename ValueType, typename FindNextType>
+    static TFunction<TArray<int32>(const ValueType&)> CollectAllMatches(int32 NumCases, FindNextType FindNext)
+    {
+        return [NumCases, FindNext](const ValueType& Input)
+        {
+            TArray<int32> CaseIndices;
+            for (int32 CaseIndex = FindNext(Input, 0); CaseIndex != INDEX_NONE && CaseIndices.Num() <= NumCases; CaseIndex = FindNext(Input, CaseIndex + 1))
+            {
+                CaseIndices.Add(CaseIndex);
+            }
+            return CaseIndices;
+        };
+    }
+
+    // Where AddSwitchGraph puts a switch node of a case set's blueprint
+    enum class ECompiledEntry : uint8
+    {
+        // A function graph, the switch resolves every call from scratch
+        Function,
+        // A custom event in the event graph, where the switch keeps its case slot between calls
+        Event,
+        // A function graph with the selection pin unlinked and holding the set's ConstantValue, so the compiler folds the switch
+        Constant
+    };
+
+    /**
+     * Adds a switch node configured by Configure to the blueprint of the case set, with every pin recording itself as switch 0.
+     * The switch runs on the Selection parameter of the function or event Name
+     */
+    template<typename NodeType, typename ValueType>
+    static void AddSwitchGraph(TCaseSet<ValueType>& Set, const FString& Name, ECompiledEntry EntryKind, TFunctionRef<void(NodeType&)> Configure)
+    {
+        if (!Set.Blueprint.IsValid())
+        {
+            Set.Blueprint = MakeShared<FExtraSwitchTestGraph>();
+        }
+
+        FExtraSwitchTestGraph& Graph = *Set.Blueprint;
+        const FEdGraphPinType SelectionType = GetDefault<NodeType>()->GetPinType();
+        const FExtraSwitchTestGraph::FEntry Entry = EntryKind == ECompiledEntry::Event ? Graph.AddEvent(*Name, SelectionType) : Graph.AddFunction(*Name, SelectionType);
+        NodeType* SwitchNode = Graph.AddSwitch<NodeType>(Entry.Graph, Configure);
+        Graph.Connect(Entry.Then, SwitchNode->GetExecPin());
+        if (EntryKind == ECompiledEntry::Constant)
+        {
+            Graph.SetDefaultValue(SwitchNode->GetSelectionPin(), Set.ConstantValue);
+        }
+        else
+        {
+            Graph.Connect(Entry.Selection, SwitchNode->GetSelectionPin());
+        }
+        Graph.RecordPins(SwitchNode, 0);
+    }
+
+    // Adds a FirstMatch, AllMatches and BestMatch function with the node in that match mode
+    template<typename NodeType, typename ValueType>
+    static void AddMatchModeGraphs(TCaseSet<ValueType>& Set, TFunctionRef<void(NodeType&)> Configure)
+    {
+        for (const EExtraSwitchMatchMode MatchMode : AllMatchModes)
+        {
+            AddSwitchGraph<NodeType>(Set, GetFunctionName(MatchMode), ECompiledEntry::Function, [&Configure, MatchMode](NodeType& Node)
+            {
+                Configure(Node);
+                Node.MatchMode = MatchMode;
+            });
+        }
+    }
+
+    template<typename ValueType, typename SelectionType = ValueType>
+    static void SetSelection(const FExtraSwitchTestGraph::FCall& Call, const ValueType& Input)
+    {
+        Call.GetSelection<SelectionType>() = SelectionType(Input);
+    }
+
+    // The default value text of a selection pin holding the input, precise enough to parse back to the same value
+    static FString ToDefaultValue(int32 Input)
+    {
+        return FString::FromInt(Input);
+    }
+
+    static FString ToDefaultValue(float Input)
+    {
+        return FString::Printf(TEXT("%.9g"), Input);
+    }
+
+    static FString ToDefaultValue(const FVector& Input)
+    {
+        return FString::Printf(TEXT("%.17g,%.17g,%.17g"), Input.X, Input.Y, Input.Z);
+    }
+
+    static FString ToDefaultValue(const FLinearColor& Input)
+    {
+        return FString::Printf(TEXT("(R=%.9g,G=%.9g,B=%.9g,A=%.9g)"), Input.R, Input.G, Input.B, Input.A);
+    }
+
+    static FString ToDefaultValue(FName Input)
+    {
+        return Input.ToString();
+    }
+
+    // Picks the input the Constant function folds, drawn even without blueprints so -NoBlueprints checks the same case sets
+    template<typename ValueType>
+    static void PickConstantInput(FRandomStream& Random, TCaseSet<ValueType>& Set)
+    {
+        Set.ConstantInput = Set.Inputs[Random.RandRange(0, Set.Inputs.Num() - 1)];
+        Set.ConstantValue = ToDefaultValue(Set.ConstantInput);
+    }
+
+    /**
+     * Compiles the blueprint of the case set and adds a path for each of its functions and events, so the compiled switches
+     * are checked against the reference like the lookups are
+     * @param CopySelection - Copies an input into the Selection parameter of a compiled function or event
+     * @return False if the blueprint didn't compile
+     */
+    template<typename ValueType>
+    static bool AddCompiledPaths(FReport& Report, TCaseSet<ValueType>& Set, TFunction<void(const FExtraSwitchTestGraph::FCall&, const ValueType&)> CopySelection)
+    {
+        FExtraSwitchTestGraph& Graph = *Set.Blueprint;
+        FString Errors;
+        ++Report.Checks;
+        if (!Graph.Compile(Errors))
+        {
+            if (++Report.Failures <= MaxLoggedFailures)
+            {
+                UE_LOG(LogExtraSwitchConformance, Error, TEXT("%s: the blueprint of cases %s didn't compile: %s"), *Report.Shape, *Set.Description, *Errors);
+            }
+            return false;
+        }
+
+        // Each path keeps the parameters of its function, the instance and so the case slots of its event graph stay the same for the whole set
+        UExtraSwitchTestObject* Instance = Graph.GetInstance();
+        auto FindRun = [Instance, CopySelection](const FString& Name) -> TFunction<TArray<FIntPoint>(const ValueType&)>
+        {
+            if (Instance->FindFunction(*Name) == nullptr)
+            {
+                return nullptr;
+            }
+
+            const TSharedRef<FExtraSwitchTestGraph::FCall> Call = MakeShared<FExtraSwitchTestGraph::FCall>(Instance, *Name);
+            return [Instance, CopySelection, Call](const ValueType& Input)
+            {
+                CopySelection(*Call, Input);
+                Call->Call();
+                return Instance->FiredPins;
+            };
+        };
+
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(GetFunctionName(EExtraSwitchMatchMode::FirstMatch)))
+        {
+            Set.FirstMatchPaths.Add({ TEXT("Compiled"), [Run](const ValueType& Input) { return ToCaseIndex(Run(Input)); } });
+        }
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(GetFunctionName(EExtraSwitchMatchMode::AllMatches)))
+        {
+            Set.AllMatchesPaths.Add({ TEXT("Compiled AllMatches"), [Run](const ValueType& Input) { return ToCaseIndices(Run(Input)); } });
+        }
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(GetFunctionName(EExtraSwitchMatchMode::BestMatch)))
+        {
+            Set.BestMatchPaths.Add({ TEXT("Compiled BestMatch"), [Run](const ValueType& Input) { return ToCaseIndex(Run(Input)); } });
+        }
+        // The event graph keeps the case slot, the slot the check passes in is left alone
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(CachedEvent))
+        {
+            Set.CachedPaths.Add({ TEXT("Compiled Cached"), [Run](const ValueType& Input, int32&) { return ToCaseIndex(Run(Input)); } });
+        }
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(HysteresisEvent))
+        {
+            Set.RememberedPaths.Add({ TEXT("Compiled Hysteresis"), [Run](const ValueType& Input, int32&) { return ToCaseIndex(Run(Input)); } });
+        }
+        if (TFunction<TArray<FIntPoint>(const ValueType&)> Run = FindRun(ConstantFunction))
+        {
+            Report.Expect(TEXT("Constant note"), TEXT("folded"), Graph.HasCompilerMessage(TEXT("its selection is known at compile time")) ? TEXT("folded") : TEXT("not folded"),
+                false, [&Set]() { return FString::Printf(TEXT("%s with cases %s"), *Set.ConstantValue, *Set.Description); });
+            // The selection parameter isn't read by the folded switch
+            Set.Constant = [Run, Input = Set.ConstantInput]() { return ToCaseIndex(Run(Input)); };
+        }
+        return true;
+    }
+
+    // Two distances this close may compare either way between the squared float distances of the tables and the distances of the comparators
+    static bool AreNearlyEqual(double First, double Second, float Tolerance)
+    {
+        return First != Second && FMath::Abs(First - Second) <= 1.0e-4 * (1.0 + Tolerance);
+    }
+
+    // Offsets that land exactly on, just inside and just outside a tolerance or a range end, plus a few well inside and outside
+    static TArray<double> GetEdgeScales()
+    {
+        return { 0.0, 0.5, 1.0, 1.0 - 1.0e-3, 1.0 + 1.0e-3, 1.5, 2.0 };
+    }
+
+    template<typename RangeType>
+    static FString DescribeRanges(const TArray<RangeType>& Ranges)
+    {
+        return FString::JoinBy(Ranges, TEXT(" "), [](const RangeType& Range)
+        {
+            return FString::Printf(TEXT("%s%s,%s%s"), Range.Inclusive ? TEXT("[") : TEXT("("), *LexToSanitizedString(Range.RangeMin),
+                *LexToSanitizedString(Range.RangeMax), Range.Inclusive ? TEXT("]") : TEXT(")"));
+        });
+    }
+
+    // Reference of IsIntNotWithinRange and IsFloatNotWithinRange: reversed ranges never contain anything
+    template<typename ValueType, typename RangeType>
+    static bool RangeContains(const RangeType& Range, ValueType Value)
+    {
+        if (Range.RangeMin > Range.RangeMax)
+        {
+            return false;
+        }
+        return Range.Inclusive ? (Range.RangeMin <= Value && Value <= Range.RangeMax) : (Range.RangeMin < Value && Value < Range.RangeMax);
+    }
+
+    template<typename ValueType, typename RangeType>
+    static bool AreRangesDisjoint(const TArray<RangeType>& Ranges, const TArray<ValueType>& Inputs)
+    {
+        for (const ValueType& Input : Inputs)
+        {
+            int32 NumMatches = 0;
+            for (const RangeType& Range : Ranges)
+            {
+                NumMatches += RangeContains(Range, Input) ? 1 : 0;
+            }
+            if (NumMatches > 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void CheckIntArray(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // Small domains produce duplicates, the first pin with a value must win. Scaled domains exercise the binary search
+        const int32 Scale = Random.RandRange(0, 2) == 0 ? Random.RandRange(2, 1000) : 1;
+        TArray<int32> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 16); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(Random.RandRange(-8, 8) * Scale);
+        }
+
+        const TStrongObjectPtr<UExtraSwitchCaseTable> JumpTable = NewTable();
+        JumpTable->BuildIntCases(Values, 0.0f);
+        const TStrongObjectPtr<UExtraSwitchCaseTable> SearchTable = NewTable();
+        SearchTable->BuildIntCases(Values, 2.0f);
+
+        TCaseSet<int32> Set;
+        Set.NumCases = Values.Num();
+        Set.Description = FString::JoinBy(Values, TEXT(" "), [](int32 Value) { return FString::FromInt(Value); });
+        for (const int32 Value : Values)
+        {
+            Set.Inputs.Append({ Value - 1, Value, Value + 1 });
+        }
+        Set.Inputs.Append({ MIN_int32, MAX_int32, 0 });
+
+        Set.Matches = [Values](int32 Input, int32 CaseIndex) { return Values[CaseIndex] == Input; };
+        Set.DescribeInput = [](int32 Input) { return FString::FromInt(Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Values](int32 Input)
+        {
+            return Values.IndexOfByPredicate([Input](int32 Value) { return !UExtraSwitchComparatorsFunctionLibrary::AreIntsNotEqual(Input, Value); });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("JumpTable"), [Table = JumpTable.Get()](int32 Input) { return Library::FindIntArrayCaseIndex(Input, Table); } });
+        Set.FirstMatchPaths.Add({ TEXT("BinarySearch"), [Table = SearchTable.Get()](int32 Input) { return Library::FindIntArrayCaseIndex(Input, Table); } });
+        Set.CachedPaths.Add({ TEXT("Cached"), [Table = JumpTable.Get()](int32 Input, int32& CaseSlot) { return Library::FindIntArrayCaseIndexCached(Input, Table, CaseSlot); } });
+        Set.Classify = [Values](const TArray<int32>& Inputs, TArray<int32>& OutCaseIndices) { Library::ClassifyIntsBySet(Inputs, Values, OutCaseIndices); };
+
+        // The compiled node picks the jump table or the binary search from its own fill setting
+        const float MinJumpTableFill = Random.RandRange(0, 1) == 0 ? 0.0f : 2.0f;
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Values, MinJumpTableFill](UK2Node_SwitchOnIntArray& Node)
+            {
+                Node.PinValues = Values;
+                Node.MinJumpTableFill = MinJumpTableFill;
+            };
+            AddSwitchGraph<UK2Node_SwitchOnIntArray>(Set, GetFunctionName(EExtraSwitchMatchMode::FirstMatch), ECompiledEntry::Function, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnIntArray>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnIntArray>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnIntArray& Node)
+            {
+                Configure(Node);
+                Node.bCacheLastCase = true;
+            });
+            AddCompiledPaths<int32>(Report, Set, &SetSelection<int32>);
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckIntRange(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // Ends on a small grid, so ranges share ends, overlap, touch, and are sometimes reversed or empty
+        TArray<FSwitchIntRange> Ranges;
+        for (int32 CaseIndex = Random.RandRange(1, 8); CaseIndex > 0; --CaseIndex)
+        {
+            FSwitchIntRange& Range = Ranges.AddDefaulted_GetRef();
+            Range.RangeMin = Random.RandRange(-10, 10);
+            Range.RangeMax = Range.RangeMin + Random.RandRange(-2, 8);
+            Range.Inclusive = Random.RandRange(0, 1) == 0;
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildIntRangeCases(Ranges, (EExtraSwitchMatchMode)Mode);
+        }
+
+        TCaseSet<int32> Set;
+        Set.NumCases = Ranges.Num();
+        Set.Description = DescribeRanges(Ranges);
+        for (int32 Input = -14; Input <= 22; ++Input)
+        {
+            Set.Inputs.Add(Input);
+        }
+
+        Set.Matches = [Ranges](int32 Input, int32 CaseIndex) { return RangeContains(Ranges[CaseIndex], Input); };
+        Set.BestKey = [Ranges](int32 Input, int32 CaseIndex) { return (double)Ranges[CaseIndex].RangeMax - Ranges[CaseIndex].RangeMin; };
+        Set.DescribeInput = [](int32 Input) { return FString::FromInt(Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Ranges](int32 Input)
+        {
+            return Ranges.IndexOfByPredicate([Input](const FSwitchIntRange& Range) { return !UExtraSwitchComparatorsFunctionLibrary::IsIntNotWithinRange(Input, Range); });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](int32 Input) { return Library::FindIntRangeCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<int32>(Set.NumCases, [Table = Tables[1].Get()](int32 Input, int32 StartIndex)
+        {
+            return Library::FindNextIntRangeCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](int32 Input) { return Library::FindIntRangeCaseIndex(Input, Table); } });
+        const bool bDisjoint = AreRangesDisjoint(Ranges, Set.Inputs);
+        if (bDisjoint)
+        {
+            Set.CachedPaths.Add({ TEXT("Cached"), [Table = Tables[0].Get()](int32 Input, int32& CaseSlot) { return Library::FindIntRangeCaseIndexCached(Input, Table, CaseSlot); } });
+        }
+        Set.Classify = [Ranges](const TArray<int32>& Inputs, TArray<int32>& OutCaseIndices) { Library::ClassifyIntsByRange(Inputs, Ranges, OutCaseIndices); };
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Ranges](UK2Node_SwitchOnIntRanges& Node) { Node.PinValues = Ranges; };
+            AddMatchModeGraphs<UK2Node_SwitchOnIntRanges>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnIntRanges>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            if (bDisjoint)
+            {
+                AddSwitchGraph<UK2Node_SwitchOnIntRanges>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnIntRanges& Node)
+                {
+                    Configure(Node);
+                    Node.bCacheLastCase = true;
+                });
+            }
+            AddCompiledPaths<int32>(Report, Set, &SetSelection<int32>);
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckFloatRange(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        TArray<FExtraSwitchFloatRange> Ranges;
+        for (int32 CaseIndex = Random.RandRange(1, 8); CaseIndex > 0; --CaseIndex)
+        {
+            FExtraSwitchFloatRange& Range = Ranges.AddDefaulted_GetRef();
+            Range.RangeMin = Random.RandRange(-16, 16) * 0.25f;
+            Range.RangeMax = Range.RangeMin + Random.RandRange(-2, 12) * 0.25f;
+            Range.Inclusive = Random.RandRange(0, 1) == 0;
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildFloatRangeCases(Ranges, (EExtraSwitchMatchMode)Mode);
+        }
+
+        TCaseSet<float> Set;
+        Set.NumCases = Ranges.Num();
+        Set.Description = DescribeRanges(Ranges);
+        // Every end, the next float on either side of it and the grid points in between
+        for (const FExtraSwitchFloatRange& Range : Ranges)
+        {
+            for (const float End : { Range.RangeMin, Range.RangeMax })
+            {
+                Set.Inputs.Append({ std::nextafter(End, -HUGE_VALF), End, std::nextafter(End, HUGE_VALF) });
+            }
+        }
+        for (int32 Step = -40; Step <= 40; ++Step)
+        {
+            Set.Inputs.Add(Step * 0.125f);
+        }
+
+        // The float ranges compare at float precision, so every input is exact
+        Set.Matches = [Ranges](float Input, int32 CaseIndex) { return RangeContains(Ranges[CaseIndex], Input); };
+        Set.BestKey = [Ranges](float Input, int32 CaseIndex) { return (double)Ranges[CaseIndex].RangeMax - Ranges[CaseIndex].RangeMin; };
+        Set.DescribeInput = [](float Input) { return FString::Printf(TEXT("%.9g"), Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Ranges](float Input)
+        {
+            return Ranges.IndexOfByPredicate([Input](const FExtraSwitchFloatRange& Range) { return !UExtraSwitchComparatorsFunctionLibrary::IsFloatNotWithinRange(Input, Range); });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](float Input) { return Library::FindFloatRangeCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<float>(Set.NumCases, [Table = Tables[1].Get()](float Input, int32 StartIndex)
+        {
+            return Library::FindNextFloatRangeCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](float Input) { return Library::FindFloatRangeCaseIndex(Input, Table); } });
+        const bool bDisjoint = AreRangesDisjoint(Ranges, Set.Inputs);
+        if (bDisjoint)
+        {
+            Set.CachedPaths.Add({ TEXT("Cached"), [Table = Tables[0].Get()](float Input, int32& CaseSlot) { return Library::FindFloatRangeCaseIndexCached(Input, Table, CaseSlot); } });
+        }
+        Set.Classify = [Ranges](const TArray<float>& Inputs, TArray<int32>& OutCaseIndices)
+        {
+            Library::ClassifyFloatsByRange(TArray<double>(Inputs), Ranges, OutCaseIndices);
+        };
+
+        // Reference of the hysteresis: the previous range holds while the selection stays within the margin around it. Coming from the default pin
+        // the selection has to get the margin inside a range, unless the range is narrower than twice the margin.
+        // The inputs jump between the range ends and then walk up the grid, so both the kept and the left cases come up
+        const float HysteresisMargin = Random.RandRange(1, 4) * 0.125f;
+        Set.Remembered = [Ranges, HysteresisMargin](float Input, const TOptional<int32>& Previous)
+        {
+            const bool bHasPreviousRange = Previous.IsSet() && Ranges.IsValidIndex(Previous.GetValue());
+            if (bHasPreviousRange)
+            {
+                FExtraSwitchFloatRange Widened = Ranges[Previous.GetValue()];
+                const bool bReversed = Widened.RangeMin > Widened.RangeMax;
+                Widened.RangeMin -= HysteresisMargin;
+                Widened.RangeMax += HysteresisMargin;
+                if (!bReversed && RangeContains(Widened, Input))
+                {
+                    return Previous.GetValue();
+                }
+            }
+
+            const int32 CaseIndex = Ranges.IndexOfByPredicate([Input](const FExtraSwitchFloatRange& Range) { return RangeContains(Range, Input); });
+            if (!Previous.IsSet() || bHasPreviousRange || CaseIndex == INDEX_NONE)
+            {
+                return CaseIndex;
+            }
+
+            FExtraSwitchFloatRange Shrunk = Ranges[CaseIndex];
+            Shrunk.RangeMin += HysteresisMargin;
+            Shrunk.RangeMax -= HysteresisMargin;
+            return (Shrunk.RangeMin > Shrunk.RangeMax || RangeContains(Shrunk, Input)) ? CaseIndex : (int32)INDEX_NONE;
+        };
+        const TStrongObjectPtr<UExtraSwitchCaseTable> HysteresisTable = NewTable();
+        HysteresisTable->BuildFloatRangeCases(Ranges);
+        HysteresisTable->SetFloatRangeHysteresis(HysteresisMargin);
+        Set.RememberedPaths.Add({ TEXT("Hysteresis"), [Table = HysteresisTable.Get()](float Input, int32& CaseSlot)
+        {
+            return Library::FindFloatRangeCaseIndexWithHysteresis(Input, Table, CaseSlot);
+        } });
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Ranges](UK2Node_SwitchOnFloatRanges& Node) { Node.PinValues = Ranges; };
+            AddMatchModeGraphs<UK2Node_SwitchOnFloatRanges>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnFloatRanges>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            if (bDisjoint)
+            {
+                AddSwitchGraph<UK2Node_SwitchOnFloatRanges>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnFloatRanges& Node)
+                {
+                    Configure(Node);
+                    Node.bCacheLastCase = true;
+                });
+            }
+            AddSwitchGraph<UK2Node_SwitchOnFloatRanges>(Set, HysteresisEvent, ECompiledEntry::Event, [&Configure, HysteresisMargin](UK2Node_SwitchOnFloatRanges& Node)
+            {
+                Configure(Node);
+                Node.HysteresisMargin = HysteresisMargin;
+            });
+            AddCompiledPaths<float>(Report, Set, &SetSelection<float, double>);
+        }
+        Check(Report, Set);
+    }
+
+    /**
+     * Shared by the float, vector and color switches
+     * @param Distance - Reference distance between an input and a case value, the case matches when it is within the tolerance
+     * @param Offset - Moves a case value by a scaled tolerance in a random direction
+     */
+    template<typename ValueType, typename DistanceType, typename OffsetType>
+    static TCaseSet<ValueType> MakeToleranceSet(const TArray<ValueType>& Values, float Tolerance, DistanceType&& Distance, OffsetType&& Offset)
+    {
+        TCaseSet<ValueType> Set;
+        Set.NumCases = Values.Num();
+        for (const ValueType& Value : Values)
+        {
+            for (const double Scale : GetEdgeScales())
+            {
+                Set.Inputs.Add(Offset(Value, Tolerance * Scale));
+            }
+        }
+
+        Set.Matches = [Values, Tolerance, Distance](const ValueType& Input, int32 CaseIndex) { return !((float)Distance(Input, Values[CaseIndex]) > Tolerance); };
+        Set.BestKey = [Values, Distance](const ValueType& Input, int32 CaseIndex) { return Distance(Input, Values[CaseIndex]); };
+
+        // Near a tolerance, or two matching cases at nearly but not exactly the same distance for BestMatch
+        Set.IsAmbiguous = [Values, Tolerance, Distance](const ValueType& Input)
+        {
+            TArray<double> Matching;
+            for (const ValueType& Value : Values)
+            {
+                const double CaseDistance = Distance(Input, Value);
+                if (AreNearlyEqual(CaseDistance, Tolerance, Tolerance))
+                {
+                    return true;
+                }
+                if (CaseDistance <= Tolerance)
+                {
+                    for (const double Other : Matching)
+                    {
+                        if (AreNearlyEqual(Other, CaseDistance, Tolerance))
+                        {
+                            return true;
+                        }
+                    }
+                    Matching.Add(CaseDistance);
+                }
+            }
+            return false;
+        };
+        return Set;
+    }
+
+    static void CheckFloat(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        const float Tolerance = Random.RandRange(0, 4) * 0.25f;
+        TArray<float> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 9); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(Random.RandRange(-8, 8) * 0.5f);
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildFloatCases(Values, Tolerance, (EExtraSwitchMatchMode)Mode);
+        }
+
+        TCaseSet<float> Set = MakeToleranceSet(Values, Tolerance,
+            [](float A, float B) { return (double)FMath::Abs(A - B); },
+            [&Random](float Value, double Offset) { return Value + (float)(Random.RandRange(0, 1) == 0 ? Offset : -Offset); });
+        Set.Description = FString::Printf(TEXT("%s within %s"), *FString::JoinBy(Values, TEXT(" "), [](float Value) { return LexToSanitizedString(Value); }), *LexToSanitizedString(Tolerance));
+        Set.DescribeInput = [](float Input) { return FString::Printf(TEXT("%.9g"), Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Values, Tolerance](float Input)
+        {
+            return Values.IndexOfByPredicate([Input, Tolerance](float Value)
+            {
+                FFloatAndTolerance Case;
+                Case.Value = Value;
+                Case.Tolerance = Tolerance;
+                return !UExtraSwitchComparatorsFunctionLibrary::IsFloatWithToleranceNotNearlyEqual(Input, Case);
+            });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](float Input) { return Library::FindFloatCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<float>(Set.NumCases, [Table = Tables[1].Get()](float Input, int32 StartIndex)
+        {
+            return Library::FindNextFloatCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](float Input) { return Library::FindFloatCaseIndex(Input, Table); } });
+        const bool bDisjoint = ExtraSwitch::AreToleranceCasesDisjoint<float>(Values, Tolerance);
+        if (bDisjoint)
+        {
+            Set.CachedPaths.Add({ TEXT("Cached"), [Table = Tables[0].Get()](float Input, int32& CaseSlot) { return Library::FindFloatCaseIndexCached(Input, Table, CaseSlot); } });
+        }
+        Set.Classify = [Values, Tolerance](const TArray<float>& Inputs, TArray<int32>& OutCaseIndices)
+        {
+            Library::ClassifyFloatsByTolerance(TArray<double>(Inputs), TArray<double>(Values), Tolerance, OutCaseIndices);
+        };
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Values, Tolerance](UK2Node_SwitchOnFloat& Node)
+            {
+                Node.PinValues = Values;
+                Node.Tolerance = Tolerance;
+            };
+            AddMatchModeGraphs<UK2Node_SwitchOnFloat>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnFloat>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            if (bDisjoint)
+            {
+                AddSwitchGraph<UK2Node_SwitchOnFloat>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnFloat& Node)
+                {
+                    Configure(Node);
+                    Node.bCacheLastCase = true;
+                });
+            }
+            AddCompiledPaths<float>(Report, Set, &SetSelection<float, double>);
+        }
+        Check(Report, Set);
+    }
+
+    // A Switch on Float Range with one of its pins running into a Switch on Float on the same selection, fused into one table like the compiler does
+    static void CheckFused(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        TArray<FExtraSwitchFloatRange> Ranges;
+        for (int32 CaseIndex = Random.RandRange(1, 6); CaseIndex > 0; --CaseIndex)
+        {
+            FExtraSwitchFloatRange& Range = Ranges.AddDefaulted_GetRef();
+            Range.RangeMin = Random.RandRange(-16, 16) * 0.25f;
+            Range.RangeMax = Range.RangeMin + Random.RandRange(-2, 12) * 0.25f;
+            Range.Inclusive = Random.RandRange(0, 1) == 0;
+        }
+
+        const float Tolerance = Random.RandRange(0, 4) * 0.25f;
+        TArray<float> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 6); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(Random.RandRange(-8, 8) * 0.5f);
+        }
+
+        // The range case whose pin runs into the float switch, INDEX_NONE for the default pin
+        const int32 ChainedCase = Random.RandRange(INDEX_NONE, Ranges.Num() - 1);
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Table = NewTable();
+        UExtraSwitchCaseTable* RangeLevel = NewObject<UExtraSwitchCaseTable>(Table.Get());
+        RangeLevel->BuildFloatRangeCases(Ranges);
+        UExtraSwitchCaseTable* FloatLevel = NewObject<UExtraSwitchCaseTable>(Table.Get());
+        FloatLevel->BuildFloatCases(Values, Tolerance);
+        Table->AddFusedLevel(RangeLevel, EExtraSwitchFusedLookup::FloatRange, Ranges.Num());
+        const int32 FloatLevelIndex = Table->AddFusedLevel(FloatLevel, EExtraSwitchFusedLookup::Float, Values.Num());
+        Table->SetFusedNextLevel(0, ChainedCase, FloatLevelIndex);
+
+        // Reference: the range switch runs first and the float switch only after the chained pin, the outcomes of level 0 are its case indices
+        auto FindOutcome = [Ranges, Values, Tolerance, ChainedCase, FloatLevelIndex, Table = Table.Get()](float Input)
+        {
+            const int32 RangeCase = Ranges.IndexOfByPredicate([Input](const FExtraSwitchFloatRange& Range) { return RangeContains(Range, Input); });
+            if (RangeCase != ChainedCase)
+            {
+                return RangeCase;
+            }
+            const int32 FloatCase = Values.IndexOfByPredicate([Input, Tolerance](float Value) { return !(FMath::Abs(Input - Value) > Tolerance); });
+            return Table->GetFusedOutcome(FloatLevelIndex, FloatCase);
+        };
+
+        TCaseSet<float> Set;
+        Set.NumCases = Table->FusedNextLevels.Num() - 1;
+        Set.Description = FString::Printf(TEXT("%s then pin %s into %s within %s"), *DescribeRanges(Ranges), *ToString(ChainedCase),
+            *FString::JoinBy(Values, TEXT(" "), [](float Value) { return LexToSanitizedString(Value); }), *LexToSanitizedString(Tolerance));
+        for (const FExtraSwitchFloatRange& Range : Ranges)
+        {
+            for (const float End : { Range.RangeMin, Range.RangeMax })
+            {
+                Set.Inputs.Append({ std::nextafter(End, -HUGE_VALF), End, std::nextafter(End, HUGE_VALF) });
+            }
+        }
+        for (const float Value : Values)
+        {
+            for (const double Scale : GetEdgeScales())
+            {
+                Set.Inputs.Append({ Value + (float)(Tolerance * Scale), Value - (float)(Tolerance * Scale) });
+            }
+        }
+
+        Set.Matches = [FindOutcome](float Input, int32 Outcome) { return FindOutcome(Input) == Outcome; };
+        Set.IsAmbiguous = [Values, Tolerance](float Input)
+        {
+            return Values.ContainsByPredicate([Input, Tolerance](float Value) { return AreNearlyEqual(FMath::Abs(Input - Value), Tolerance, Tolerance); });
+        };
+        Set.DescribeInput = [](float Input) { return FString::Printf(TEXT("%.9g"), Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Fused"), [Table = Table.Get()](float Input) { return Library::FindFusedFloatCaseIndex(Input, Table); } });
+
+        // The same chain drawn as two nodes in a function, the compiler must fuse them into one lookup of its own table
+        if (Report.bBlueprints)
+        {
+            Set.Blueprint = MakeShared<FExtraSwitchTestGraph>();
+            FExtraSwitchTestGraph& Graph = *Set.Blueprint;
+            const FExtraSwitchTestGraph::FEntry Entry = Graph.AddFunction(TEXT("Fused"), GetDefault<UK2Node_SwitchOnFloatRanges>()->GetPinType());
+            UK2Node_SwitchOnFloatRanges* RangeNode = Graph.AddSwitch<UK2Node_SwitchOnFloatRanges>(Entry.Graph, [&Ranges](UK2Node_SwitchOnFloatRanges& Node) { Node.PinValues = Ranges; });
+            UK2Node_SwitchOnFloat* FloatNode = Graph.AddSwitch<UK2Node_SwitchOnFloat>(Entry.Graph, [&Values, Tolerance](UK2Node_SwitchOnFloat& Node)
+            {
+                Node.PinValues = Values;
+                Node.Tolerance = Tolerance;
+            });
+            Graph.Connect(Entry.Then, RangeNode->GetExecPin());
+            Graph.Connect(Entry.Selection, RangeNode->GetSelectionPin());
+            Graph.Connect(Entry.Selection, FloatNode->GetSelectionPin());
+            Graph.Connect(FExtraSwitchTestGraph::FindCasePin(RangeNode, ChainedCase), FloatNode->GetExecPin());
+            Graph.RecordPins(RangeNode, 0);
+            Graph.RecordPins(FloatNode, 1);
+
+            FString Errors;
+            ++Report.Checks;
+            if (Graph.Compile(Errors))
+            {
+                Report.Expect(TEXT("Fused note"), TEXT("fused"), Graph.HasCompilerMessage(TEXT("is resolved by the lookup of")) ? TEXT("fused") : TEXT("not fused"), false,
+                    [&Set]() { return FString::Printf(TEXT("cases %s"), *Set.Description); });
+
+                // A pin of the float switch stands for the outcome of its level, like the reference
+                const TSharedRef<FExtraSwitchTestGraph::FCall> Call = MakeShared<FExtraSwitchTestGraph::FCall>(Graph.GetInstance(), TEXT("Fused"));
+                Set.FirstMatchPaths.Add({ TEXT("Compiled"), [Call, Instance = Graph.GetInstance(), FloatLevelIndex, Table = Table.Get()](float Input)
+                {
+                    Call->GetSelection<double>() = Input;
+                    Call->Call();
+                    const int32 CaseIndex = ToCaseIndex(Instance->FiredPins);
+                    return CaseIndex != NoSinglePin && Instance->FiredPins[0].X == 1 ? Table->GetFusedOutcome(FloatLevelIndex, CaseIndex) : CaseIndex;
+                } });
+            }
+            else if (++Report.Failures <= MaxLoggedFailures)
+            {
+                UE_LOG(LogExtraSwitchConformance, Error, TEXT("%s: the blueprint of cases %s didn't compile: %s"), *Report.Shape, *Set.Description, *Errors);
+            }
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckVector(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // Half the sets sit up to 10 km from the world origin, where a float coordinate is only good to about a millimetre
+        const EExtraSwitchVectorPrecision Precision = (EExtraSwitchVectorPrecision)Random.RandRange(0, (int32)EExtraSwitchVectorPrecision::RebasedFloat);
+        const FVector Base = Random.RandRange(0, 1) == 0 ? FVector::ZeroVector
+            : FVector(Random.RandRange(-1000000, 1000000), Random.RandRange(-1000000, 1000000), Random.RandRange(-10000, 10000));
+        const float Tolerance = Random.RandRange(0, 3) * 5.0f;
+        TArray<FVector> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 9); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(Base + FVector(Random.RandRange(-3, 3), Random.RandRange(-3, 3), Random.RandRange(-1, 1)) * 10.0);
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildVectorCases(Values, Tolerance, (EExtraSwitchMatchMode)Mode, {}, Precision);
+        }
+
+        TCaseSet<FVector> Set = MakeToleranceSet(Values, Tolerance,
+            [](const FVector& A, const FVector& B) { return FVector::Dist(A, B); },
+            [&Random](const FVector& Value, double Offset) { return Value + FVector(Random.GetUnitVector()) * Offset; });
+        Set.Description = FString::Printf(TEXT("%s within %s in %s"), *FString::JoinBy(Values, TEXT(" "), [](const FVector& Value) { return Value.ToCompactString(); }),
+            *LexToSanitizedString(Tolerance), *StaticEnum<EExtraSwitchVectorPrecision>()->GetNameStringByValue((int64)Precision));
+        Set.DescribeInput = [](const FVector& Input) { return Input.ToString(); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Values, Tolerance](const FVector& Input)
+        {
+            return Values.IndexOfByPredicate([&Input, Tolerance](const FVector& Value)
+            {
+                FVectorAndTolerance Case;
+                Case.X = Value.X;
+                Case.Y = Value.Y;
+                Case.Z = Value.Z;
+                Case.Tolerance = Tolerance;
+                return !UExtraSwitchComparatorsFunctionLibrary::IsVectorWithToleranceNotNearlyEqual(Input, Case);
+            });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](const FVector& Input) { return Library::FindVectorCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<FVector>(Set.NumCases, [Table = Tables[1].Get()](const FVector& Input, int32 StartIndex)
+        {
+            return Library::FindNextVectorCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](const FVector& Input) { return Library::FindVectorCaseIndex(Input, Table); } });
+        const bool bDisjoint = ExtraSwitch::AreToleranceCasesDisjoint<FVector>(Values, Tolerance);
+        if (bDisjoint)
+        {
+            Set.CachedPaths.Add({ TEXT("Cached"), [Table = Tables[0].Get()](const FVector& Input, int32& CaseSlot) { return Library::FindVectorCaseIndexCached(Input, Table, CaseSlot); } });
+        }
+        Set.Classify = [Values, Tolerance](const TArray<FVector>& Inputs, TArray<int32>& OutCaseIndices) { Library::ClassifyVectors(Inputs, Values, Tolerance, OutCaseIndices); };
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Values, Tolerance, Precision](UK2Node_SwitchOnVector& Node)
+            {
+                Node.PinValues = Values;
+                Node.Tolerance = Tolerance;
+                Node.Precision = Precision;
+            };
+            AddMatchModeGraphs<UK2Node_SwitchOnVector>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnVector>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            if (bDisjoint)
+            {
+                AddSwitchGraph<UK2Node_SwitchOnVector>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnVector& Node)
+                {
+                    Configure(Node);
+                    Node.bCacheLastCase = true;
+                });
+            }
+            AddCompiledPaths<FVector>(Report, Set, &SetSelection<FVector>);
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckColor(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // HSV treats both sides as HSV like IsColorWithToleranceNotNearlyEqualNoAlpha, the other spaces take linear colors
+        const EExtraSwitchColorSpace ColorSpace = (EExtraSwitchColorSpace)Random.RandRange(0, (int32)EExtraSwitchColorSpace::CIELAB);
+        const bool bFromHSV = ColorSpace == EExtraSwitchColorSpace::HSV;
+        const float Tolerance = Random.RandRange(0, 3) * 0.05f;
+        TArray<FLinearColor> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 9); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(bFromHSV
+                ? FLinearColor(Random.RandRange(0, 11) * 30.0f, Random.RandRange(0, 4) * 0.25f, Random.RandRange(1, 4) * 0.25f, 1.0f)
+                : FLinearColor(Random.RandRange(0, 4) * 0.25f, Random.RandRange(0, 4) * 0.25f, Random.RandRange(0, 4) * 0.25f, Random.RandRange(2, 4) * 0.25f));
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildColorCases(Values, Tolerance, ColorSpace, (EExtraSwitchMatchMode)Mode);
+        }
+
+        // The HSV inputs are offset in linear RGB and converted back, so the edges land on the tolerance after the node's conversion.
+        // Oklab and CIELAB inputs are offset in linear RGB too, they only land near the edges but every path still has to agree on them
+        auto ToCompared = [ColorSpace](const FLinearColor& Color) { return Library::ConvertToColorComparisonSpace(Color, ColorSpace); };
+        TCaseSet<FLinearColor> Set = MakeToleranceSet(Values, Tolerance,
+            [ToCompared](const FLinearColor& A, const FLinearColor& B) { return (double)FLinearColor::Dist(ToCompared(A), ToCompared(B)); },
+            [&Random, bFromHSV](const FLinearColor& Value, double Offset)
+            {
+                const FVector Direction = Random.GetUnitVector() * Offset;
+                if (!bFromHSV)
+                {
+                    return Value + FLinearColor((float)Direction.X, (float)Direction.Y, (float)Direction.Z, 0.0f);
+                }
+                return (Value.HSVToLinearRGB() + FLinearColor((float)Direction.X, (float)Direction.Y, (float)Direction.Z, 0.0f)).LinearRGBToHSV();
+            });
+        Set.Description = FString::Printf(TEXT("%s within %s in %s"), *FString::JoinBy(Values, TEXT(" "), [](const FLinearColor& Value) { return Value.ToString(); }),
+            *LexToSanitizedString(Tolerance), *StaticEnum<EExtraSwitchColorSpace>()->GetNameStringByValue((int64)ColorSpace));
+        Set.DescribeInput = [](const FLinearColor& Input) { return Input.ToString(); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Values, Tolerance, ColorSpace, ToCompared](const FLinearColor& Input)
+        {
+            return Values.IndexOfByPredicate([&Input, Tolerance, ColorSpace, ToCompared](const FLinearColor& Value)
+            {
+                FColorAndTolerance Case;
+                Case.Color = Value;
+                Case.Tolerance = Tolerance;
+                switch (ColorSpace)
+                {
+                case EExtraSwitchColorSpace::LinearRGBA:
+                    return !UExtraSwitchComparatorsFunctionLibrary::IsColorWithToleranceNotNearlyEqual(Input, Case);
+                case EExtraSwitchColorSpace::HSV:
+                    return !UExtraSwitchComparatorsFunctionLibrary::IsColorWithToleranceNotNearlyEqualNoAlpha(Input, Case);
+                default:
+                    // No stock comparator for the other spaces, convert both sides per case like one would have
+                    return ExtraSwitch::IsWithinTolerance(ToCompared(Input), ToCompared(Value), Tolerance);
+                }
+            });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](const FLinearColor& Input) { return Library::FindColorCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<FLinearColor>(Set.NumCases, [Table = Tables[1].Get()](const FLinearColor& Input, int32 StartIndex)
+        {
+            return Library::FindNextColorCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](const FLinearColor& Input) { return Library::FindColorCaseIndex(Input, Table); } });
+        TArray<FLinearColor> ComparedValues;
+        Algo::Transform(Values, ComparedValues, ToCompared);
+        const bool bDisjoint = ExtraSwitch::AreToleranceCasesDisjoint<FLinearColor>(ComparedValues, Tolerance);
+        if (bDisjoint)
+        {
+            Set.CachedPaths.Add({ TEXT("Cached"), [Table = Tables[0].Get()](const FLinearColor& Input, int32& CaseSlot)
+            {
+                return Library::FindColorCaseIndexCached(Input, Table, CaseSlot);
+            } });
+        }
+        Set.Classify = [Values, Tolerance, ColorSpace](const TArray<FLinearColor>& Inputs, TArray<int32>& OutCaseIndices)
+        {
+            Library::ClassifyColorsInSpace(Inputs, Values, Tolerance, ColorSpace, OutCaseIndices);
+        };
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            // UseAlpha follows the space the way the details panel sets it
+            auto Configure = [&Values, Tolerance, ColorSpace](UK2Node_SwitchOnColor& Node)
+            {
+                Node.PinValues = Values;
+                Node.Distance = Tolerance;
+                Node.ComparisonSpace = ColorSpace;
+                Node.UseAlpha = ColorSpace == EExtraSwitchColorSpace::LinearRGBA;
+                Node.SetupUseAlpha();
+            };
+            AddMatchModeGraphs<UK2Node_SwitchOnColor>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnColor>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            if (bDisjoint)
+            {
+                AddSwitchGraph<UK2Node_SwitchOnColor>(Set, CachedEvent, ECompiledEntry::Event, [&Configure](UK2Node_SwitchOnColor& Node)
+                {
+                    Configure(Node);
+                    Node.bCacheLastCase = true;
+                });
+            }
+            AddCompiledPaths<FLinearColor>(Report, Set, &SetSelection<FLinearColor>);
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckBitmask(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // Masks over four flags so Any, All and Exact cases collide often, including empty masks
+        TArray<FExtraSwitchBitmaskCase> Cases;
+        for (int32 CaseIndex = Random.RandRange(1, 8); CaseIndex > 0; --CaseIndex)
+        {
+            FExtraSwitchBitmaskCase& Case = Cases.AddDefaulted_GetRef();
+            Case.Mask = Random.RandRange(0, 15);
+            Case.Test = (EExtraSwitchBitmaskTest)Random.RandRange(0, 2);
+        }
+
+        TStrongObjectPtr<UExtraSwitchCaseTable> Tables[3];
+        for (int32 Mode = 0; Mode < 3; ++Mode)
+        {
+            Tables[Mode] = NewTable();
+            Tables[Mode]->BuildBitmaskCases(Cases, (EExtraSwitchMatchMode)Mode);
+        }
+
+        auto Matches = [](const FExtraSwitchBitmaskCase& Case, int32 Value)
+        {
+            switch (Case.Test)
+            {
+            case EExtraSwitchBitmaskTest::Any:
+                return (Value & Case.Mask) != 0;
+            case EExtraSwitchBitmaskTest::All:
+                return (Value & Case.Mask) == Case.Mask;
+            default:
+                return Value == Case.Mask;
+            }
+        };
+
+        TCaseSet<int32> Set;
+        Set.NumCases = Cases.Num();
+        Set.Description = FString::JoinBy(Cases, TEXT(" "), [](const FExtraSwitchBitmaskCase& Case)
+        {
+            return FString::Printf(TEXT("%s 0x%X"), *StaticEnum<EExtraSwitchBitmaskTest>()->GetNameStringByValue((int64)Case.Test), Case.Mask);
+        });
+        for (int32 Input = 0; Input < 16; ++Input)
+        {
+            Set.Inputs.Append({ Input, Input | 0x100 });
+        }
+        Set.Inputs.Add(-1);
+
+        Set.Matches = [Cases, Matches](int32 Input, int32 CaseIndex) { return Matches(Cases[CaseIndex], Input); };
+        // The most flags tested wins and Exact beats every flag test
+        Set.BestKey = [Cases](int32 Input, int32 CaseIndex)
+        {
+            return Cases[CaseIndex].Test == EExtraSwitchBitmaskTest::Exact ? -33.0 : -(double)FMath::CountBits((uint32)Cases[CaseIndex].Mask);
+        };
+        Set.DescribeInput = [](int32 Input) { return FString::Printf(TEXT("0x%X"), Input); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Cases](int32 Input)
+        {
+            return Cases.IndexOfByPredicate([Input](const FExtraSwitchBitmaskCase& Case) { return !UExtraSwitchComparatorsFunctionLibrary::IsBitmaskNotMatching(Input, Case); });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Tables[0].Get()](int32 Input) { return Library::FindBitmaskCaseIndex(Input, Table); } });
+        Set.AllMatchesPaths.Add({ TEXT("AllMatches"), CollectAllMatches<int32>(Set.NumCases, [Table = Tables[1].Get()](int32 Input, int32 StartIndex)
+        {
+            return Library::FindNextBitmaskCaseIndex(Input, Table, StartIndex);
+        }) });
+        Set.BestMatchPaths.Add({ TEXT("BestMatch"), [Table = Tables[2].Get()](int32 Input) { return Library::FindBitmaskCaseIndex(Input, Table); } });
+        Set.Classify = [Cases](const TArray<int32>& Inputs, TArray<int32>& OutCaseIndices) { Library::ClassifyBitmasks(Inputs, Cases, OutCaseIndices); };
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Cases](UK2Node_SwitchOnBitmask& Node) { Node.PinValues = Cases; };
+            AddMatchModeGraphs<UK2Node_SwitchOnBitmask>(Set, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnBitmask>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            AddCompiledPaths<int32>(Report, Set, &SetSelection<int32>);
+        }
+        Check(Report, Set);
+    }
+
+    static void CheckName(FRandomStream& Random, FReport& Report)
+    {
+        using Library = UExtraSwitchComparatorsFunctionLibrary;
+
+        // FName compares ignoring case, so differently cased names are duplicates
+        const TArray<FName> Pool = { TEXT("Idle"), TEXT("idle"), TEXT("Walk"), TEXT("Run"), TEXT("Run_1"), NAME_None };
+        TArray<FName> Values;
+        for (int32 CaseIndex = Random.RandRange(1, 6); CaseIndex > 0; --CaseIndex)
+        {
+            Values.Add(Pool[Random.RandRange(0, Pool.Num() - 1)]);
+        }
+
+        const TStrongObjectPtr<UExtraSwitchCaseTable> Table = NewTable();
+        Table->BuildNameCases(Values);
+
+        TCaseSet<FName> Set;
+        Set.NumCases = Values.Num();
+        Set.Description = FString::JoinBy(Values, TEXT(" "), [](FName Value) { return Value.ToString(); });
+        Set.Inputs = Pool;
+        Set.Inputs.Add(TEXT("Jump"));
+
+        Set.Matches = [Values](FName Input, int32 CaseIndex) { return Values[CaseIndex] == Input; };
+        Set.DescribeInput = [](FName Input) { return Input.ToString(); };
+        Set.FirstMatchPaths.Add({ TEXT("Comparator"), [Values](FName Input)
+        {
+            return Values.IndexOfByPredicate([Input](FName Value) { return !UExtraSwitchComparatorsFunctionLibrary::AreNamesNotEqual(Input, Value); });
+        } });
+        Set.FirstMatchPaths.Add({ TEXT("Lookup"), [Table = Table.Get()](FName Input) { return Library::FindNameCaseIndex(Input, Table); } });
+
+        PickConstantInput(Random, Set);
+        if (Report.bBlueprints)
+        {
+            auto Configure = [&Values](UK2Node_SwitchOnNameSet& Node) { Node.PinValues = Values; };
+            AddSwitchGraph<UK2Node_SwitchOnNameSet>(Set, GetFunctionName(EExtraSwitchMatchMode::FirstMatch), ECompiledEntry::Function, Configure);
+            AddSwitchGraph<UK2Node_SwitchOnNameSet>(Set, ConstantFunction, ECompiledEntry::Constant, Configure);
+            AddCompiledPaths<FName>(Report, Set, &SetSelection<FName>);
+        }
+        Check(Report, Set);
+    }
+}
+
+UExtraSwitchConformanceCommandlet::UExtraSwitchConformanceCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UExtraSwitchConformanceCommandlet::Main(const FString& Params)
+{
+    using namespace ExtraSwitchConformance;
+
+    int32 Trials = 200;
+    FParse::Value(*Params, TEXT("Trials="), Trials);
+    int32 Seed = 0x5317;
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    const bool bBlueprints = !FParse::Param(*Params, TEXT("NoBlueprints"));
+
+    TArray<FString> Shapes;
+    FString ShapeList;
+    if (FParse::Value(*Params, TEXT("Shapes="), ShapeList, false))
+    {
+        ShapeList.ParseIntoArray(Shapes, TEXT(","));
+    }
+
+    using FCheckFunction = void (*)(FRandomStream&, FReport&);
+    const TPair<const TCHAR*, FCheckFunction> AllShapes[] =
+    {
+        { TEXT("IntArray"), &CheckIntArray },
+        { TEXT("IntRange"), &CheckIntRange },
+        { TEXT("FloatRange"), &CheckFloatRange },
+        { TEXT("Float"), &CheckFloat },
+        { TEXT("Vector"), &CheckVector },
+        { TEXT("Color"), &CheckColor },
+        { TEXT("Bitmask"), &CheckBitmask },
+        { TEXT("Name"), &CheckName },
+        { TEXT("Fused"), &CheckFused },
+    };
+
+    int32 TotalFailures = 0;
+    for (const TPair<const TCHAR*, FCheckFunction>& Shape : AllShapes)
+    {
+        if (Shapes.Num() > 0 && !Shapes.Contains(Shape.Key))
+        {
+            continue;
+        }
+
+        // Every shape has its own stream, so a failure reproduces with -Shapes and the same seed
+        FRandomStream Random(Seed ^ (int32)GetTypeHash(FString(Shape.Key)));
+        FReport Report;
+        Report.Shape = Shape.Key;
+        Report.bBlueprints = bBlueprints;
+        for (int32 Trial = 0; Trial < Trials; ++Trial)
+        {
+            Shape.Value(Random, Report);
+            if (bBlueprints && (Trial + 1) % TrialsPerGarbageCollection == 0)
+            {
+                CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            }
+        }
+
+        UE_LOG(LogExtraSwitchConformance, Display, TEXT("%-10s %4d case sets %7d checks %4d failures %4d boundary differences"),
+            *Report.Shape, Report.CaseSets, Report.Checks, Report.Failures, Report.BoundaryDifferences);
+        TotalFailures += Report.Failures;
+    }
+
+    if (TotalFailures > 0)
+    {
+        UE_LOG(LogExtraSwitchConformance, Error, TEXT("%d lookups disagree with the reference, rerun with -Seed=%d to reproduce"), TotalFailures, Seed);
+        return 1;
+    }
+    return 0;
+}
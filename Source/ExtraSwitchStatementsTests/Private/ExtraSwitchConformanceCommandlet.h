@@ -0,0 +1,31 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExtraSwitchConformanceCommandlet.generated.h"
+
+/**
+ * Differential check of the switch nodes against a plain reference evaluator of the switch semantics.
+ * Generates random case sets biased towards the edges that matter (inclusive and exclusive range ends, reversed and empty ranges,
+ * duplicate values, selections exactly on a tolerance). Every case set is compiled into a transient blueprint holding the node in each
+ * match mode, folded on a constant selection, remembering its case in the event graph and fused with a second switch, and the pins the
+ * bytecode runs are compared with the reference for every selection. The comparator chain, the case tables in every match mode,
+ * the cached lookups and the batch Classify functions are checked the same way below the compiled nodes.
+ *
+ * UnrealEditor-Cmd <Project> -run=ExtraSwitchConformance -nullrhi [-Trials=200] [-Seed=N] [-Shapes=IntRange,Vector] [-NoBlueprints]
+ *
+ * Returns 1 when any lookup disagrees with the reference. Selections within float rounding of a tolerance, where the squared distance
+ * of the tables and the distance of the comparators can round either way, are only reported as boundary differences.
+ */
+UCLASS()
+class UExtraSwitchConformanceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExtraSwitchConformanceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
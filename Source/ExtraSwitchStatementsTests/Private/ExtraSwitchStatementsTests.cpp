@@ -0,0 +1,6 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "Modules/ModuleManager.h"
+
+// The module only holds automation tests, they register themselves when it loads
+IMPLEMENT_MODULE(FDefaultModuleImpl, ExtraSwitchStatementsTests)
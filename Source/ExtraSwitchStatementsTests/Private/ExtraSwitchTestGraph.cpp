@@ -0,0 +1,195 @@
+// Copyright Amir Ben-Kiki 2025
+
+#include "ExtraSwitchTestGraph.h"
+#include "K2Node_Switch.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_FunctionEntry.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Package.h"
+
+namespace ExtraSwitchTestGraph
+{
+    // A real pin without a subcategory can't become a function parameter, the selection pins of the float nodes are created that way
+    static void ResolveRealType(FEdGraphPinType& PinType)
+    {
+        if (PinType.PinCategory == UEdGraphSchema_K2::PC_Real && PinType.PinSubCategory.IsNone())
+        {
+            PinType.PinSubCategory = UEdGraphSchema_K2::PC_Double;
+        }
+    }
+}
+
+FExtraSwitchTestGraph::FCall::FCall(UExtraSwitchTestObject* InInstance, FName Name)
+    : Instance(InInstance)
+    , Function(InInstance->FindFunctionChecked(Name))
+    , SelectionProperty(Function->FindPropertyByName(TEXT("Selection")))
+{
+    check(SelectionProperty);
+    Params = (uint8*)FMemory::Malloc(FMath::Max<int32>(Function->ParmsSize, 1), Function->GetMinAlignment());
+    Function->InitializeStruct(Params);
+}
+
+FExtraSwitchTestGraph::FCall::~FCall()
+{
+    Function->DestroyStruct(Params);
+    FMemory::Free(Params);
+}
+
+void FExtraSwitchTestGraph::FCall::Call() const
+{
+    Instance->FiredPins.Reset();
+    Instance->ProcessEvent(Function, Params);
+}
+
+FExtraSwitchTestGraph::FExtraSwitchTestGraph()
+{
+    UPackage* Package = GetTransientPackage();
+    const FName Name = MakeUniqueObjectName(Package, UBlueprint::StaticClass(), TEXT("ExtraSwitchTestGraph"));
+    Blueprint.Reset(FKismetEditorUtilities::CreateBlueprint(UExtraSwitchTestObject::StaticClass(), Package, Name, BPTYPE_Normal,
+        UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass()));
+}
+
+FExtraSwitchTestGraph::FEntry FExtraSwitchTestGraph::AddFunction(FName Name, FEdGraphPinType SelectionType)
+{
+    ExtraSwitchTestGraph::ResolveRealType(SelectionType);
+
+    UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint.Get(), Name, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+    FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint.Get(), Graph, true, nullptr);
+
+    TArray<UK2Node_FunctionEntry*> EntryNodes;
+    Graph->GetNodesOfClass(EntryNodes);
+    check(EntryNodes.Num() == 1);
+
+    FEntry Entry;
+    Entry.Graph = Graph;
+    Entry.Then = EntryNodes[0]->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+    Entry.Selection = EntryNodes[0]->CreateUserDefinedPin(TEXT("Selection"), SelectionType, EGPD_Output, false);
+    return Entry;
+}
+
+FExtraSwitchTestGraph::FEntry FExtraSwitchTestGraph::AddEvent(FName Name, FEdGraphPinType SelectionType)
+{
+    ExtraSwitchTestGraph::ResolveRealType(SelectionType);
+
+    UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint.Get());
+    check(Graph);
+
+    FGraphNodeCreator<UK2Node_CustomEvent> EventCreator(*Graph);
+    UK2Node_CustomEvent* EventNode = EventCreator.CreateNode(false);
+    EventNode->CustomFunctionName = Name;
+    EventCreator.Finalize();
+
+    FEntry Entry;
+    Entry.Graph = Graph;
+    Entry.Then = EventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+    Entry.Selection = EventNode->CreateUserDefinedPin(TEXT("Selection"), SelectionType, EGPD_Output, false);
+    return Entry;
+}
+
+UK2Node_Switch* FExtraSwitchTestGraph::AddSwitch(UEdGraph* Graph, TSubclassOf<UK2Node_Switch> NodeClass, TFunctionRef<void(UK2Node_Switch&)> Configure)
+{
+    // The same steps as FGraphNodeCreator, with the cases set before AllocateDefaultPins creates a pin for each of them
+    UK2Node_Switch* SwitchNode = NewObject<UK2Node_Switch>(Graph, NodeClass);
+    Configure(*SwitchNode);
+    Graph->AddNode(SwitchNode, false, false);
+    SwitchNode->CreateNewGuid();
+    SwitchNode->PostPlacedNewNode();
+    SwitchNode->AllocateDefaultPins();
+    return SwitchNode;
+}
+
+bool FExtraSwitchTestGraph::Connect(UEdGraphPin* Output, UEdGraphPin* Input) const
+{
+    return Output && Input && GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(Output, Input);
+}
+
+void FExtraSwitchTestGraph::SetDefaultValue(UEdGraphPin* Pin, const FString& Value) const
+{
+    GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*Pin, Value, false);
+}
+
+void FExtraSwitchTestGraph::RecordPins(UK2Node_Switch* SwitchNode, int32 SwitchId) const
+{
+    UFunction* RecordFunction = UExtraSwitchTestObject::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UExtraSwitchTestObject, RecordPin));
+    const UEdGraphPin* DefaultPin = SwitchNode->GetDefaultPin();
+    UEdGraph* Graph = SwitchNode->GetGraph();
+
+    // Linking doesn't add or remove pins, so the array can be walked while the record nodes are added
+    for (UEdGraphPin* Pin : SwitchNode->Pins)
+    {
+        if (Pin->Direction != EGPD_Output || Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec || Pin->LinkedTo.Num() > 0)
+        {
+            continue;
+        }
+
+        FGraphNodeCreator<UK2Node_CallFunction> RecordCreator(*Graph);
+        UK2Node_CallFunction* RecordNode = RecordCreator.CreateNode(false);
+        RecordNode->SetFromFunction(RecordFunction);
+        RecordCreator.Finalize();
+
+        SetDefaultValue(RecordNode->FindPinChecked(TEXT("SwitchId")), FString::FromInt(SwitchId));
+        SetDefaultValue(RecordNode->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(Pin == DefaultPin ? INDEX_NONE : Pin->SourceIndex));
+        Connect(Pin, RecordNode->GetExecPin());
+    }
+}
+
+UEdGraphPin* FExtraSwitchTestGraph::FindCasePin(const UK2Node_Switch* SwitchNode, int32 CaseIndex)
+{
+    UEdGraphPin* DefaultPin = SwitchNode->GetDefaultPin();
+    if (CaseIndex == INDEX_NONE)
+    {
+        return DefaultPin;
+    }
+
+    for (UEdGraphPin* Pin : SwitchNode->Pins)
+    {
+        if (Pin != DefaultPin && Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec && Pin->SourceIndex == CaseIndex)
+        {
+            return Pin;
+        }
+    }
+    return nullptr;
+}
+
+bool FExtraSwitchTestGraph::Compile(FString& OutErrors)
+{
+    FCompilerResultsLog Results;
+    Results.bSilentMode = true;
+    FKismetEditorUtilities::CompileBlueprint(Blueprint.Get(), EBlueprintCompileOptions::SkipGarbageCollection, &Results);
+
+    CompilerMessages.Reset();
+    OutErrors.Reset();
+    for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+    {
+        CompilerMessages.Add(Message->ToText().ToString());
+        if (Message->GetSeverity() == EMessageSeverity::Error)
+        {
+            OutErrors += CompilerMessages.Last() + LINE_TERMINATOR;
+        }
+    }
+
+    if (Results.NumErrors > 0 || Blueprint->Status == BS_Error || Blueprint->GeneratedClass == nullptr)
+    {
+        Instance.Reset();
+        return false;
+    }
+
+    ResetInstance();
+    return true;
+}
+
+bool FExtraSwitchTestGraph::HasCompilerMessage(const FString& Text) const
+{
+    return CompilerMessages.ContainsByPredicate([&Text](const FString& Message) { return Message.Contains(Text); });
+}
+
+void FExtraSwitchTestGraph::ResetInstance()
+{
+    Instance.Reset(NewObject<UExtraSwitchTestObject>(GetTransientPackage(), Blueprint->GeneratedClass));
+}
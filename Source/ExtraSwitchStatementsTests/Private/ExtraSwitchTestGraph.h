@@ -0,0 +1,135 @@
+// Copyright Amir Ben-Kiki 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/UnrealType.h"
+#include "UObject/StrongObjectPtr.h"
+#include "EdGraph/EdGraphPin.h"
+#include "ExtraSwitchTestGraph.generated.h"
+
+class UBlueprint;
+class UEdGraph;
+class UK2Node_Switch;
+
+/**
+ * Parent class of the blueprints FExtraSwitchTestGraph builds, every case and default pin under test runs a RecordPin call
+ */
+UCLASS(Blueprintable, Transient, HideDropdown)
+class UExtraSwitchTestObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// The pins that ran since the last call, X is the id the switch was recorded with and Y the case index or INDEX_NONE for the default pin
+	TArray<FIntPoint> FiredPins;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	void RecordPin(int32 SwitchId, int32 CaseIndex) { FiredPins.Emplace(SwitchId, CaseIndex); }
+};
+
+/**
+ * Builds a transient blueprint out of switch nodes, compiles it and runs it, so the benchmarks and the conformance checks see
+ * the pins the compiled bytecode takes rather than what the lookup functions return.
+ * Every function or event takes a single Selection parameter and the graphs are only wired up by the caller.
+ */
+class FExtraSwitchTestGraph
+{
+public:
+	// Where an added function or event starts
+	struct FEntry
+	{
+		UEdGraph* Graph = nullptr;
+		UEdGraphPin* Then = nullptr;
+		UEdGraphPin* Selection = nullptr;
+	};
+
+	/**
+	 * The parameters of a compiled function or event, kept so repeated calls only copy the selection in
+	 */
+	class FCall
+	{
+	public:
+		FCall(UExtraSwitchTestObject* InInstance, FName Name);
+		~FCall();
+
+		FCall(const FCall&) = delete;
+		FCall& operator=(const FCall&) = delete;
+
+		// The Selection parameter, T must be its native type, double for float selections
+		template<typename T>
+		T& GetSelection() const
+		{
+			check(SelectionProperty->GetSize() == sizeof(T));
+			return *SelectionProperty->ContainerPtrToValuePtr<T>(Params);
+		}
+
+		// Clears the fired pins of the instance and runs the function
+		void Call() const;
+
+	private:
+		UExtraSwitchTestObject* Instance;
+		UFunction* Function;
+		const FProperty* SelectionProperty;
+		uint8* Params;
+	};
+
+	FExtraSwitchTestGraph();
+
+	// Adds a function graph, selections of a real pin type are passed as double
+	FEntry AddFunction(FName Name, FEdGraphPinType SelectionType);
+
+	// Adds a custom event to the event graph, where switch nodes keep their state per object between calls
+	FEntry AddEvent(FName Name, FEdGraphPinType SelectionType);
+
+	// Adds a switch node to Graph, Configure sets its cases and options before the pins are created from them
+	UK2Node_Switch* AddSwitch(UEdGraph* Graph, TSubclassOf<UK2Node_Switch> NodeClass, TFunctionRef<void(UK2Node_Switch&)> Configure);
+
+	template<typename NodeType>
+	NodeType* AddSwitch(UEdGraph* Graph, TFunctionRef<void(NodeType&)> Configure)
+	{
+		return CastChecked<NodeType>(AddSwitch(Graph, NodeType::StaticClass(), [&Configure](UK2Node_Switch& Node) { Configure(*CastChecked<NodeType>(&Node)); }));
+	}
+
+	// Links an output pin to an input pin, false if the schema refuses the link
+	bool Connect(UEdGraphPin* Output, UEdGraphPin* Input) const;
+
+	// Sets the default text of an unlinked input pin
+	void SetDefaultValue(UEdGraphPin* Pin, const FString& Value) const;
+
+	// Wires every unlinked case and default pin of the switch to a RecordPin call with SwitchId
+	void RecordPins(UK2Node_Switch* SwitchNode, int32 SwitchId) const;
+
+	// The exec pin of a case, or the default pin for INDEX_NONE
+	static UEdGraphPin* FindCasePin(const UK2Node_Switch* SwitchNode, int32 CaseIndex);
+
+	/**
+	 * Compiles the blueprint and creates a fresh instance of it
+	 * @return False with the compiler errors in OutErrors if the blueprint didn't compile
+	 */
+	bool Compile(FString& OutErrors);
+
+	// True if a message of the last compile contains Text, like the notes of folded and fused switches
+	bool HasCompilerMessage(const FString& Text) const;
+
+	// Replaces the instance, the event graph state of the switches starts over
+	void ResetInstance();
+
+	UExtraSwitchTestObject* GetInstance() const { return Instance.Get(); }
+
+	// Runs the function or event once and returns the pins it fired in order
+	template<typename T>
+	TArray<FIntPoint> Run(FName Name, const T& Selection)
+	{
+		const FCall Call(Instance.Get(), Name);
+		Call.GetSelection<T>() = Selection;
+		Call.Call();
+		return Instance->FiredPins;
+	}
+
+private:
+	TStrongObjectPtr<UBlueprint> Blueprint;
+	TStrongObjectPtr<UExtraSwitchTestObject> Instance;
+	TArray<FString> CompilerMessages;
+};